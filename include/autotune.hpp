@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief Machine-dependent solver parameters, measured by temporis --autotune
+ *
+ * Saved as "key value" lines. A profile only applies on the machine it was
+ * tuned on: the CPU model and hardware thread count are stored with it and
+ * checked on load, and the default path includes the host name, so hosts
+ * sharing a home directory keep separate profiles.
+ */
+struct TuningProfile {
+    static constexpr int kVersion = 1;
+
+    int threads = 0;                        // workers for --decompose and --simulate; 0 = all hardware threads
+    size_t component_batch_vertices = 0;    // 0 = ComponentSolver::kDefaultBatchVertices
+    size_t layer_dense_ratio = 0;           // 0 = LayerSet::kDefaultDenseRatio
+    size_t decompose_min_components = 0;    // decompose games with at least this many components; 0 = never
+
+    // Fingerprint of the tuning machine
+    std::string host;
+    std::string cpu;
+    unsigned hardware_threads = 0;
+    std::string tuned_at;
+
+    /**
+     * @brief $TEMPORIS_PROFILE, else <config dir>/temporis/<host>.profile; empty without a home directory
+     */
+    static std::string default_path();
+
+    /**
+     * @brief Profile with the fingerprint of this machine and default parameters
+     */
+    static TuningProfile for_this_host();
+
+    /**
+     * @brief Read a profile; nullopt with error set if it is missing or malformed
+     */
+    static std::optional<TuningProfile> load(const std::string& path, std::string& error);
+
+    /**
+     * @brief Write the profile, creating its directory
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Whether the profile was tuned on a machine like this one; reason says why not
+     */
+    bool matches_this_host(std::string& reason) const;
+
+    // One-line summary for verbose output
+    std::string summary() const;
+};
+
+/**
+ * @brief Calibration of TuningProfile on generated games
+ *
+ * Each parameter is searched on its own, in dependency order, over a small
+ * candidate set: the layer dense ratio on one large game, the thread count
+ * and batch size on decomposable games, and finally the component count from
+ * which decomposing beats the whole-game sweep. A candidate only replaces the
+ * default when it is faster by more than kMinGain, so noise does not move
+ * the profile away from the built-in values.
+ */
+class Autotuner {
+private:
+    int max_threads_;
+    int repeats_;
+
+    // Relative speed-up a candidate needs over the default
+    static constexpr double kMinGain = 0.03;
+
+    template<typename Solve>
+    double median_seconds(Solve&& solve) const;
+
+public:
+    /**
+     * @param max_threads Largest thread count tried; 0 uses the hardware concurrency
+     * @param repeats Timed runs per candidate; the median counts
+     */
+    explicit Autotuner(int max_threads = 0, int repeats = 3);
+
+    /**
+     * @brief Run the calibration suite, logging every measurement to out
+     */
+    TuningProfile tune(std::ostream& out);
+};
+
+} // namespace solvers
+} // namespace ggg
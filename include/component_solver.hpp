@@ -0,0 +1,124 @@
+#pragma once
+
+#include "ggg_temporal_graph.hpp"
+#include "libggg/solvers/solver.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief An independent part of a game: one large component or a batch of small ones
+ *
+ * Vertices are renumbered in the sub-game; parent_vertices maps them back.
+ * Constraints (formulas, lazily loaded text, compiled code) are shared with the parent game, not copied.
+ */
+struct SubGame {
+    std::shared_ptr<graphs::GGGTemporalGameManager> manager;
+    std::shared_ptr<graphs::GGGReachabilityObjective> objective;
+    std::vector<graphs::GGGTemporalVertex> parent_vertices;
+    size_t components = 0;
+    size_t edges = 0;
+};
+
+/**
+ * @brief Timing of one work item of the decomposition
+ */
+struct ComponentTiming {
+    size_t components = 0;
+    size_t vertices = 0;
+    size_t edges = 0;
+    std::string engine;
+    int worker = 0;
+    std::chrono::duration<double> solve_time{0};
+};
+
+/**
+ * @brief Statistics of a decomposed solve
+ */
+struct ComponentStatistics {
+    size_t components = 0;
+    size_t batched_components = 0;   // small components solved in shared batches
+    size_t threads = 0;
+    std::chrono::duration<double> decomposition_time{0};
+    std::chrono::duration<double> solve_time{0};   // wall time of the worker pool
+    std::chrono::duration<double> merge_time{0};
+    std::vector<ComponentTiming> work_items;       // largest first
+};
+
+/**
+ * @brief Solves the weakly connected components of a game independently
+ *
+ * A vertex's winner only depends on what it can reach, so components that
+ * share no edge are separate games. Components are found with union-find,
+ * components smaller than the batch size are packed together into one work
+ * item, and the work items (largest first) are extracted as sub-games and
+ * solved by a pool of worker threads. The per-item solutions are merged into
+ * one solution over the original vertices.
+ */
+class ComponentSolver {
+public:
+    using GraphType = graphs::GGGTemporalGraph;
+    using SolutionType = solutions::RSSolution<GraphType>;
+    using Vertex = graphs::GGGTemporalVertex;
+
+    /**
+     * @brief Solves one sub-game and names the engine it used; called concurrently
+     */
+    using ComponentEngine = std::function<SolutionType(const SubGame&, std::string& engine)>;
+
+    // Components below this many vertices are batched together
+    static constexpr size_t kDefaultBatchVertices = 256;
+
+private:
+    std::shared_ptr<graphs::GGGTemporalGameManager> manager_;
+    std::shared_ptr<graphs::GGGReachabilityObjective> objective_;
+    int threads_;
+    size_t batch_vertices_;
+    ComponentStatistics stats_;
+
+public:
+    /**
+     * @param threads Worker threads; 0 uses the hardware concurrency
+     */
+    ComponentSolver(std::shared_ptr<graphs::GGGTemporalGameManager> manager,
+                    std::shared_ptr<graphs::GGGReachabilityObjective> objective,
+                    int threads = 0, size_t batch_vertices = kDefaultBatchVertices);
+
+    /**
+     * @brief Weakly connected components, each listed in vertex order
+     */
+    static std::vector<std::vector<Vertex>> weakly_connected_components(const GraphType& graph);
+
+    /**
+     * @brief Copy vertices, which must be closed under out-edges, into a sub-game
+     */
+    static SubGame extract(const graphs::GGGTemporalGameManager& manager,
+                           const graphs::GGGReachabilityObjective& objective,
+                           const std::vector<Vertex>& vertices, size_t components = 1);
+
+    /**
+     * @brief Decompose, solve every work item with engine and merge the results
+     */
+    SolutionType solve(const ComponentEngine& engine);
+
+    const ComponentStatistics& get_statistics() const { return stats_; }
+
+    /**
+     * @brief Name of a decomposed solve whose work items were given to the named solver
+     */
+    static std::string get_name(const std::string& engine_solver);
+
+    /**
+     * @brief Print the decomposition and the slowest work items for verbose output
+     */
+    void write_report(std::ostream& out, size_t max_items = 10) const;
+};
+
+} // namespace solvers
+} // namespace ggg
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ggg_temporal_graph.hpp"
+#include "presburger_formula.hpp"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace codegen {
+
+/**
+ * @brief Outcome and cost of compiling a game's constraints to native code
+ */
+struct CodegenReport {
+    bool compiled = false;             // the manager now evaluates constraints natively
+    bool cache_hit = false;            // the shared object was already in the cache
+    std::string fallback_reason;       // why the interpreter is still used, if it is
+    size_t edges = 0;
+    size_t constrained_edges = 0;
+    size_t distinct_constraints = 0;
+    size_t source_bytes = 0;
+    std::string object_path;
+    std::chrono::duration<double> generate_time{0};
+    std::chrono::duration<double> compile_time{0};   // zero on a cache hit
+    std::chrono::duration<double> load_time{0};
+    // Measured cost of one evaluation, sampled over the game's own constraints
+    double interpreted_ns = 0;
+    double compiled_ns = 0;
+
+    std::chrono::duration<double> total_time() const { return generate_time + compile_time + load_time; }
+
+    /**
+     * @brief Constraint evaluations among edge_checks availability checks of arbitrary edges
+     */
+    double estimated_evaluations(uint64_t edge_checks) const;
+
+    /**
+     * @brief Evaluation time saved over that many constraint evaluations, in seconds
+     */
+    double saved_seconds(double evaluations) const;
+
+    /**
+     * @brief Evaluations after which the saving pays for generation, compilation and loading
+     */
+    double break_even_evaluations() const;
+};
+
+/**
+ * @brief Ahead-of-time compilation of constraint formulas
+ *
+ * Every distinct constraint of a game becomes a straight-line C++ function of
+ * time with the interpreter's exact semantics (unknown variables are 0,
+ * existentials range over -10..10, % truncates, integers wrap). The source is
+ * compiled with the system compiler into a shared object named by a hash of
+ * the source and compiler command, so later runs on the same constraints load
+ * it from the cache without compiling. The object is dlopen()ed and each edge
+ * gets a pointer to its function; the manager then skips the interpreter.
+ *
+ * The cache directory is created with mode 0700 and is only used if it is
+ * owned by the current user and not writable by group or others.
+ *
+ * Any failure (no compiler, unwritable or unsafe cache, compile error, dlopen
+ * error) leaves the manager on the interpreter and is reported, never fatal.
+ */
+class ConstraintCompiler {
+private:
+    std::string compiler_;
+    std::string flags_ = "-O2 -shared -fPIC";
+    std::string cache_dir_;
+    CodegenReport report_;
+
+public:
+    /**
+     * @param cache_dir Empty uses $TEMPORIS_CODEGEN_CACHE, $XDG_CACHE_HOME/temporis, ~/.cache/temporis
+     *        or, without $HOME, temporis-codegen-<uid> in the temporary directory
+     */
+    explicit ConstraintCompiler(std::string cache_dir = "");
+
+    /**
+     * @brief Compiler used: $TEMPORIS_CODEGEN_CXX, $CXX, or the compiler temporis was built with
+     */
+    const std::string& compiler() const { return compiler_; }
+    const std::string& cache_dir() const { return cache_dir_; }
+
+    /**
+     * @brief C++ expression for formula over the int variable time
+     */
+    static std::string expression(const graphs::PresburgerFormula& formula);
+
+    /**
+     * @brief Translation unit defining temporis_constraints[i] for each expression
+     */
+    static std::string translation_unit(const std::vector<std::string>& expressions);
+
+    /**
+     * @brief Compile the constraints of manager and install them on its edges
+     * @return true if the manager now runs compiled constraints
+     */
+    bool compile(graphs::GGGTemporalGameManager& manager);
+
+    const CodegenReport& get_report() const { return report_; }
+
+    /**
+     * @brief Print compile cost against the evaluation saving for verbose output
+     * @param evaluations Constraint evaluations of the solve (see estimated_evaluations)
+     */
+    void write_report(std::ostream& out, double evaluations) const;
+};
+
+} // namespace codegen
+} // namespace ggg
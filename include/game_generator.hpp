@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace graphs {
+
+/**
+ * @brief Parameters for synthetic temporal game generation
+ */
+struct GameGeneratorOptions {
+    enum class DegreeDistribution {
+        FIXED,      // Every vertex gets edges / vertices out-edges
+        UNIFORM,    // Out-degree uniform in [min_degree, 2 * mean - min_degree]
+        POWER_LAW   // Heavy-tailed out-degree with the given exponent, scaled to the mean
+    };
+
+    uint64_t vertices = 100;
+    uint64_t edges = 400;
+    DegreeDistribution degree_distribution = DegreeDistribution::FIXED;
+    double power_law_exponent = 2.5;
+    uint64_t min_degree = 1;
+    double player1_ratio = 0.5;
+    double target_density = 0.1;
+    int time_bound = 50;
+
+    // Relative weights of the constraint families
+    double threshold_weight = 1.0;    // time >= a, time <= a, time != a
+    double interval_weight = 1.0;     // time >= a && time <= b
+    double modulus_weight = 1.0;      // time % m == r
+    double existential_weight = 1.0;  // exists k: time == m*k
+    double unconstrained_weight = 0.0; // plain edge, always available
+
+    // 1 = single atom, 2 = conjunctions, >= 3 = disjunctions of conjunctions
+    int nesting_depth = 1;
+    uint64_t seed = 42;
+
+    /**
+     * @brief Set family weights from a mix name: a single family or "mixed"
+     * @return false if the name is unknown
+     */
+    bool set_constraint_mix(const std::string& mix);
+
+    static bool parse_degree_distribution(const std::string& name, DegreeDistribution& out);
+};
+
+/**
+ * @brief Node of a generated constraint, rendered to the DOT constraint syntax
+ */
+struct GeneratedConstraint {
+    enum class Kind { ALWAYS, GREATEREQUAL, LESSEQUAL, NOTEQUAL, INTERVAL, MODULUS, MULTIPLE, AND, OR };
+
+    Kind kind = Kind::ALWAYS;
+    int a = 0;  // threshold, interval lower bound, modulus or multiple step
+    int b = 0;  // interval upper bound or modulus remainder
+    std::vector<GeneratedConstraint> children;
+
+    std::string to_string() const;
+
+    /**
+     * @brief Evaluate the constraint directly on its syntax tree
+     *
+     * Independent of the Presburger parser, so it serves as an oracle in
+     * differential tests. Matches the solver's semantics, including the
+     * existential witness range [-10, 10] of PresburgerFormula.
+     */
+    bool evaluate(int time) const;
+};
+
+/**
+ * @brief Reproducible generator of temporal reachability games
+ *
+ * Games are written in the DOT format read by GGGTemporalGameManager. Output is
+ * streamed vertex by vertex, so memory use is independent of the game size and
+ * multi-gigabyte instances can be written directly to disk. The same options and
+ * seed always produce byte-identical output.
+ */
+class GameGenerator {
+private:
+    GameGeneratorOptions options_;
+    std::mt19937_64 rng_;
+    std::discrete_distribution<int> family_dist_;
+
+    uint64_t sample_degree(uint64_t vertex);
+    GeneratedConstraint generate_atom();
+    GeneratedConstraint generate_conjunction();
+
+public:
+    explicit GameGenerator(const GameGeneratorOptions& options);
+
+    const GameGeneratorOptions& options() const { return options_; }
+
+    /**
+     * @brief Stream the whole game to an output stream
+     * @return Number of edges written
+     */
+    uint64_t write_dot(std::ostream& out);
+
+    /**
+     * @brief Generate the whole game as an in-memory DOT string
+     */
+    std::string generate_dot();
+
+    /**
+     * @brief Generate one constraint using the configured families and nesting depth
+     */
+    GeneratedConstraint generate_constraint();
+};
+
+} // namespace graphs
+} // namespace ggg
@@ -1,9 +1,18 @@
 #pragma once
 #include "libggg/graphs/graph_utilities.hpp"
 #include "presburger_formula.hpp"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <istream>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <ostream>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace ggg {
 namespace graphs {
@@ -31,6 +40,36 @@ using GGGTemporalGraph = Graph;
 using GGGTemporalVertex = Graph::vertex_descriptor;
 using GGGTemporalEdge = Graph::edge_descriptor;
 
+// Native code for one constraint, produced by codegen::ConstraintCompiler
+using CompiledConstraint = bool (*)(int time);
+
+/**
+ * @brief Statistics collected while loading a game from DOT input
+ */
+struct LoadStatistics {
+    size_t bytes_read = 0;
+    size_t lines = 0;
+    size_t constraints_parsed = 0;
+    size_t constraints_deferred = 0;   // kept as text by a lazy load
+    std::chrono::duration<double> load_time{0};
+    std::chrono::duration<double> constraint_parse_time{0};
+};
+
+/**
+ * @brief State of the constraints deferred by a lazy load
+ */
+struct LazyConstraintStatistics {
+    size_t deferred = 0;
+    size_t materialized = 0;    // parsed on first use
+    size_t arena_bytes = 0;     // raw constraint text
+    std::chrono::duration<double> parse_time{0};
+
+    size_t never_materialized() const { return deferred - materialized; }
+
+    // Verbose output section
+    void write_report(std::ostream& out) const;
+};
+
 /**
  * @brief Enhanced manager for GGG-style temporal games using GGG infrastructure
  * 
@@ -40,17 +79,62 @@ using GGGTemporalEdge = Graph::edge_descriptor;
 class GGGTemporalGameManager {
 private:
     std::shared_ptr<GGGTemporalGraph> graph_;
-    std::map<GGGTemporalEdge, std::unique_ptr<PresburgerFormula>> edge_constraints_;
+    
+    struct LazyConstraintStore;
+    
+    // Raw text of one deferred constraint, parsed at most once by whichever thread needs it first
+    struct LazyConstraint {
+        LazyConstraintStore* store;
+        size_t offset;
+        size_t length;
+        std::once_flag parsed;
+        std::shared_ptr<const PresburgerFormula> formula;
+        std::exception_ptr error;   // parse failure, rethrown by every later use
+        
+        LazyConstraint(LazyConstraintStore* owner, size_t text_offset, size_t text_length)
+            : store(owner), offset(text_offset), length(text_length) {}
+    };
+    
+    // Arena of the constraint text of one lazy load; the deque keeps records in place
+    struct LazyConstraintStore {
+        std::string arena;
+        std::deque<LazyConstraint> constraints;
+        std::atomic<size_t> materialized{0};
+        std::atomic<int64_t> parse_ns{0};
+    };
+    
+    // Formulas are shared so that sub-games extracted from this game can reuse them
+    struct EdgeConstraint {
+        std::shared_ptr<const PresburgerFormula> formula;
+        LazyConstraint* lazy = nullptr;   // set instead of formula by a lazy load
+        CompiledConstraint compiled = nullptr;
+    };
+    std::map<GGGTemporalEdge, EdgeConstraint> edge_constraints_;
+    // A target with a constraint only counts at the times where the constraint holds
+    std::map<GGGTemporalVertex, std::shared_ptr<const PresburgerFormula>> target_constraints_;
+    bool lazy_constraints_ = false;
+    std::shared_ptr<LazyConstraintStore> lazy_store_;
+    // Lazy stores and compiled modules that the constraints of this game point into
+    std::vector<std::shared_ptr<const void>> retained_;
     int current_time_;
+    LoadStatistics load_stats_;
     
-    // Constraint parsing methods (adapted from PresburgerTemporalDotParser)
-    std::unique_ptr<PresburgerFormula> parse_constraint(const std::string& constraint_str);
-    std::unique_ptr<PresburgerFormula> parse_existential_formula(const std::string& formula_str);
-    std::unique_ptr<PresburgerFormula> parse_comparison_formula(const std::string& formula_str, const std::string& op, size_t pos);
-    std::unique_ptr<PresburgerFormula> parse_logical_formula(const std::string& formula_str, const std::string& op, size_t pos);
-    std::unique_ptr<PresburgerFormula> parse_modulus_constraint(const std::string& formula_str, size_t mod_pos);
-    std::unique_ptr<PresburgerFormula> parse_percent_modulus_constraint(const std::string& formula_str, size_t percent_pos);
-    std::unique_ptr<PresburgerTerm> parse_presburger_term(const std::string& term_str);
+    // Throws std::invalid_argument, like an eager load, if the constraint text does not parse
+    const std::shared_ptr<const PresburgerFormula>& materialize(const EdgeConstraint& constraint) const;
+    // parse_constraint() with the constraint text in the error message
+    std::unique_ptr<PresburgerFormula> parse_edge_constraint(const std::string& constraint_str) const;
+    void retain(std::shared_ptr<const void> owner);
+    
+    bool load_from_stream(std::istream& input);
+    
+    // Constraint parsing helpers (adapted from PresburgerTemporalDotParser)
+    struct ConstraintText;   // whitespace-free constraint with operator lookup tables
+    std::unique_ptr<PresburgerFormula> parse_constraint_range(const ConstraintText& text, size_t begin, size_t end) const;
+    std::unique_ptr<PresburgerFormula> parse_atomic_formula(const std::string& formula_str) const;
+    std::unique_ptr<PresburgerFormula> parse_comparison_formula(const std::string& formula_str, const std::string& op, size_t pos) const;
+    std::unique_ptr<PresburgerFormula> parse_modulus_constraint(const std::string& formula_str, size_t mod_pos) const;
+    std::unique_ptr<PresburgerFormula> parse_percent_modulus_constraint(const std::string& formula_str, size_t percent_pos) const;
+    std::unique_ptr<PresburgerTerm> parse_presburger_term(const std::string& term_str) const;
 
 public:
     GGGTemporalGameManager();
@@ -66,8 +150,34 @@ public:
                                               const std::string& label = "");
     
     // Temporal constraint management
-    void add_edge_constraint(GGGTemporalEdge edge, std::unique_ptr<PresburgerFormula> constraint);
+    std::unique_ptr<PresburgerFormula> parse_constraint(const std::string& constraint_str) const;
+    void add_edge_constraint(GGGTemporalEdge edge, std::shared_ptr<const PresburgerFormula> constraint);
     bool is_edge_constraint_satisfied(GGGTemporalEdge edge, int time) const;
+    bool has_edge_constraint(GGGTemporalEdge edge) const { return edge_constraints_.count(edge) > 0; }
+    std::shared_ptr<const PresburgerFormula> edge_constraint(GGGTemporalEdge edge) const;
+    
+    // Target constraints, parsed at load also in lazy mode (one per target at most)
+    void add_target_constraint(GGGTemporalVertex vertex, std::shared_ptr<const PresburgerFormula> constraint);
+    bool has_target_constraint(GGGTemporalVertex vertex) const { return target_constraints_.count(vertex) > 0; }
+    std::shared_ptr<const PresburgerFormula> target_constraint(GGGTemporalVertex vertex) const;
+    bool is_target_constraint_satisfied(GGGTemporalVertex vertex, int time) const;
+    size_t target_constraint_count() const { return target_constraints_.size(); }
+    
+    // The targets whose constraint holds at time; solvers use this for the final layer
+    std::set<GGGTemporalVertex> targets_at(const std::set<GGGTemporalVertex>& targets, int time) const;
+    
+    // Share edge from_edge of another game's constraint (formula, lazy text or compiled code)
+    void copy_edge_constraint(GGGTemporalEdge edge, const GGGTemporalGameManager& from, GGGTemporalEdge from_edge);
+    
+    // Compiled constraints replace the interpreter for their edge; module must outlive their use
+    void set_compiled_constraint(GGGTemporalEdge edge, CompiledConstraint compiled);
+    CompiledConstraint compiled_constraint(GGGTemporalEdge edge) const;
+    void retain_compiled_module(std::shared_ptr<const void> module) { retain(std::move(module)); }
+    
+    // Lazy loading: later loads keep constraint text and parse each constraint on first use
+    void set_lazy_constraints(bool lazy) { lazy_constraints_ = lazy; }
+    bool lazy_constraints() const { return lazy_constraints_; }
+    LazyConstraintStatistics lazy_constraint_statistics() const;
     
     // Time management
     void advance_time(int new_time);
@@ -84,6 +194,13 @@ public:
     bool load_from_dot_file(const std::string& filename);
     bool load_from_dot_string(const std::string& dot_content);
     bool validate_game_structure() const;
+    
+    // Estimated memory of the graph and of the constraint formulas, in bytes
+    size_t graph_memory_bytes() const;
+    size_t constraint_memory_bytes() const;
+    
+    // Statistics of the most recent load
+    const LoadStatistics& load_statistics() const { return load_stats_; }
 };
 
 /**
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "ggg_temporal_graph.hpp"
+#include "layer_set.hpp"
+#include "layer_series.hpp"
+#include "single_player_reachability.hpp"
+#include "speculative_sweep.hpp"
+#include "vertex_activity.hpp"
 #include "libggg/solvers/solver.hpp"
+#include <algorithm>
 #include <map>
 #include <set>
 #include <memory>
 #include <chrono>
+#include <vector>
 
 namespace ggg {
 namespace solvers {
@@ -19,10 +26,13 @@ struct SolverStatistics {
     size_t states_pruned = 0;
     size_t max_time_reached = 0;
     
-    // Constraint evaluation 
+    // Constraint evaluation: (vertex, layer) pairs with / without an enabled move, including the
+    // pairs the activity index skips, so the counts do not depend on whether the index was used
     size_t constraint_evaluations = 0;
     size_t constraint_passes = 0;
     size_t constraint_failures = 0;
+    // Edges checked while collecting enabled moves; excludes the edges of skipped vertices
+    size_t edge_constraint_checks = 0;
     
     // Memoization performance
     size_t cache_hits = 0;
@@ -32,13 +42,75 @@ struct SolverStatistics {
     std::chrono::duration<double> total_solve_time{0};
     std::chrono::duration<double> constraint_eval_time{0};
     std::chrono::duration<double> graph_traversal_time{0};
+    std::chrono::duration<double> solution_time{0};
+    
+    // Memory (estimated bytes)
+    size_t peak_layer_bytes = 0;
+    size_t solution_bytes = 0;
+    
+    // Layer representation (backwards attractor only)
+    size_t sparse_layers = 0;
+    size_t dense_layers = 0;
+    size_t layer_conversions = 0;  // sparse <-> dense switches while building layers
+    
+    // Vertex activity index (layered sweep only, when it was worth using)
+    bool activity_index = false;
+    ActivityStatistics activity;
+    size_t idle_vertex_layers = 0;  // vertices skipped by the layer kernel, also counted as failures
+    
+    // Single-player fast path (only filled when it was used)
+    bool single_player_fast_path = false;
+    SinglePlayerStatistics single_player;
     
     // Reset all statistics
     void reset() {
         states_explored = states_pruned = max_time_reached = 0;
         constraint_evaluations = constraint_passes = constraint_failures = 0;
+        edge_constraint_checks = 0;
         cache_hits = cache_misses = 0;
-        total_solve_time = constraint_eval_time = graph_traversal_time = std::chrono::duration<double>{0};
+        peak_layer_bytes = solution_bytes = 0;
+        sparse_layers = dense_layers = layer_conversions = 0;
+        activity_index = false;
+        activity = ActivityStatistics{};
+        idle_vertex_layers = 0;
+        single_player_fast_path = false;
+        single_player = SinglePlayerStatistics{};
+        total_solve_time = constraint_eval_time = graph_traversal_time = solution_time = std::chrono::duration<double>{0};
+    }
+    
+    // Add the statistics of a separately solved part of the game (times are summed)
+    void accumulate(const SolverStatistics& other) {
+        states_explored = std::max(states_explored, other.states_explored);
+        states_pruned += other.states_pruned;
+        max_time_reached = std::max(max_time_reached, other.max_time_reached);
+        constraint_evaluations += other.constraint_evaluations;
+        constraint_passes += other.constraint_passes;
+        constraint_failures += other.constraint_failures;
+        edge_constraint_checks += other.edge_constraint_checks;
+        cache_hits += other.cache_hits;
+        cache_misses += other.cache_misses;
+        total_solve_time += other.total_solve_time;
+        constraint_eval_time += other.constraint_eval_time;
+        graph_traversal_time += other.graph_traversal_time;
+        solution_time += other.solution_time;
+        peak_layer_bytes = std::max(peak_layer_bytes, other.peak_layer_bytes);
+        solution_bytes += other.solution_bytes;
+        sparse_layers += other.sparse_layers;
+        dense_layers += other.dense_layers;
+        layer_conversions += other.layer_conversions;
+        activity_index = activity_index || other.activity_index;
+        activity.windows += other.activity.windows;
+        activity.inexact_constraints += other.activity.inexact_constraints;
+        activity.active_vertex_layers += other.activity.active_vertex_layers;
+        activity.vertex_layers += other.activity.vertex_layers;
+        activity.build_time += other.activity.build_time;
+        idle_vertex_layers += other.idle_vertex_layers;
+        single_player_fast_path = single_player_fast_path || other.single_player_fast_path;
+        single_player.constant_windows += other.single_player.constant_windows;
+        single_player.matrix_power_windows += other.single_player.matrix_power_windows;
+        single_player.matrix_products += other.single_player.matrix_products;
+        single_player.frontier_steps += other.single_player.frontier_steps;
+        single_player.skipped_layers += other.single_player.skipped_layers;
     }
     
     // Get cache hit ratio (0.0 to 1.0)
@@ -73,6 +145,38 @@ private:
     
     // Performance and debugging statistics
     mutable SolverStatistics stats_;
+    
+    // Targets whose target constraint holds at max_time: the layer after max_time - 1
+    std::set<Vertex> final_targets_;
+    LayerSet final_layer_;
+    
+    // Moves enabled in the layer being computed, as per-vertex ranges into move_targets_
+    std::vector<size_t> move_offsets_;
+    std::vector<Vertex> move_targets_;
+    
+    // Optional per-layer time series, owned by the caller
+    LayerSeries* layer_series_ = nullptr;
+    
+    // Route games without Player 1 choices to SinglePlayerReachability
+    bool single_player_fast_path_ = true;
+    SinglePlayerReachability::WindowMode window_mode_ = SinglePlayerReachability::WindowMode::COST_MODEL;
+    
+    // Sparse/dense switch point of the layers, see LayerSet
+    size_t layer_dense_ratio_ = LayerSet::kDefaultDenseRatio;
+    
+    // Optional parallel-in-time evaluation of the layered sweep, owned by the caller
+    SpeculativeSweep* speculation_ = nullptr;
+    
+    // Skip vertices without an enabled move per layer; the index is shared with speculative workers
+    bool use_activity_index_ = true;
+    std::shared_ptr<const VertexActivityIndex> activity_index_;
+    std::unique_ptr<VertexActivityIndex::Cursor> activity_cursor_;
+    
+    // Upper bound on the number of layer events emitted when tracing
+    static constexpr int kMaxTracedLayerBlocks = 1024;
+    
+    // Vertex names printed per layer in verbose mode before the list is elided
+    static constexpr size_t kMaxVerboseLayerNames = 32;
 
 public:
     /**
@@ -94,6 +198,10 @@ public:
     
     /**
      * @brief Solve from specific initial state
+     *
+     * Only the vertices reachable from initial_vertex are solved, so the
+     * solution covers just those; constraints of other edges are never
+     * evaluated (and stay unparsed after a lazy load).
      */
     SolutionType solve_from_state(Vertex initial_vertex, int initial_time = 0);
     
@@ -106,12 +214,83 @@ public:
      * @brief Reset solver statistics
      */
     void reset_statistics() { stats_.reset(); }
+    
+    /**
+     * @brief Record a per-layer time series into series during solve (nullptr disables)
+     */
+    void set_layer_series(LayerSeries* series) { layer_series_ = series; }
+    
+    /**
+     * @brief Enable or disable the single-player fast path (enabled by default)
+     *
+     * The fast path is skipped while a layer series is recorded, since it does
+     * not materialize every layer.
+     */
+    void set_single_player_fast_path(bool enabled) { single_player_fast_path_ = enabled; }
+    
+    /**
+     * @brief How the fast path applies constant-availability windows
+     */
+    void set_window_mode(SinglePlayerReachability::WindowMode mode) { window_mode_ = mode; }
+    
+    /**
+     * @brief Layers switch to a bitmap above num_vertices / ratio vertices (LayerSet::kDefaultDenseRatio)
+     */
+    void set_layer_dense_ratio(size_t ratio) { layer_dense_ratio_ = std::max<size_t>(1, ratio); }
+    
+    /**
+     * @brief Run the layered sweep speculatively in time chunks through sweep (nullptr disables)
+     *
+     * Ignored while a layer series is recorded; the single-player fast path,
+     * when it applies, still takes precedence.
+     */
+    void set_speculation(SpeculativeSweep* sweep) { speculation_ = sweep; }
+    
+    /**
+     * @brief Enable or disable the vertex activity index of the layered sweep (enabled by default)
+     *
+     * Built at the start of each layered sweep; it is only used when it
+     * leaves at least 10% of the (vertex, layer) pairs idle.
+     */
+    void set_activity_index(bool enabled) { use_activity_index_ = enabled; }
+    
+    /**
+     * @brief Compute a single layer of the backwards attractor
+     * @param time Time step of the layer being computed
+     * @param next_layer Attractor at time + 1 (the targets active at max_time are used instead at max_time - 1)
+     */
+    LayerSet compute_attractor_layer(int time, const LayerSet& next_layer);
 
 private:
+    /**
+     * @brief Re-evaluate target constraints at max_time into final_targets_ and final_layer_
+     */
+    void refresh_final_layer();
+    
+    /**
+     * @brief Build the activity index for max_time_ and start a cursor over it, if enabled and worthwhile
+     */
+    void prepare_activity_index();
+    
     /**
      * @brief Compute backwards temporal attractor starting from targets at max_time
      */
-    std::set<Vertex> compute_backwards_temporal_attractor();
+    LayerSet compute_backwards_temporal_attractor();
+    
+    /**
+     * @brief Same result as compute_backwards_temporal_attractor() for single-player games
+     */
+    LayerSet compute_single_player_attractor();
+    
+    /**
+     * @brief Same result as compute_backwards_temporal_attractor(), through speculation_
+     */
+    LayerSet compute_speculative_attractor();
+    
+    /**
+     * @brief Print the vertex names of a layer for verbose output, eliding long lists
+     */
+    void print_layer(const LayerSet& layer) const;
 };
 
 /**
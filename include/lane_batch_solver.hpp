@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ggg_temporal_graph.hpp"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief A game of at most 64 vertices reduced to bitmasks over its vertex indices
+ */
+struct TinyGame {
+    static constexpr int kMaxVertices = 64;
+
+    int vertices = 0;
+    int time_bound = 0;
+    uint64_t player0 = 0;               // vertices owned by Player 0
+    uint64_t final_targets = 0;         // targets whose target constraint holds at time_bound
+    std::vector<uint64_t> successors;   // row t * vertices + v: successors of v over edges enabled at t
+
+    /**
+     * @brief Evaluate every edge constraint at every time; nullopt if the game has too many vertices
+     */
+    static std::optional<TinyGame> reduce(const graphs::GGGTemporalGameManager& manager,
+                                          const graphs::GGGReachabilityObjective& objective, int time_bound);
+};
+
+/**
+ * @brief Work done by LaneBatchSolver::solve
+ */
+struct LaneBatchStatistics {
+    size_t games = 0;
+    size_t batches = 0;
+    size_t padded_lanes = 0;     // lanes without a game in partially filled batches
+    std::chrono::duration<double> pack_time{0};
+    std::chrono::duration<double> solve_time{0};
+
+    double lane_occupancy() const;
+    double games_per_second() const;
+};
+
+/**
+ * @brief Backwards recurrence on many tiny games at once, one game per lane
+ *
+ * Games with the same horizon are packed kLanes at a time. Each batch
+ * interleaves the successor masks of its games lane by lane, so row (t, v)
+ * is kLanes consecutive words, and every step of the recurrence is the same
+ * branch-free word operation on all lanes:
+ *
+ *   any = succ & W_{t+1},  all = succ != 0 && (succ & ~W_{t+1}) == 0,
+ *   W_t |= bit(v) & (player0 ? any : all)
+ *
+ * over a fixed number of lanes, which the compiler unrolls and vectorizes
+ * without target-specific intrinsics. Vertex sets are padded to the largest game
+ * of the batch and missing lanes to an empty game, whose winning region stays
+ * empty.
+ */
+class LaneBatchSolver {
+public:
+    static constexpr size_t kLanes = 16;
+
+private:
+    LaneBatchStatistics stats_;
+    std::vector<uint64_t> packed_;
+
+    void solve_batch(const std::vector<const TinyGame*>& lanes, std::vector<uint64_t>& winning);
+
+public:
+    /**
+     * @brief Time-0 Player 0 regions of all games, as masks over vertex indices, in input order
+     */
+    std::vector<uint64_t> solve(const std::vector<TinyGame>& games);
+
+    const LaneBatchStatistics& get_statistics() const { return stats_; }
+};
+
+} // namespace solvers
+} // namespace ggg
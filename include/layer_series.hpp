@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief Aggregated cost of a block of consecutive layers of the backwards sweep
+ *
+ * The block covers time steps [time, time + layers); the attractor size is the
+ * one of layer `time`, the other fields are summed over the block.
+ */
+struct LayerSample {
+    int32_t time = 0;
+    uint32_t layers = 0;
+    uint64_t attractor_size = 0;
+    uint64_t enabled_edges = 0;
+    uint64_t constraint_evaluations = 0;
+    uint64_t elapsed_ns = 0;
+};
+
+/**
+ * @brief Per-layer time series of the backwards attractor (--layer-series)
+ *
+ * With a sampling interval of 1 every layer is its own sample; larger intervals
+ * aggregate blocks of layers so very long horizons stay compact. Written as CSV,
+ * or as a little-endian binary series when the file name ends in ".bin":
+ * magic "TLS1", uint32 sample interval, uint64 sample count, then per sample
+ * int32 time, uint32 layers and uint64 attractor size, enabled edges,
+ * constraint evaluations and elapsed nanoseconds.
+ */
+class LayerSeries {
+private:
+    int sample_every_;
+    LayerSample pending_;
+    std::vector<LayerSample> samples_;
+
+public:
+    explicit LayerSeries(int sample_every = 1);
+
+    int sample_every() const { return sample_every_; }
+    const std::vector<LayerSample>& samples() const { return samples_; }
+
+    void clear();
+
+    /**
+     * @brief Add one layer; layers must be added in decreasing time order
+     */
+    void add_layer(int time, size_t attractor_size, size_t enabled_edges,
+                   size_t constraint_evaluations, std::chrono::nanoseconds elapsed);
+
+    void write_csv(std::ostream& out) const;
+    void write_binary(std::ostream& out) const;
+
+    /**
+     * @brief Write the series to a file, binary if it ends in ".bin", CSV otherwise
+     * @return false if the file could not be written
+     */
+    bool write(const std::string& file) const;
+};
+
+} // namespace solvers
+} // namespace ggg
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief Set of vertex indices that is a sorted array while sparse and a bitmap while dense
+ *
+ * Layers of the backwards attractor often hold a few dozen vertices out of
+ * millions for most of the horizon and most of the graph near the targets.
+ * A sorted array costs 32 bits per element and a bitmap one bit per vertex of
+ * the universe, so the set switches to the bitmap when it grows past
+ * universe / 32 elements and back below universe / 64 (the gap avoids
+ * flapping). The ratio 32 is where the two sizes are equal; a different
+ * dense_ratio trades memory for the faster bit tests, and
+ * `temporis --autotune` picks it per machine. Layers are built in increasing
+ * vertex order with push_back, so both representations append in O(1).
+ *
+ * contains_any and contains_all answer the per-vertex successor checks of the
+ * recurrence: empty and full sets answer without looking at the moves, a
+ * sparse set rejects moves outside [front, back] before searching (linearly
+ * when tiny), and a dense set tests bits.
+ */
+class LayerSet {
+public:
+    // Dense above universe / ratio elements, sparse again below universe / (2 * ratio)
+    static constexpr size_t kDefaultDenseRatio = 32;
+
+private:
+    size_t universe_ = 0;
+    size_t size_ = 0;
+    bool dense_ = false;
+    size_t dense_ratio_ = kDefaultDenseRatio;
+    std::vector<uint32_t> sparse_;   // sorted, used while !dense_
+    std::vector<uint64_t> bits_;     // used while dense_
+    size_t conversions_ = 0;
+
+    // Below this many elements a linear scan beats binary search
+    static constexpr size_t kLinearSearch = 16;
+
+    bool sparse_contains(uint32_t vertex) const {
+        if (size_ == 0 || vertex < sparse_.front() || vertex > sparse_.back()) {
+            return false;
+        }
+        if (size_ <= kLinearSearch) {
+            return std::find(sparse_.begin(), sparse_.end(), vertex) != sparse_.end();
+        }
+        return std::binary_search(sparse_.begin(), sparse_.end(), vertex);
+    }
+
+    bool dense_contains(uint32_t vertex) const {
+        return (bits_[vertex >> 6] >> (vertex & 63)) & 1;
+    }
+
+    void to_dense();
+    void to_sparse();
+
+public:
+    LayerSet() = default;
+    explicit LayerSet(size_t universe, size_t dense_ratio = kDefaultDenseRatio)
+        : universe_(universe), dense_ratio_(std::max<size_t>(1, dense_ratio)) {}
+
+    /**
+     * @brief Set holding the sorted range [first, last) of vertex indices
+     */
+    template<typename Iterator>
+    static LayerSet from_sorted(size_t universe, Iterator first, Iterator last,
+                                size_t dense_ratio = kDefaultDenseRatio) {
+        LayerSet set(universe, dense_ratio);
+        for (; first != last; ++first) {
+            set.push_back(static_cast<uint32_t>(*first));
+        }
+        set.shrink();
+        return set;
+    }
+
+    /**
+     * @brief Empty the set, keeping its buffers, for a universe of the given size
+     */
+    void clear(size_t universe);
+
+    /**
+     * @brief Add a vertex larger than every vertex already in the set
+     */
+    void push_back(uint32_t vertex) {
+        if (dense_) {
+            bits_[vertex >> 6] |= uint64_t{1} << (vertex & 63);
+        } else {
+            sparse_.push_back(vertex);
+            if (sparse_.size() * dense_ratio_ > universe_) {
+                ++size_;
+                to_dense();
+                return;
+            }
+        }
+        ++size_;
+    }
+
+    /**
+     * @brief Return to the sorted array if the finished set is sparse again
+     */
+    void shrink() {
+        if (dense_ && size_ * 2 * dense_ratio_ < universe_) {
+            to_sparse();
+        }
+    }
+
+    bool contains(uint32_t vertex) const {
+        return dense_ ? dense_contains(vertex) : sparse_contains(vertex);
+    }
+
+    /**
+     * @brief Whether some vertex of [first, last) is in the set (Player 0 successor check)
+     */
+    template<typename Iterator>
+    bool contains_any(Iterator first, Iterator last) const {
+        if (size_ == 0 || first == last) {
+            return false;
+        }
+        if (size_ == universe_) {
+            return true;
+        }
+        if (dense_) {
+            return std::any_of(first, last, [&](auto v) { return dense_contains(static_cast<uint32_t>(v)); });
+        }
+        return std::any_of(first, last, [&](auto v) { return sparse_contains(static_cast<uint32_t>(v)); });
+    }
+
+    /**
+     * @brief Whether every vertex of [first, last) is in the set (Player 1 successor check)
+     */
+    template<typename Iterator>
+    bool contains_all(Iterator first, Iterator last) const {
+        if (size_ == universe_ || first == last) {
+            return true;
+        }
+        if (size_ == 0) {
+            return false;
+        }
+        if (dense_) {
+            return std::all_of(first, last, [&](auto v) { return dense_contains(static_cast<uint32_t>(v)); });
+        }
+        return std::all_of(first, last, [&](auto v) { return sparse_contains(static_cast<uint32_t>(v)); });
+    }
+
+    /**
+     * @brief Call f(vertex) for every vertex in increasing order
+     */
+    template<typename Function>
+    void for_each(Function&& f) const {
+        if (!dense_) {
+            for (uint32_t vertex : sparse_) {
+                f(vertex);
+            }
+            return;
+        }
+        for (size_t word = 0; word < bits_.size(); ++word) {
+            for (uint64_t bits = bits_[word]; bits != 0; bits &= bits - 1) {
+                f(static_cast<uint32_t>(word * 64 + static_cast<size_t>(std::countr_zero(bits))));
+            }
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t universe() const { return universe_; }
+    size_t dense_ratio() const { return dense_ratio_; }
+    bool dense() const { return dense_; }
+
+    // Representation changes since construction or the last clear()
+    size_t conversions() const { return conversions_; }
+
+    /**
+     * @brief Same vertices, whatever the representations
+     */
+    bool operator==(const LayerSet& other) const;
+
+    size_t memory_bytes() const;
+};
+
+} // namespace solvers
+} // namespace ggg
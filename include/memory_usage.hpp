@@ -0,0 +1,117 @@
+#pragma once
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ggg {
+namespace memory {
+
+// Per-node bookkeeping of a red-black tree node (color + three links)
+constexpr size_t kTreeNodeOverhead = 4 * sizeof(void*);
+
+// Per-node bookkeeping of a doubly linked list node
+constexpr size_t kListNodeOverhead = 2 * sizeof(void*);
+
+/**
+ * @brief Heap bytes owned by a string (zero while it fits the small-string buffer)
+ */
+inline size_t string_heap_bytes(const std::string& value) {
+    return value.capacity() > 15 ? value.capacity() + 1 : 0;
+}
+
+// Bytes of one std::map node; also used for map-backed structures that cannot be inspected
+template<typename K, typename V>
+constexpr size_t map_node_bytes() {
+    return sizeof(std::pair<const K, V>) + kTreeNodeOverhead;
+}
+
+/**
+ * @brief Estimated bytes of an RSSolution: a winner per vertex and one move per strategy vertex
+ */
+template<typename Vertex>
+constexpr size_t solution_bytes(size_t vertices, size_t strategies) {
+    return vertices * map_node_bytes<Vertex, int>() + strategies * map_node_bytes<Vertex, Vertex>();
+}
+
+template<typename K, typename V>
+size_t container_bytes(const std::map<K, V>& container) {
+    return container.size() * map_node_bytes<K, V>();
+}
+
+template<typename K>
+size_t container_bytes(const std::set<K>& container) {
+    return container.size() * (sizeof(K) + kTreeNodeOverhead);
+}
+
+template<typename T>
+size_t container_bytes(const std::vector<T>& container) {
+    return container.capacity() * sizeof(T);
+}
+
+/**
+ * @brief Estimated bytes of a vecS/vecS bidirectional Boost adjacency_list
+ *
+ * Counts the vertex records, both incidence lists, the global edge list and
+ * the heap memory of bundled properties reported by the given callbacks.
+ * Graph functions are found by argument-dependent lookup.
+ */
+template<typename Graph, typename VertexHeapBytes, typename EdgeHeapBytes>
+size_t estimate_graph_bytes(const Graph& graph, VertexHeapBytes vertex_heap_bytes, EdgeHeapBytes edge_heap_bytes) {
+    using VertexBundle = typename boost::vertex_bundle_type<Graph>::type;
+    using EdgeBundle = typename boost::edge_bundle_type<Graph>::type;
+
+    // Vertex record: bundle plus out- and in-edge vectors
+    size_t bytes = num_vertices(graph) * (sizeof(VertexBundle) + 2 * sizeof(std::vector<void*>));
+    // Edge: list node holding the bundle, plus one stored edge in each incidence list
+    bytes += num_edges(graph) *
+             (sizeof(EdgeBundle) + 2 * sizeof(size_t) + kListNodeOverhead + 2 * 2 * sizeof(void*));
+
+    auto [vertex_begin, vertex_end] = vertices(graph);
+    for (auto it = vertex_begin; it != vertex_end; ++it) {
+        bytes += vertex_heap_bytes(graph[*it]);
+    }
+    auto [edge_begin, edge_end] = edges(graph);
+    for (auto it = edge_begin; it != edge_end; ++it) {
+        bytes += edge_heap_bytes(graph[*it]);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Peak resident set size of the process in bytes (0 if unknown)
+ */
+size_t peak_rss_bytes();
+
+/**
+ * @brief Named byte counts of the main data structures of a run
+ */
+class MemoryReport {
+private:
+    std::vector<std::pair<std::string, size_t>> entries_;
+
+public:
+    void add(const std::string& name, size_t bytes);
+    size_t get(const std::string& name) const;
+    size_t total() const;
+    const std::vector<std::pair<std::string, size_t>>& entries() const { return entries_; }
+
+    /**
+     * @brief Print the entries, their total and the peak RSS for verbose output
+     */
+    void write_report(std::ostream& out) const;
+
+    /**
+     * @brief Comma-prefixed CSV fields: one per entry, followed by the peak RSS
+     */
+    std::string csv_fields() const;
+};
+
+} // namespace memory
+} // namespace ggg
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "libggg/parity/graph.hpp"
+#include <boost/graph/graph_traits.hpp>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief Work done by one parallel attractor computation
+ */
+struct ParallelAttractorStatistics {
+    size_t threads = 0;
+    size_t levels = 0;           // frontiers processed, targets included
+    size_t peak_frontier = 0;
+    size_t edges_scanned = 0;    // in-edges of frontier vertices
+    std::chrono::duration<double> init_time{0};
+    std::chrono::duration<double> frontier_time{0};
+};
+
+/**
+ * @brief Multi-threaded attractor with the result of player_utilities::compute_attractor
+ *
+ * The sequential attractor pops a FIFO worklist, so it visits the targets,
+ * then every vertex they attract, and so on, one frontier at a time. Here
+ * each frontier is split into chunks taken by a pool of threads that scan the
+ * in-edges of its vertices: vertices of the attracting player are claimed
+ * with a compare-and-swap, opponent vertices through an atomic counter of
+ * outstanding out-edges, and claims go to per-thread buffers appended to the
+ * next frontier with one fetch_add each.
+ *
+ * Every scanned in-edge gets a rank, its position in the order the
+ * sequential worklist would scan it. A vertex records the rank of the edge
+ * that attracted it (the smallest for the attracting player, the largest,
+ * i.e. the last outstanding one, for the opponent), and sorting the next
+ * frontier by it restores the worklist order. The attracting player's
+ * strategy is the frontier vertex owning its smallest rank, so attractor and
+ * strategy are identical to the sequential version for any thread count.
+ */
+class ParallelAttractor {
+public:
+    using Graph = ggg::parity::graph::Graph;
+    using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+
+private:
+    int threads_;
+    ParallelAttractorStatistics stats_;
+
+    // Vertices per chunk taken by one thread
+    static constexpr size_t kChunkVertices = 256;
+
+public:
+    /**
+     * @param threads Worker threads; 0 uses the hardware concurrency
+     */
+    explicit ParallelAttractor(int threads = 0);
+
+    /**
+     * @brief Attractor of targets for player, with a strategy for player's attracted non-target vertices
+     */
+    std::pair<std::set<Vertex>, std::map<Vertex, Vertex>> compute(const Graph& graph,
+                                                                 const std::set<Vertex>& targets, int player);
+
+    const ParallelAttractorStatistics& get_statistics() const { return stats_; }
+};
+
+} // namespace solvers
+} // namespace ggg
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace perf {
+
+/**
+ * @brief Hardware events sampled by --perf-counters
+ */
+enum CounterId { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, NUM_COUNTERS };
+
+/**
+ * @brief Counter values for one interval; unavailable counters are flagged
+ */
+struct CounterSample {
+    std::array<uint64_t, NUM_COUNTERS> values{};
+    std::array<bool, NUM_COUNTERS> available{};
+
+    CounterSample operator-(const CounterSample& other) const;
+    CounterSample& operator+=(const CounterSample& other);
+
+    // Instructions per cycle, 0 if either counter is unavailable
+    double ipc() const;
+};
+
+/**
+ * @brief Accumulated counters of a named solve phase
+ */
+struct PhaseCounters {
+    std::string name;
+    CounterSample sample;
+    bool partial = false;   // measured while a worker pool was running
+};
+
+/**
+ * @brief Process-wide hardware performance counters via Linux perf_event_open
+ *
+ * Each event is opened independently for the calling thread, so events the
+ * host does not support are reported as unavailable while the others keep
+ * working. Threads created afterwards inherit the events, but their counts
+ * are only added to read() once they exit: an interval that overlaps a
+ * running worker pool misses that pool's work and is marked partial. Values
+ * are scaled for multiplexing. On other platforms every counter is
+ * unavailable.
+ */
+class PerfCounters {
+private:
+    bool enabled_ = false;
+    std::array<int, NUM_COUNTERS> fds_;
+    std::string unavailable_reason_;
+    std::vector<PhaseCounters> phases_;
+    std::mutex phases_mutex_;
+    std::atomic<int> running_pools_{0};
+
+    PerfCounters();
+
+public:
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    static PerfCounters& instance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    /**
+     * @brief Open and start all counters
+     * @return true if at least one counter is available
+     */
+    bool enable();
+
+    bool enabled() const { return enabled_; }
+    bool any_available() const;
+    const std::string& unavailable_reason() const { return unavailable_reason_; }
+
+    /**
+     * @brief Counter totals since enable() of the enabling thread and its exited children
+     */
+    CounterSample read() const;
+
+    /**
+     * @brief Add a measured interval to the named phase (thread-safe)
+     *
+     * A phase becomes partial once any of its intervals was partial.
+     */
+    void add_phase(const std::string& name, const CounterSample& delta, bool partial = false);
+
+    /**
+     * @brief Worker pools whose threads have not all exited, see ScopedWorkerPool
+     */
+    bool pool_running() const { return running_pools_.load(std::memory_order_relaxed) > 0; }
+    void pool_started() { running_pools_.fetch_add(1, std::memory_order_relaxed); }
+    void pool_finished() { running_pools_.fetch_sub(1, std::memory_order_relaxed); }
+
+    const std::vector<PhaseCounters>& phases() const { return phases_; }
+    const PhaseCounters* find_phase(const std::string& name) const;
+
+    /**
+     * @brief Print a per-phase table for verbose output
+     */
+    void write_report(std::ostream& out) const;
+
+    /**
+     * @brief Comma-prefixed CSV fields (one per counter) for a phase; unavailable values are empty
+     */
+    std::string csv_fields(const std::string& phase) const;
+
+    static const char* counter_name(CounterId id);
+};
+
+/**
+ * @brief RAII interval that adds its counter deltas to a named phase
+ *
+ * The interval is partial if a worker pool was running when it started or ended.
+ */
+class ScopedPerfPhase {
+private:
+    const char* name_;
+    bool active_;
+    bool partial_ = false;
+    CounterSample start_;
+
+public:
+    explicit ScopedPerfPhase(const char* name)
+        : name_(name), active_(PerfCounters::instance().enabled()) {
+        if (active_) {
+            partial_ = PerfCounters::instance().pool_running();
+            start_ = PerfCounters::instance().read();
+        }
+    }
+
+    ~ScopedPerfPhase() {
+        if (active_) {
+            auto& counters = PerfCounters::instance();
+            CounterSample delta = counters.read() - start_;
+            counters.add_phase(name_, delta, partial_ || counters.pool_running());
+        }
+    }
+
+    ScopedPerfPhase(const ScopedPerfPhase&) = delete;
+    ScopedPerfPhase& operator=(const ScopedPerfPhase&) = delete;
+};
+
+/**
+ * @brief Marks a pool of worker threads as running from before they start until after they are joined
+ */
+class ScopedWorkerPool {
+public:
+    ScopedWorkerPool() { PerfCounters::instance().pool_started(); }
+    ~ScopedWorkerPool() { PerfCounters::instance().pool_finished(); }
+
+    ScopedWorkerPool(const ScopedWorkerPool&) = delete;
+    ScopedWorkerPool& operator=(const ScopedWorkerPool&) = delete;
+};
+
+} // namespace perf
+} // namespace ggg
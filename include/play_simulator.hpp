@@ -0,0 +1,141 @@
+#pragma once
+
+#include "ggg_temporal_graph.hpp"
+#include "libggg/solvers/solver.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief How plays are started and how each player picks among its enabled moves
+ */
+struct SimulationOptions {
+    enum class Player0Policy {
+        STRATEGY,   // a move into the next winning layer when there is one (time-dependent winning strategy)
+        SOLUTION,   // the solution's positional strategy move when it is enabled
+        RANDOM
+    };
+    enum class Player1Policy {
+        RANDOM,
+        ADVERSARIAL  // a move out of the next winning layer when there is one
+    };
+
+    uint64_t plays = 0;
+    Player0Policy player0 = Player0Policy::STRATEGY;
+    Player1Policy player1 = Player1Policy::RANDOM;
+    int threads = 0;                       // <= 0 uses all hardware threads
+    size_t batch_size = 1024;              // plays advanced together, one lane each
+    uint64_t seed = 1;
+    bool from_winning = true;              // start in the time-0 winning region (all vertices if it is empty)
+    std::optional<size_t> start_vertex;    // start every play here instead (vertex index)
+
+    static const char* name(Player0Policy policy);
+    static const char* name(Player1Policy policy);
+    static bool parse(const std::string& text, Player0Policy& policy);
+    static bool parse(const std::string& text, Player1Policy& policy);
+};
+
+/**
+ * @brief Outcome and throughput of a simulation
+ */
+struct SimulationReport {
+    SimulationOptions options;
+    uint64_t plays = 0;
+    uint64_t wins = 0;
+    uint64_t stuck = 0;                          // plays that ended early without an enabled move
+    uint64_t batches = 0;
+    size_t threads = 0;
+    size_t start_vertices = 0;
+    bool winning_starts = false;                 // starts are the time-0 winning region
+    std::vector<uint64_t> length_histogram;      // plays per length, 0 .. time bound
+    uint64_t availability_checks = 0;
+    std::chrono::duration<double> availability_time{0};
+    std::chrono::duration<double> layers_time{0};
+    std::chrono::duration<double> play_time{0};
+
+    double win_rate() const { return plays > 0 ? static_cast<double>(wins) / static_cast<double>(plays) : 0.0; }
+    double plays_per_second() const;
+    double mean_length() const;
+
+    /**
+     * @brief Smallest length such that at least the fraction q of plays are not longer
+     */
+    int length_percentile(double q) const;
+};
+
+/**
+ * @brief Native batched simulator of plays over a loaded game
+ *
+ * Constraint availability is evaluated once per (edge, time) into a bitmap,
+ * and the winning layers W_t are derived from that bitmap, so plays never
+ * touch a formula. Plays run in batches held as structure-of-arrays lanes
+ * (vertex, alive flag, random state), all lanes advancing one time step
+ * before the next; batches are spread over a thread pool. Each play draws
+ * from its own generator seeded by the play number, so results do not depend
+ * on the thread count.
+ *
+ * A play starting at time 0 wins if it is on a target after max_time moves
+ * and loses as soon as the current vertex has no enabled move.
+ */
+class PlaySimulator {
+public:
+    using GraphType = graphs::GGGTemporalGraph;
+    using SolutionType = solutions::RSSolution<GraphType>;
+    using Bits = std::vector<uint64_t>;
+
+private:
+    std::shared_ptr<graphs::GGGTemporalGameManager> manager_;
+    std::shared_ptr<graphs::GGGReachabilityObjective> objective_;
+    int max_time_;
+
+    // Out-edges in CSR form; edge ids index the availability rows
+    size_t vertex_count_ = 0;
+    size_t edge_count_ = 0;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> targets_;
+    std::vector<uint8_t> players_;
+    std::vector<uint8_t> is_target_;
+    std::vector<uint32_t> strategy_;   // solution strategy target per vertex, kNoMove if none
+
+    size_t edge_words_ = 0;
+    size_t vertex_words_ = 0;
+    Bits availability_;                // row t: enabled edges at time t
+    Bits layers_;                      // row t: W_t, row max_time: targets
+    bool prepared_ = false;
+    SimulationReport report_;
+
+    static constexpr uint32_t kNoMove = UINT32_MAX;
+
+    void prepare();
+
+    struct Batch;
+    void run_batch(Batch& batch, const std::vector<uint32_t>& starts, uint64_t first_play, size_t lanes) const;
+
+public:
+    PlaySimulator(std::shared_ptr<graphs::GGGTemporalGameManager> manager,
+                  std::shared_ptr<graphs::GGGReachabilityObjective> objective, int max_time);
+
+    /**
+     * @brief Use this solution's strategy for the SOLUTION policy
+     */
+    void set_solution(const SolutionType& solution);
+
+    /**
+     * @brief Run options.plays plays; availability and layers are computed on the first call
+     */
+    const SimulationReport& simulate(const SimulationOptions& options);
+
+    const SimulationReport& get_report() const { return report_; }
+
+    void write_report(std::ostream& out) const;
+};
+
+} // namespace solvers
+} // namespace ggg
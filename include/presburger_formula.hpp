@@ -27,6 +27,7 @@ private:
 
 public:
     PresburgerFormula(Type t, const PresburgerTerm& l, const PresburgerTerm& r);
+    ~PresburgerFormula();
     
     static std::unique_ptr<PresburgerFormula> equal(const PresburgerTerm& left, const PresburgerTerm& right);
     static std::unique_ptr<PresburgerFormula> greaterequal(const PresburgerTerm& left, const PresburgerTerm& right);
@@ -41,6 +42,18 @@ public:
     
     std::string to_string() const;
     bool evaluate(const std::map<std::string, int>& values) const;
+    
+    // Read-only structure, e.g. for code generation
+    Type type() const { return type_; }
+    const PresburgerTerm& left() const { return left_; }
+    const PresburgerTerm& right() const { return right_; }
+    const std::vector<std::unique_ptr<PresburgerFormula>>& children() const { return children_; }
+    const std::string& existential_var() const { return existential_var_; }
+    int modulus_value() const { return modulus_; }
+    int remainder_value() const { return remainder_; }
+    
+    // Bytes of this formula tree, including the object itself
+    size_t memory_bytes() const;
 
 private:
     int evaluate_term(const PresburgerTerm& term, const std::map<std::string, int>& values) const;
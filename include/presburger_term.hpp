@@ -22,6 +22,9 @@ public:
     PresburgerTerm operator+(const PresburgerTerm& other) const;
     PresburgerTerm operator*(int scalar) const;
     std::string to_string() const;
+    
+    // Heap bytes owned by this term (not counting the object itself)
+    size_t memory_bytes() const;
 };
 
 } // namespace graphs
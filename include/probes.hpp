@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file probes.hpp
+ * @brief USDT static tracepoints (provider "temporis")
+ *
+ * When CMake finds <sys/sdt.h> (TEMPORIS_HAVE_USDT) each probe compiles to a
+ * single NOP plus an ELF note, so bpftrace, perf or SystemTap can attach to a
+ * running solve without rebuilding:
+ *
+ *   bpftrace -e 'usdt:./temporis:temporis:layer__done { @[arg1] = count(); }'
+ *
+ * Without the header the macros expand to nothing and their arguments are not
+ * evaluated, so a value computed only for a probe needs [[maybe_unused]].
+ *
+ * Probes and arguments:
+ *   load__start()
+ *   load__done(bytes, vertices, edges, constraints)
+ *   constraint__compile__start(text, length)
+ *   constraint__compile__done(text, length, elapsed_ns)
+ *   layer__start(time, previous_attractor_size)
+ *   layer__done(time, attractor_size, enabled_edges, constraint_checks)
+ *   expansion__start(vertices, edges, time_layers)
+ *   expansion__done(expanded_vertices, expanded_edges, constraint_evaluations)
+ *   attractor__start(expanded_vertices, target_vertices)
+ *   attractor__done(attractor_size)
+ *   window__done(first_time, layers, enabled_edges)   single-player fast path
+ */
+
+#ifdef TEMPORIS_HAVE_USDT
+#include <sys/sdt.h>
+#define TEMPORIS_PROBE0(name) DTRACE_PROBE(temporis, name)
+#define TEMPORIS_PROBE1(name, a) DTRACE_PROBE1(temporis, name, a)
+#define TEMPORIS_PROBE2(name, a, b) DTRACE_PROBE2(temporis, name, a, b)
+#define TEMPORIS_PROBE3(name, a, b, c) DTRACE_PROBE3(temporis, name, a, b, c)
+#define TEMPORIS_PROBE4(name, a, b, c, d) DTRACE_PROBE4(temporis, name, a, b, c, d)
+#else
+#define TEMPORIS_PROBE0(name) ((void)0)
+#define TEMPORIS_PROBE1(name, a) ((void)0)
+#define TEMPORIS_PROBE2(name, a, b) ((void)0)
+#define TEMPORIS_PROBE3(name, a, b, c) ((void)0)
+#define TEMPORIS_PROBE4(name, a, b, c, d) ((void)0)
+#endif
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ggg {
+
+// Recorded subsystem results; only run_statistics.cpp needs their definitions
+namespace codegen {
+struct CodegenReport;
+}
+namespace graphs {
+struct LoadStatistics;
+struct LazyConstraintStatistics;
+}
+namespace memory {
+class MemoryReport;
+}
+namespace solvers {
+struct ComponentStatistics;
+struct ComponentTiming;
+struct SensitivityStatistics;
+struct SimulationReport;
+struct SpeculationStatistics;
+}
+
+namespace stats {
+
+/**
+ * @brief End-to-end statistics of one solver run, written by --stats-json
+ *
+ * Both executables fill the same schema: top-level phases (read, parse,
+ * constraint_compile, codegen, preprocess, solve, output, total), solver
+ * sub-phases, sizes, counters, memory, per-component timings of decomposed
+ * solves and the build/runtime environment. Durations are in seconds. Fields
+ * a solver does not produce are simply absent.
+ */
+class RunStatistics {
+public:
+    using Duration = std::chrono::duration<double>;
+
+    static constexpr int kSchemaVersion = 1;
+
+private:
+    using Entries = std::vector<std::pair<std::string, uint64_t>>;
+    using Phases = std::vector<std::pair<std::string, Duration>>;
+
+    std::chrono::steady_clock::time_point start_;
+    std::string tool_;
+    std::string solver_;
+    std::string input_;
+    std::string status_ = "unknown";
+    int solver_threads_ = 1;
+    Phases phases_;
+    Phases solve_phases_;
+    Entries sizes_;
+    Entries counters_;
+    Entries memory_;
+    std::vector<solvers::ComponentTiming> components_;
+
+    static void add_duration(Phases& phases, const std::string& name, Duration duration);
+    static void set_entry(Entries& entries, const std::string& name, uint64_t value);
+
+public:
+    explicit RunStatistics(std::string tool);
+    ~RunStatistics();
+
+    void set_solver(const std::string& solver) { solver_ = solver; }
+    void set_input(const std::string& input) { input_ = input; }
+    void set_status(const std::string& status) { status_ = status; }
+    void set_solver_threads(int threads) { solver_threads_ = threads; }
+
+    // Durations accumulate when a phase is reported more than once
+    void add_phase(const std::string& name, Duration duration);
+    void add_solve_phase(const std::string& name, Duration duration);
+
+    void set_size(const std::string& name, uint64_t value);
+    void set_counter(const std::string& name, uint64_t value);
+
+    /**
+     * @brief Record the parse and constraint_compile phases and the input sizes of a load
+     */
+    void add_load_statistics(const graphs::LoadStatistics& load);
+
+    void set_memory(const memory::MemoryReport& report);
+
+    /**
+     * @brief Record the decomposition phases, counters and per-work-item timings of a decomposed solve
+     */
+    void add_component_statistics(const solvers::ComponentStatistics& components);
+
+    /**
+     * @brief Record the codegen phase and its measured saving over the solve's constraint evaluations
+     */
+    void add_codegen_report(const codegen::CodegenReport& report, double evaluations);
+
+    /**
+     * @brief Record how many deferred constraints a lazy load had to parse, and the time spent
+     */
+    void add_lazy_constraint_statistics(const graphs::LazyConstraintStatistics& lazy);
+
+    /**
+     * @brief Record the outcome, play length percentiles and throughput of a simulation (its time is the simulate phase)
+     */
+    void add_simulation_report(const solvers::SimulationReport& simulation);
+
+    /**
+     * @brief Record the sensitivity phase and how many edges and states it found critical
+     */
+    void add_sensitivity_statistics(const solvers::SensitivityStatistics& sensitivity, size_t critical_edges);
+
+    /**
+     * @brief Record the speculation sub-phases, hit counts and estimated speedup of a speculative sweep
+     */
+    void add_speculation_statistics(const solvers::SpeculationStatistics& speculation, int horizon);
+
+    /**
+     * @brief Write the JSON document; total is measured up to this call
+     */
+    void write_json(std::ostream& out) const;
+
+    /**
+     * @brief Write the JSON document to a file
+     * @return false if the file could not be written
+     */
+    bool write_json(const std::string& file) const;
+};
+
+/**
+ * @brief RAII timer that adds its wall time to a top-level phase
+ */
+class ScopedPhase {
+private:
+    RunStatistics& stats_;
+    const char* name_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    ScopedPhase(RunStatistics& stats, const char* name)
+        : stats_(stats), name_(name), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedPhase() {
+        stats_.add_phase(name_, std::chrono::steady_clock::now() - start_);
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+};
+
+/**
+ * @brief Name of this host, or "localhost" if it has none; recorded in bundles and tuning profiles
+ */
+std::string host_name();
+
+/**
+ * @brief Current UTC time in ISO 8601, e.g. 2024-05-01T12:00:00Z
+ */
+std::string utc_timestamp();
+
+} // namespace stats
+} // namespace ggg
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ggg_temporal_graph.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief An edge whose removal at some time steps changes the time-0 winning region
+ */
+struct CriticalEdge {
+    graphs::GGGTemporalEdge edge;
+    size_t index = 0;                           // position in boost::edges order
+    bool player0_loses = true;                  // removal shrinks Player 0's region (else it grows)
+    std::vector<std::pair<int, int>> windows;   // inclusive time ranges
+
+    size_t times() const;
+};
+
+/**
+ * @brief Work done by one sensitivity analysis
+ */
+struct SensitivityStatistics {
+    size_t winning_states = 0;       // (vertex, time) states in some layer
+    size_t pivotal_states = 0;       // states whose flip alone changes layer 0
+    size_t critical_edge_times = 0;  // (edge, time) pairs reported
+    size_t constraint_checks = 0;
+    std::chrono::duration<double> backward_time{0};
+    std::chrono::duration<double> forward_time{0};
+};
+
+/**
+ * @brief Which edges the time-0 winning region depends on, without re-solving per edge
+ *
+ * A backward pass stores every layer W_t. Removing edge u -> w at time t can
+ * only change whether (u, t) is in W_t, and it does exactly when the edge is
+ * u's only move into W_{t+1} (Player 0), u's only move at all (Player 1 in
+ * W_t), or u's only escape from W_{t+1} next to other moves (Player 1 outside
+ * W_t). A forward pass then finds the pivotal states, whose flip alone
+ * changes W_0: every state of layer 0, and (v, t+1) when flipping v flips a
+ * pivotal (u, t), e.g. because v is the only winning successor of a Player 0
+ * vertex. Layers are monotone in the next layer, so flips propagate in one
+ * direction and every reported (edge, time) is critical.
+ *
+ * Flips that only change W_0 together (a vertex at t - 1 losing both of its
+ * two supports at once) are not detected, so the report can miss edges whose
+ * effect needs such a joint flip.
+ */
+class SensitivityAnalysis {
+public:
+    using GraphType = graphs::GGGTemporalGraph;
+    using Vertex = graphs::GGGTemporalVertex;
+    using Bits = std::vector<uint64_t>;
+
+private:
+    std::shared_ptr<graphs::GGGTemporalGameManager> manager_;
+    std::shared_ptr<graphs::GGGReachabilityObjective> objective_;
+    int max_time_;
+    SensitivityStatistics stats_;
+
+    struct OutEdge {
+        size_t target;
+        size_t edge;
+    };
+
+    // Out-edges per vertex, sorted by target so parallel edges are adjacent
+    size_t vertex_count_ = 0;
+    size_t words_ = 0;
+    std::vector<size_t> offsets_;
+    std::vector<OutEdge> out_edges_;
+    std::vector<graphs::GGGTemporalEdge> edges_;
+    std::vector<int> players_;
+    std::vector<Bits> layers_;   // layers_[t] is W_t; layers_[max_time] holds the targets
+
+    void index_graph();
+    void enabled_out_edges(size_t vertex, int time, std::vector<OutEdge>& enabled);
+
+public:
+    SensitivityAnalysis(std::shared_ptr<graphs::GGGTemporalGameManager> manager,
+                        std::shared_ptr<graphs::GGGReachabilityObjective> objective, int max_time);
+
+    /**
+     * @brief Critical edges with their windows, one entry per edge and direction
+     */
+    std::vector<CriticalEdge> analyze();
+
+    /**
+     * @brief Whether the vertex with this index is in W_time (valid after analyze)
+     */
+    bool in_layer(int time, size_t vertex) const;
+
+    const SensitivityStatistics& get_statistics() const { return stats_; }
+
+    /**
+     * @brief Write source,target,constraint,impact,windows rows
+     */
+    void write_csv(std::ostream& out, const std::vector<CriticalEdge>& critical) const;
+
+    /**
+     * @brief Print pass times and the critical edges with the longest windows for verbose output
+     */
+    void write_report(std::ostream& out, const std::vector<CriticalEdge>& critical, size_t max_edges = 10) const;
+};
+
+} // namespace solvers
+} // namespace ggg
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ggg_temporal_graph.hpp"
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief Work done by the single-player engine during one solve
+ */
+struct SinglePlayerStatistics {
+    size_t constant_windows = 0;      // maximal runs of time steps with identical edge availability
+    size_t matrix_power_windows = 0;  // windows applied by repeated squaring instead of stepping
+    size_t matrix_products = 0;       // boolean matrix-matrix products
+    size_t frontier_steps = 0;        // sparse one-step frontier propagations
+    size_t skipped_layers = 0;        // layers not materialized (squaring, fixpoint or empty frontier)
+};
+
+/**
+ * @brief Punctual reachability when only Player 0 makes choices
+ *
+ * If every Player 1 vertex has all its out-edges leading to one vertex, "all
+ * enabled moves" and "some enabled move" coincide and layer t is simply the set
+ * of vertices with an edge enabled at t into layer t + 1. Layers are bitsets and
+ * are propagated one step at a time over the enabled edges. Within a window of
+ * consecutive time steps with the same available edges the step relation is a
+ * fixed boolean matrix A, so the window of k steps is applied as A^k by repeated
+ * squaring of bit-matrix rows when that is cheaper than k sparse steps.
+ *
+ * Edge availability is still evaluated at every time step to find the windows;
+ * the saving is in propagation, which becomes logarithmic per window.
+ */
+class SinglePlayerReachability {
+public:
+    using GraphType = graphs::GGGTemporalGraph;
+    using Vertex = graphs::GGGTemporalVertex;
+    using Bits = std::vector<uint64_t>;
+
+    /**
+     * @brief How windows are applied; the forced modes exist for differential testing
+     */
+    enum class WindowMode { COST_MODEL, ALWAYS_STEP, ALWAYS_SQUARE };
+
+private:
+    std::shared_ptr<graphs::GGGTemporalGameManager> manager_;
+    int max_time_;
+    WindowMode mode_ = WindowMode::COST_MODEL;
+    SinglePlayerStatistics stats_;
+
+    struct IndexedEdge {
+        size_t source;
+        size_t target;
+        graphs::GGGTemporalEdge edge;
+    };
+
+    size_t vertex_count_ = 0;
+    size_t words_ = 0;
+    std::vector<Vertex> vertices_;
+    std::vector<IndexedEdge> always_edges_;
+    std::vector<IndexedEdge> constrained_edges_;
+
+    void index_graph();
+    void evaluate_availability(int time, Bits& available);
+    size_t apply_window(const Bits& available, int layers, Bits& frontier);
+    void step(const std::vector<const IndexedEdge*>& edges, const Bits& frontier, Bits& result) const;
+    void multiply(const std::vector<Bits>& left, const std::vector<Bits>& right, std::vector<Bits>& result) const;
+    void apply_matrix(const std::vector<Bits>& matrix, const Bits& frontier, Bits& result) const;
+
+public:
+    SinglePlayerReachability(std::shared_ptr<graphs::GGGTemporalGameManager> manager, int max_time);
+
+    /**
+     * @brief Whether the game has no real Player 1 choice (see class comment)
+     */
+    static bool applies(const GraphType& graph);
+
+    void set_window_mode(WindowMode mode) { mode_ = mode; }
+
+    /**
+     * @brief Layer 0 of the backwards attractor, i.e. Player 0's winning region
+     * @param constraint_checks Incremented by the number of constraint evaluations
+     */
+    std::set<Vertex> solve(const std::set<Vertex>& targets, size_t& constraint_checks);
+
+    const SinglePlayerStatistics& get_statistics() const { return stats_; }
+};
+
+} // namespace solvers
+} // namespace ggg
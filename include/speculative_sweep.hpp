@@ -0,0 +1,128 @@
+#pragma once
+
+#include "layer_set.hpp"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief Work and outcome of one speculative sweep
+ */
+struct SpeculationStatistics {
+    size_t threads = 0;
+    size_t chunks = 0;
+    size_t predictions = 0;         // predicted chunk inputs, every chunk but the top one
+    size_t hits = 0;                // predictions equal to the exact layer
+    size_t table_predictions = 0;   // predictions taken from the previous solve's table
+    size_t converged = 0;           // misses whose recomputation met the speculative layers again
+    int period = 0;                 // period found in the probe (1: stable), 0 if none
+    size_t probe_layers = 0;        // exact layers computed before speculating
+    size_t warmup_layers = 0;       // layers computed only to predict an input
+    size_t speculative_layers = 0;
+    size_t recomputed_layers = 0;
+    std::chrono::duration<double> probe_time{0};
+    std::chrono::duration<double> speculate_time{0};   // wall time of the worker pool
+    std::chrono::duration<double> validate_time{0};
+    std::chrono::duration<double> layer_time{0};       // summed over threads
+
+    double hit_rate() const {
+        return predictions > 0 ? static_cast<double>(hits) / static_cast<double>(predictions) : 1.0;
+    }
+
+    /**
+     * @brief Mean layer cost times the horizon, over the wall time of probe, speculation and validation
+     */
+    double estimated_speedup(int horizon) const;
+};
+
+/**
+ * @brief Speculative parallel-in-time evaluation of the backwards layer recurrence
+ *
+ * Layer t of the backwards attractor is a function of layer t + 1 only, so
+ * the horizon can be cut into chunks that run concurrently once each chunk
+ * has a guess for the layer above it. Before speculating, a short probe
+ * computes the top layers exactly and looks for the smallest period P with
+ * layer(t) == layer(t + P) across the probe (P = 1 when the layers have
+ * become stable); a chunk input at time b is then predicted as the probe
+ * layer congruent to b modulo P. With the WARMUP predictor each chunk instead
+ * starts a warm-up window above its input from the final layer, which is
+ * exact whenever the recurrence forgets its start within the window. Inputs
+ * recorded in a previous solve's table take precedence over both.
+ *
+ * Validation then walks the chunks from the top: a chunk whose predicted
+ * input equals the exact layer produced by the chunk above is exact as it
+ * is, otherwise it is recomputed from the exact input until a recomputed
+ * layer equals its speculative layer at a checkpoint, after which the rest
+ * of the chunk is known to be exact as well. The result is therefore always
+ * the sequential one; mispredictions only cost time.
+ */
+class SpeculativeSweep {
+public:
+    enum class Predictor {
+        PERIODIC,  // probe at the top, repeat its period (or its stable layer)
+        WARMUP     // warm-up window above every chunk input
+    };
+
+    /**
+     * @brief Layer at time from the layer at time + 1; one instance per thread
+     */
+    using LayerStep = std::function<LayerSet(int time, const LayerSet& next)>;
+    using StepFactory = std::function<LayerStep()>;
+
+    // Chunks shorter than this are not worth a thread
+    static constexpr int kMinChunkLayers = 16;
+    static constexpr int kDefaultWarmupLayers = 32;
+    static constexpr int kProbeLayers = 64;
+
+private:
+    int threads_;
+    int chunks_;
+    Predictor predictor_;
+    int warmup_layers_ = kDefaultWarmupLayers;
+    SpeculationStatistics stats_;
+
+    // Exact layers at chunk boundaries, from set_table() before and from run() after a solve
+    std::map<int, LayerSet> table_;
+    size_t table_universe_ = 0;
+
+    // Memory for the speculative layers kept to detect convergence after a miss
+    static constexpr size_t kCheckpointBudgetBytes = size_t{64} << 20;
+
+public:
+    /**
+     * @param threads Worker threads; 0 uses the hardware concurrency
+     * @param chunks Chunks of the horizon; 0 uses two per thread
+     */
+    explicit SpeculativeSweep(int threads = 0, int chunks = 0, Predictor predictor = Predictor::PERIODIC);
+
+    static bool parse_predictor(const std::string& name, Predictor& out);
+
+    void set_warmup_layers(int layers) { warmup_layers_ = std::max(1, layers); }
+
+    /**
+     * @brief Layer at time 0 of layer(t) = step(t, layer(t + 1)) with layer(horizon) = final_layer
+     */
+    LayerSet run(int horizon, const LayerSet& final_layer, const StepFactory& make_step);
+
+    const SpeculationStatistics& get_statistics() const { return stats_; }
+
+    /**
+     * @brief Read a table written by save_table(); false with error set if unreadable or for another universe
+     */
+    bool load_table(const std::string& path, size_t universe, std::string& error);
+
+    /**
+     * @brief Write the exact boundary layers of the last run, to predict the next solve of the same game
+     */
+    bool save_table(const std::string& path) const;
+
+    void write_report(std::ostream& out, int horizon) const;
+};
+
+} // namespace solvers
+} // namespace ggg
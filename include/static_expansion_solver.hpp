@@ -1,9 +1,11 @@
 #pragma once
 
 #include "ggg_temporal_graph.hpp"
+#include "parallel_attractor.hpp"
 #include "libggg/solvers/solver.hpp"
 #include "libggg/graphs/player_utilities.hpp"
 #include "libggg/parity/graph.hpp"
+#include <algorithm>
 #include <map>
 #include <set>
 #include <memory>
@@ -32,11 +34,21 @@ struct StaticExpansionStatistics {
     size_t target_vertices_at_max_time = 0;
     size_t attractor_vertices = 0;
     size_t vertices_winning_at_time_0 = 0;
+    size_t attractor_threads = 0;      // 0 when GGG's sequential attractor was used
+    size_t attractor_levels = 0;
     
     // Timing
     std::chrono::duration<double> total_solve_time{0};
     std::chrono::duration<double> expansion_time{0};
+    std::chrono::duration<double> target_set_time{0};
     std::chrono::duration<double> attractor_time{0};
+    std::chrono::duration<double> solution_time{0};
+    
+    // Memory (estimated bytes)
+    size_t expanded_graph_bytes = 0;
+    size_t expansion_map_bytes = 0;
+    size_t attractor_bytes = 0;
+    size_t solution_bytes = 0;
     
     void reset() {
         original_vertices = original_edges = 0;
@@ -44,7 +56,35 @@ struct StaticExpansionStatistics {
         time_layers = 0;
         constraint_evaluations = constraint_passes = constraint_failures = 0;
         target_vertices_at_max_time = attractor_vertices = vertices_winning_at_time_0 = 0;
-        total_solve_time = expansion_time = attractor_time = std::chrono::duration<double>{0};
+        attractor_threads = attractor_levels = 0;
+        expanded_graph_bytes = expansion_map_bytes = attractor_bytes = solution_bytes = 0;
+        total_solve_time = expansion_time = target_set_time = attractor_time = solution_time = std::chrono::duration<double>{0};
+    }
+    
+    // Add the statistics of a separately solved part of the game (times are summed)
+    void accumulate(const StaticExpansionStatistics& other) {
+        original_vertices += other.original_vertices;
+        original_edges += other.original_edges;
+        expanded_vertices += other.expanded_vertices;
+        expanded_edges += other.expanded_edges;
+        time_layers = std::max(time_layers, other.time_layers);
+        constraint_evaluations += other.constraint_evaluations;
+        constraint_passes += other.constraint_passes;
+        constraint_failures += other.constraint_failures;
+        target_vertices_at_max_time += other.target_vertices_at_max_time;
+        attractor_vertices += other.attractor_vertices;
+        vertices_winning_at_time_0 += other.vertices_winning_at_time_0;
+        attractor_threads = std::max(attractor_threads, other.attractor_threads);
+        attractor_levels = std::max(attractor_levels, other.attractor_levels);
+        total_solve_time += other.total_solve_time;
+        expansion_time += other.expansion_time;
+        target_set_time += other.target_set_time;
+        attractor_time += other.attractor_time;
+        solution_time += other.solution_time;
+        expanded_graph_bytes += other.expanded_graph_bytes;
+        expansion_map_bytes += other.expansion_map_bytes;
+        attractor_bytes += other.attractor_bytes;
+        solution_bytes += other.solution_bytes;
     }
 };
 
@@ -55,7 +95,7 @@ struct StaticExpansionStatistics {
  * 1. Performs a STATIC EXPANSION of the temporal graph into a conventional graph
  * 2. Creates vertices for each (original_vertex, time) pair from 0 to max_time
  * 3. Adds edges between time layers based on temporal constraints
- * 4. Uses GGG's attractor computation on the expanded graph
+ * 4. Uses GGG's attractor computation on the expanded graph (or ParallelAttractor, with the same result)
  * 5. Extracts solution by checking which vertices at time 0 are in the attractor
  */
 class StaticExpansionSolver : public Solver<graphs::GGGTemporalGraph, solutions::RSSolution<graphs::GGGTemporalGraph>> {
@@ -73,6 +113,7 @@ private:
     std::shared_ptr<graphs::GGGReachabilityObjective> objective_;
     int max_time_;
     bool verbose_;
+    int attractor_threads_ = 1;
     
     // Performance statistics
     mutable StaticExpansionStatistics stats_;
@@ -108,6 +149,12 @@ public:
      * @brief Reset solver statistics
      */
     void reset_statistics() { stats_.reset(); }
+    
+    /**
+     * @brief Threads for the attractor on the expanded graph
+     * @param threads 1 uses GGG's sequential attractor, otherwise ParallelAttractor (0: all hardware threads)
+     */
+    void set_attractor_threads(int threads) { attractor_threads_ = threads; }
 
 private:
     /**
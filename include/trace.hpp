@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace trace {
+
+/**
+ * @brief Single complete ("X") event in Chrome trace format
+ */
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    int64_t start_ns;
+    int64_t duration_ns;
+    std::vector<std::pair<const char*, int64_t>> args;
+};
+
+/**
+ * @brief Process-wide collector of timeline events
+ *
+ * Events are buffered per thread and written as Chrome trace / Perfetto JSON
+ * by write(). While disabled, recording costs a single relaxed atomic load.
+ * Event names and argument keys must be string literals.
+ */
+class Tracer {
+private:
+    struct ThreadBuffer {
+        int thread_id;
+        std::string thread_name;
+        std::vector<TraceEvent> events;
+    };
+
+    std::atomic<bool> enabled_{false};
+    std::string output_file_;
+    std::chrono::steady_clock::time_point origin_;
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+    Tracer() = default;
+    ThreadBuffer& thread_buffer();
+
+public:
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Enable tracing; events are written to output_file by write()
+     */
+    void start(const std::string& output_file);
+
+    /**
+     * @brief Write all buffered events and disable tracing
+     * @return false if the output file could not be written
+     */
+    bool write();
+
+    /**
+     * @brief Name the calling thread in the trace viewer
+     */
+    void set_thread_name(const std::string& name);
+
+    /**
+     * @brief Nanoseconds since tracing started
+     */
+    int64_t now_ns() const;
+
+    void record(TraceEvent event);
+};
+
+/**
+ * @brief RAII scope that records a complete event when tracing is enabled
+ */
+class ScopedTrace {
+private:
+    bool active_;
+    TraceEvent event_;
+
+public:
+    explicit ScopedTrace(const char* name, const char* category = "solver")
+        : active_(Tracer::instance().enabled()), event_{name, category, 0, 0, {}} {
+        if (active_) {
+            event_.start_ns = Tracer::instance().now_ns();
+        }
+    }
+
+    ~ScopedTrace() {
+        if (active_) {
+            event_.duration_ns = Tracer::instance().now_ns() - event_.start_ns;
+            Tracer::instance().record(std::move(event_));
+        }
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+    /**
+     * @brief Attach an integer argument shown in the event details
+     */
+    void arg(const char* key, int64_t value) {
+        if (active_) {
+            event_.args.emplace_back(key, value);
+        }
+    }
+};
+
+} // namespace trace
+} // namespace ggg
+
+#define TEMPORIS_TRACE_CONCAT_INNER(a, b) a##b
+#define TEMPORIS_TRACE_CONCAT(a, b) TEMPORIS_TRACE_CONCAT_INNER(a, b)
+
+#ifdef TEMPORIS_DISABLE_TRACING
+#define TEMPORIS_TRACE_SCOPE(name) ((void)0)
+#define TEMPORIS_TRACE_SCOPE_VAR(var, name) ((void)0)
+#define TEMPORIS_TRACE_ARG(var, key, value) ((void)0)
+#else
+// Trace the enclosing scope under the given name
+#define TEMPORIS_TRACE_SCOPE(name) \
+    ::ggg::trace::ScopedTrace TEMPORIS_TRACE_CONCAT(temporis_trace_scope_, __LINE__)(name)
+// Trace the enclosing scope through a named variable so arguments can be attached
+#define TEMPORIS_TRACE_SCOPE_VAR(var, name) ::ggg::trace::ScopedTrace var(name)
+#define TEMPORIS_TRACE_ARG(var, key, value) (var).arg(key, static_cast<int64_t>(value))
+#endif
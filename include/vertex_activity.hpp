@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ggg_temporal_graph.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+/**
+ * @brief Half-open range of time steps [begin, end)
+ */
+struct TimeWindow {
+    int begin = 0;
+    int end = 0;
+};
+
+/**
+ * @brief Times in [0, horizon) at which formula can hold, as sorted disjoint non-adjacent windows
+ *
+ * Comparisons linear in time are solved exactly, existential variables are
+ * enumerated over the interpreter's range, and conjunctions, disjunctions and
+ * negations of exact sets stay exact. A modulus constraint on time is
+ * over-approximated by the whole horizon, so the result is always a superset
+ * of the satisfying times; exact (if given) tells whether it is the set itself.
+ */
+std::vector<TimeWindow> formula_time_windows(const graphs::PresburgerFormula& formula, int horizon,
+                                             bool* exact = nullptr);
+
+/**
+ * @brief Size and construction cost of a VertexActivityIndex
+ */
+struct ActivityStatistics {
+    size_t windows = 0;               // activity windows over all vertices
+    size_t inexact_constraints = 0;   // constraints over-approximated by their analysis
+    uint64_t active_vertex_layers = 0;
+    uint64_t vertex_layers = 0;       // vertices times horizon
+    std::chrono::duration<double> build_time{0};
+
+    double coverage() const {
+        return vertex_layers > 0 ? static_cast<double>(active_vertex_layers) / static_cast<double>(vertex_layers) : 1.0;
+    }
+};
+
+/**
+ * @brief Per-vertex union of the times at which any out-edge can be enabled
+ *
+ * A vertex without an enabled move never joins an attractor layer, so the
+ * layer kernel only has to visit the vertices active at its time. The
+ * windows come from formula_time_windows() on every edge constraint
+ * (unconstrained edges are always enabled), and are stored once per game
+ * and horizon as vertex enter and leave events in the order of the
+ * backwards sweep. A Cursor replays the events layer by layer, so each step
+ * costs the active vertices plus the events at that time.
+ */
+class VertexActivityIndex {
+public:
+    // Above this coverage the index saves too little to pay for its cursor
+    static constexpr double kMaxUsefulCoverage = 0.9;
+
+    /**
+     * @brief Sorted vertices active at a time; stepping down one layer replays the events in between
+     */
+    class Cursor {
+    private:
+        const VertexActivityIndex* index_;
+        int time_ = -1;
+        size_t next_event_ = 0;   // first event below time_
+        std::vector<uint32_t> active_;
+        std::vector<uint32_t> scratch_;
+
+        void rebuild(int time);
+
+    public:
+        explicit Cursor(const VertexActivityIndex& index) : index_(&index) {}
+
+        const std::vector<uint32_t>& at(int time);
+    };
+
+private:
+    struct Event {
+        int time;        // first time (going down) at which the change applies
+        bool enter;      // leaves sort before enters at the same time
+        uint32_t vertex;
+    };
+
+    int horizon_ = 0;
+    std::vector<size_t> window_offsets_;   // per vertex into windows_, plus one
+    std::vector<TimeWindow> windows_;
+    std::vector<Event> events_;            // by descending time, leaves first, then by vertex
+    ActivityStatistics stats_;
+
+public:
+    /**
+     * @brief Index of every vertex of the manager's graph over [0, horizon)
+     *
+     * Parses every constraint that is still deferred by a lazy load.
+     */
+    static std::shared_ptr<const VertexActivityIndex> build(const graphs::GGGTemporalGameManager& manager,
+                                                            int horizon);
+
+    int horizon() const { return horizon_; }
+
+    bool worthwhile() const { return stats_.coverage() <= kMaxUsefulCoverage; }
+
+    const ActivityStatistics& get_statistics() const { return stats_; }
+
+    bool is_active(uint32_t vertex, int time) const;
+};
+
+} // namespace solvers
+} // namespace ggg
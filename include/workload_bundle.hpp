@@ -0,0 +1,61 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ggg {
+namespace stats {
+
+/**
+ * @brief One captured solver run: the exact input bytes, the options and the resulting statistics
+ *
+ * Written by temporis --capture and re-executed by temporis_replay;
+ * temporis_bench and temporis_perfcheck accept bundles as corpus games. The
+ * file is self-contained text: "key value" header lines, then
+ * length-prefixed sections for each option, the --stats-json document and
+ * the input, so any input round-trips byte for byte.
+ */
+struct WorkloadBundle {
+    static constexpr int kVersion = 1;
+    static constexpr const char* kExtension = ".tbundle";
+
+    std::string name;                    // file stem of the bundle
+    std::string source;                  // input file name, or "stdin"
+    std::string host;
+    std::string captured_at;             // UTC, ISO 8601
+    int time_bound = 0;                  // effective time bound of the captured solve
+    std::vector<std::string> arguments;  // options, without the input file, --capture and --stats-json
+    std::string statistics;              // --stats-json document of the captured run
+    std::string input;                   // input bytes as read
+
+    /**
+     * @brief Bundle of this host at the current time; the caller fills in the run
+     */
+    static WorkloadBundle capture(const std::string& path);
+
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Read a bundle; nullopt with error set if it is missing or malformed
+     */
+    static std::optional<WorkloadBundle> load(const std::string& path, std::string& error);
+
+    /**
+     * @brief Bundle files among paths, expanding directories to their *.tbundle files (sorted)
+     */
+    static std::vector<std::string> collect(const std::vector<std::string>& paths);
+};
+
+/**
+ * @brief Numbers of a JSON document as "path/key" entries; array elements are keyed by index
+ *
+ * Enough for --stats-json documents and the temporis_perfcheck baseline:
+ * strings, booleans and null are skipped.
+ * Throws std::runtime_error on malformed input.
+ */
+std::map<std::string, double> flatten_json_numbers(const std::string& json);
+
+} // namespace stats
+} // namespace ggg
@@ -0,0 +1,333 @@
+#include "autotune.hpp"
+#include "component_solver.hpp"
+#include "game_generator.hpp"
+#include "ggg_temporal_solver.hpp"
+#include "layer_set.hpp"
+#include "run_statistics.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+std::string cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.starts_with("model name")) {
+            size_t colon = line.find(':');
+            size_t start = colon == std::string::npos ? std::string::npos : line.find_first_not_of(' ', colon + 1);
+            if (start != std::string::npos) {
+                return line.substr(start);
+            }
+        }
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Generated game, or several disjoint ones joined into one game
+ */
+struct CalibrationGame {
+    std::shared_ptr<graphs::GGGTemporalGameManager> manager;
+    std::shared_ptr<graphs::GGGReachabilityObjective> objective;
+    int time_bound = 0;
+};
+
+CalibrationGame generate_game(size_t parts, size_t vertices_per_part, int time_bound, uint64_t seed) {
+    CalibrationGame game;
+    game.manager = std::make_shared<graphs::GGGTemporalGameManager>();
+    game.time_bound = time_bound;
+    auto& graph = *game.manager->graph();
+
+    for (size_t part_index = 0; part_index < parts; ++part_index) {
+        graphs::GameGeneratorOptions options;
+        options.vertices = vertices_per_part;
+        options.edges = vertices_per_part * 4;
+        options.player1_ratio = 0.3;
+        options.target_density = 0.05;
+        options.time_bound = time_bound;
+        options.unconstrained_weight = 2.0;
+        options.seed = seed + part_index;
+        graphs::GGGTemporalGameManager part;
+        part.load_from_dot_string(graphs::GameGenerator(options).generate_dot());
+
+        const auto& part_graph = *part.graph();
+        size_t offset = boost::num_vertices(graph);
+        // Appended in steps; "p" + std::to_string(...) trips GCC 12's -Wrestrict
+        std::string prefix = "p";
+        prefix += std::to_string(part_index);
+        prefix += '_';
+        auto [vertex_begin, vertex_end] = boost::vertices(part_graph);
+        for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+            const auto& vertex = part_graph[*vertex_it];
+            game.manager->add_vertex(prefix + vertex.name, vertex.player, vertex.target);
+        }
+        auto [edge_begin, edge_end] = boost::edges(part_graph);
+        for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+            auto edge = game.manager->add_edge(offset + boost::source(*edge_it, part_graph),
+                                               offset + boost::target(*edge_it, part_graph), part_graph[*edge_it].label);
+            game.manager->copy_edge_constraint(edge.first, part, *edge_it);
+        }
+    }
+    game.objective = std::make_shared<graphs::GGGReachabilityObjective>(
+        graphs::GGGReachabilityObjective::Type::REACHABILITY, game.manager->get_target_vertices());
+    return game;
+}
+
+void solve_whole(const CalibrationGame& game, size_t dense_ratio) {
+    GGGTemporalReachabilitySolver solver(game.manager, game.objective, game.time_bound, false);
+    solver.set_layer_dense_ratio(dense_ratio);
+    solver.solve(*game.manager->graph());
+}
+
+void solve_decomposed(const CalibrationGame& game, int threads, size_t batch_vertices, size_t dense_ratio) {
+    ComponentSolver components(game.manager, game.objective, threads, batch_vertices);
+    components.solve([&](const SubGame& sub, std::string& engine) {
+        GGGTemporalReachabilitySolver part(sub.manager, sub.objective, game.time_bound, false);
+        part.set_layer_dense_ratio(dense_ratio);
+        engine = "backwards";
+        return part.solve(*sub.manager->graph());
+    });
+}
+
+// First candidate within gain of the fastest, so ties go to the earlier (preferred) candidates
+template<typename T>
+T pick(const std::vector<T>& candidates, const std::vector<double>& seconds, double gain) {
+    double best = *std::min_element(seconds.begin(), seconds.end());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (seconds[i] <= best * (1.0 + gain)) {
+            return candidates[i];
+        }
+    }
+    return candidates.front();
+}
+
+} // namespace
+
+std::string TuningProfile::default_path() {
+    if (const char* path = std::getenv("TEMPORIS_PROFILE"); path && *path) {
+        return path;
+    }
+    std::string file = "temporis/" + stats::host_name() + ".profile";
+    if (const char* dir = std::getenv("XDG_CONFIG_HOME"); dir && *dir) {
+        return std::string(dir) + "/" + file;
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::string(home) + "/.config/" + file;
+    }
+    return "";
+}
+
+TuningProfile TuningProfile::for_this_host() {
+    TuningProfile profile;
+    profile.host = stats::host_name();
+    profile.cpu = cpu_model();
+    profile.hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    profile.tuned_at = stats::utc_timestamp();
+    return profile;
+}
+
+std::optional<TuningProfile> TuningProfile::load(const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return std::nullopt;
+    }
+    TuningProfile profile;
+    int version = 0;
+    std::string line;
+    size_t line_number = 0;
+    try {
+        while (std::getline(in, line)) {
+            ++line_number;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            size_t space = line.find(' ');
+            std::string key = line.substr(0, space);
+            std::string value = space == std::string::npos ? "" : line.substr(space + 1);
+            if (key == "version") {
+                version = std::stoi(value);
+            } else if (key == "host") {
+                profile.host = value;
+            } else if (key == "cpu") {
+                profile.cpu = value;
+            } else if (key == "hardware_threads") {
+                profile.hardware_threads = static_cast<unsigned>(std::stoul(value));
+            } else if (key == "tuned_at") {
+                profile.tuned_at = value;
+            } else if (key == "threads") {
+                profile.threads = std::max(0, std::stoi(value));
+            } else if (key == "component_batch_vertices") {
+                profile.component_batch_vertices = std::stoul(value);
+            } else if (key == "layer_dense_ratio") {
+                profile.layer_dense_ratio = std::stoul(value);
+            } else if (key == "decompose_min_components") {
+                profile.decompose_min_components = std::stoul(value);
+            }
+            // Keys of newer versions are ignored
+        }
+    } catch (const std::exception&) {
+        error = path + ":" + std::to_string(line_number) + ": invalid value";
+        return std::nullopt;
+    }
+    if (version != kVersion) {
+        error = path + ": unsupported profile version " + std::to_string(version);
+        return std::nullopt;
+    }
+    return profile;
+}
+
+bool TuningProfile::save(const std::string& path) const {
+    std::error_code error;
+    auto directory = std::filesystem::path(path).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, error);
+    }
+    std::ofstream out(path);
+    out << "# temporis tuning profile, written by temporis --autotune\n";
+    out << "version " << kVersion << "\n";
+    out << "host " << host << "\n";
+    out << "cpu " << cpu << "\n";
+    out << "hardware_threads " << hardware_threads << "\n";
+    out << "tuned_at " << tuned_at << "\n";
+    out << "threads " << threads << "\n";
+    out << "component_batch_vertices " << component_batch_vertices << "\n";
+    out << "layer_dense_ratio " << layer_dense_ratio << "\n";
+    out << "decompose_min_components " << decompose_min_components << "\n";
+    return static_cast<bool>(out);
+}
+
+bool TuningProfile::matches_this_host(std::string& reason) const {
+    TuningProfile here = for_this_host();
+    if (cpu != here.cpu || hardware_threads != here.hardware_threads) {
+        reason = "tuned on " + cpu + " with " + std::to_string(hardware_threads) + " threads, this host has " +
+                 here.cpu + " with " + std::to_string(here.hardware_threads);
+        return false;
+    }
+    return true;
+}
+
+std::string TuningProfile::summary() const {
+    std::ostringstream out;
+    out << "threads " << threads << ", component_batch_vertices " << component_batch_vertices
+        << ", layer_dense_ratio " << layer_dense_ratio << ", decompose_min_components " << decompose_min_components;
+    return out.str();
+}
+
+Autotuner::Autotuner(int max_threads, int repeats)
+    : max_threads_(max_threads), repeats_(std::max(1, repeats)) {
+    if (max_threads_ <= 0) {
+        max_threads_ = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+template<typename Solve>
+double Autotuner::median_seconds(Solve&& solve) const {
+    std::vector<double> seconds;
+    for (int run = 0; run < repeats_; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        solve();
+        seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(seconds.begin(), seconds.end());
+    return seconds[seconds.size() / 2];
+}
+
+TuningProfile Autotuner::tune(std::ostream& out) {
+    TEMPORIS_TRACE_SCOPE("autotune");
+    TuningProfile profile = TuningProfile::for_this_host();
+    out << "\n=== Autotune ===\n";
+    out << "Host: " << profile.host << " (" << profile.cpu << ", " << profile.hardware_threads
+        << " hardware threads)\n";
+    out << std::fixed << std::setprecision(4);
+
+    auto report = [&](const char* name, const auto& candidates, const std::vector<double>& seconds, auto chosen) {
+        out << name << ":";
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            out << "  " << candidates[i] << ": " << seconds[i] << "s";
+        }
+        out << "  -> " << chosen << "\n";
+    };
+
+    // Layer representation on one large game with Player 1 choices (no fast path)
+    {
+        // The default first, so that it wins ties
+        std::vector<size_t> candidates = {LayerSet::kDefaultDenseRatio, 8, 16, 64, 128};
+        CalibrationGame game = generate_game(1, 12000, 40, 101);
+        std::vector<double> seconds;
+        for (size_t ratio : candidates) {
+            seconds.push_back(median_seconds([&] { solve_whole(game, ratio); }));
+        }
+        profile.layer_dense_ratio = pick(candidates, seconds, kMinGain);
+        report("layer_dense_ratio", candidates, seconds, profile.layer_dense_ratio);
+    }
+
+    // Worker threads on a game of equal components, fewest threads on ties
+    {
+        std::vector<int> candidates;
+        for (int threads = 1; threads < max_threads_; threads *= 2) {
+            candidates.push_back(threads);
+        }
+        candidates.push_back(max_threads_);
+        CalibrationGame game = generate_game(16, 1000, 30, 201);
+        std::vector<double> seconds;
+        for (int threads : candidates) {
+            seconds.push_back(median_seconds([&] {
+                solve_decomposed(game, threads, ComponentSolver::kDefaultBatchVertices, profile.layer_dense_ratio);
+            }));
+        }
+        profile.threads = pick(candidates, seconds, kMinGain);
+        report("threads", candidates, seconds, profile.threads);
+    }
+
+    // Batch size on many tiny components
+    {
+        std::vector<size_t> candidates = {ComponentSolver::kDefaultBatchVertices, 32, 64, 1024, 4096};
+        CalibrationGame game = generate_game(2000, 8, 30, 301);
+        std::vector<double> seconds;
+        for (size_t batch : candidates) {
+            seconds.push_back(median_seconds([&] {
+                solve_decomposed(game, profile.threads, batch, profile.layer_dense_ratio);
+            }));
+        }
+        profile.component_batch_vertices = pick(candidates, seconds, kMinGain);
+        report("component_batch_vertices", candidates, seconds, profile.component_batch_vertices);
+    }
+
+    // Smallest component count from which decomposing always wins, at a fixed total size
+    {
+        std::vector<size_t> counts = {2, 4, 8, 16, 32, 64};
+        size_t total = 16000;
+        std::vector<bool> wins;
+        out << "decompose_min_components:";
+        for (size_t count : counts) {
+            CalibrationGame game = generate_game(count, total / count, 30, 401);
+            double whole = median_seconds([&] { solve_whole(game, profile.layer_dense_ratio); });
+            double decomposed = median_seconds([&] {
+                solve_decomposed(game, profile.threads, profile.component_batch_vertices, profile.layer_dense_ratio);
+            });
+            wins.push_back(decomposed < whole * (1.0 - kMinGain));
+            out << "  " << count << ": " << whole << "s/" << decomposed << "s";
+        }
+        profile.decompose_min_components = 0;
+        for (size_t i = counts.size(); i-- > 0 && wins[i];) {
+            profile.decompose_min_components = counts[i];
+        }
+        out << "  -> " << profile.decompose_min_components
+            << (profile.decompose_min_components == 0 ? " (never)" : "") << "\n";
+    }
+    return profile;
+}
+
+} // namespace solvers
+} // namespace ggg
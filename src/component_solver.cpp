@@ -0,0 +1,254 @@
+#include "component_solver.hpp"
+#include "perf_counters.hpp"
+#include "trace.hpp"
+#include <boost/graph/graph_traits.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+
+namespace ggg {
+namespace solvers {
+
+ComponentSolver::ComponentSolver(std::shared_ptr<graphs::GGGTemporalGameManager> manager,
+                                 std::shared_ptr<graphs::GGGReachabilityObjective> objective,
+                                 int threads, size_t batch_vertices)
+    : manager_(manager), objective_(objective), threads_(threads), batch_vertices_(batch_vertices) {
+    if (threads_ <= 0) {
+        threads_ = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+std::vector<std::vector<ComponentSolver::Vertex>> ComponentSolver::weakly_connected_components(
+    const GraphType& graph) {
+    auto index = boost::get(boost::vertex_index, graph);
+    size_t vertex_count = boost::num_vertices(graph);
+
+    // Union-find with path halving and union by size
+    std::vector<size_t> parent(vertex_count);
+    std::vector<size_t> size(vertex_count, 1);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](size_t v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+
+    auto [edge_begin, edge_end] = boost::edges(graph);
+    for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+        size_t a = find(index[boost::source(*edge_it, graph)]);
+        size_t b = find(index[boost::target(*edge_it, graph)]);
+        if (a != b) {
+            if (size[a] < size[b]) std::swap(a, b);
+            parent[b] = a;
+            size[a] += size[b];
+        }
+    }
+
+    std::vector<size_t> component_of_root(vertex_count, SIZE_MAX);
+    std::vector<std::vector<Vertex>> components;
+    auto [vertex_begin, vertex_end] = boost::vertices(graph);
+    for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+        size_t root = find(index[*vertex_it]);
+        if (component_of_root[root] == SIZE_MAX) {
+            component_of_root[root] = components.size();
+            components.emplace_back();
+        }
+        components[component_of_root[root]].push_back(*vertex_it);
+    }
+    return components;
+}
+
+SubGame ComponentSolver::extract(const graphs::GGGTemporalGameManager& manager,
+                                 const graphs::GGGReachabilityObjective& objective,
+                                 const std::vector<Vertex>& vertices, size_t components) {
+    const auto& graph = *manager.graph();
+    auto index = boost::get(boost::vertex_index, graph);
+
+    SubGame sub;
+    sub.manager = std::make_shared<graphs::GGGTemporalGameManager>();
+    sub.parent_vertices = vertices;
+    sub.components = components;
+
+    // Parent vertex index -> sub-game vertex; only entries of this item are touched
+    std::map<size_t, Vertex> local;
+    std::set<Vertex> targets;
+    for (auto vertex : vertices) {
+        const auto& props = graph[vertex];
+        Vertex copy = sub.manager->add_vertex(props.name, props.player, props.target);
+        local[index[vertex]] = copy;
+        if (objective.is_target(vertex)) {
+            targets.insert(copy);
+        }
+        if (auto constraint = manager.target_constraint(vertex)) {
+            sub.manager->add_target_constraint(copy, std::move(constraint));
+        }
+    }
+
+    // The vertices are closed under out-edges, so every out-edge stays inside the sub-game
+    for (auto vertex : vertices) {
+        auto [edge_begin, edge_end] = boost::out_edges(vertex, graph);
+        for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+            auto edge = sub.manager->add_edge(local[index[vertex]], local[index[boost::target(*edge_it, graph)]],
+                                              graph[*edge_it].label);
+            sub.manager->copy_edge_constraint(edge.first, manager, *edge_it);
+            ++sub.edges;
+        }
+    }
+
+    sub.objective = std::make_shared<graphs::GGGReachabilityObjective>(objective.get_type(), targets);
+    return sub;
+}
+
+std::string ComponentSolver::get_name(const std::string& engine_solver) {
+    return "Component Decomposition Solver (" + engine_solver + ")";
+}
+
+ComponentSolver::SolutionType ComponentSolver::solve(const ComponentEngine& engine) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "component_solve");
+    stats_ = ComponentStatistics{};
+    const auto& graph = *manager_->graph();
+
+    // Decompose and pack small components into batches
+    auto decomposition_start = std::chrono::steady_clock::now();
+    auto components = weakly_connected_components(graph);
+    std::stable_sort(components.begin(), components.end(),
+                     [](const auto& a, const auto& b) { return a.size() > b.size(); });
+    stats_.components = components.size();
+
+    struct WorkItem {
+        std::vector<Vertex> vertices;
+        size_t components = 0;
+    };
+    std::vector<WorkItem> items;
+    WorkItem batch;
+    for (auto& component : components) {
+        if (component.size() >= batch_vertices_) {
+            items.push_back({std::move(component), 1});
+            continue;
+        }
+        batch.vertices.insert(batch.vertices.end(), component.begin(), component.end());
+        batch.components++;
+        stats_.batched_components++;
+        if (batch.vertices.size() >= batch_vertices_) {
+            items.push_back(std::move(batch));
+            batch = WorkItem{};
+        }
+    }
+    if (!batch.vertices.empty()) {
+        items.push_back(std::move(batch));
+    }
+    stats_.decomposition_time = std::chrono::steady_clock::now() - decomposition_start;
+
+    // Workers take items in order, so the largest items start first
+    size_t worker_count = std::min(items.size(), static_cast<size_t>(threads_));
+    stats_.threads = worker_count;
+    std::vector<SolutionType> results(items.size());
+    std::vector<std::vector<Vertex>> parents(items.size());
+    stats_.work_items.resize(items.size());
+    std::atomic<size_t> next_item{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    auto work = [&](int worker) {
+        if (worker_count > 1 && trace::Tracer::instance().enabled()) {
+            trace::Tracer::instance().set_thread_name("component worker " + std::to_string(worker));
+        }
+        for (size_t item = next_item++; item < items.size(); item = next_item++) {
+            try {
+                TEMPORIS_TRACE_SCOPE_VAR(item_scope, "component");
+                auto item_start = std::chrono::steady_clock::now();
+                SubGame sub = extract(*manager_, *objective_, items[item].vertices, items[item].components);
+                ComponentTiming& timing = stats_.work_items[item];
+                results[item] = engine(sub, timing.engine);
+                timing.solve_time = std::chrono::steady_clock::now() - item_start;
+                timing.components = sub.components;
+                timing.vertices = sub.parent_vertices.size();
+                timing.edges = sub.edges;
+                timing.worker = worker;
+                parents[item] = std::move(sub.parent_vertices);
+                TEMPORIS_TRACE_ARG(item_scope, "vertices", timing.vertices);
+                TEMPORIS_TRACE_ARG(item_scope, "components", timing.components);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                next_item = items.size();
+            }
+        }
+    };
+
+    auto solve_start = std::chrono::steady_clock::now();
+    if (worker_count <= 1) {
+        work(0);
+    } else {
+        perf::ScopedWorkerPool running_pool;
+        std::vector<std::thread> workers;
+        for (size_t worker = 0; worker < worker_count; ++worker) {
+            workers.emplace_back(work, static_cast<int>(worker));
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+    stats_.solve_time = std::chrono::steady_clock::now() - solve_start;
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    // Sub-game vertex i is parent_vertices[i]
+    auto merge_start = std::chrono::steady_clock::now();
+    SolutionType solution;
+    for (size_t item = 0; item < items.size(); ++item) {
+        const auto& parent_of = parents[item];
+        for (size_t local = 0; local < parent_of.size(); ++local) {
+            Vertex vertex = parent_of[local];
+            solution.set_winning_player(vertex, results[item].get_winning_player(local));
+            if (results[item].has_strategy(local)) {
+                solution.set_strategy(vertex, parent_of[results[item].get_strategy(local)]);
+            }
+        }
+    }
+    stats_.merge_time = std::chrono::steady_clock::now() - merge_start;
+    TEMPORIS_TRACE_ARG(trace_scope, "components", stats_.components);
+    TEMPORIS_TRACE_ARG(trace_scope, "work_items", items.size());
+    TEMPORIS_TRACE_ARG(trace_scope, "threads", worker_count);
+    return solution;
+}
+
+void ComponentSolver::write_report(std::ostream& out, size_t max_items) const {
+    out << "\n=== Component Decomposition ===\n";
+    out << "Components: " << stats_.components << " (" << stats_.batched_components
+        << " small ones batched), " << stats_.work_items.size() << " work items on "
+        << stats_.threads << " threads\n";
+    out << std::fixed << std::setprecision(6);
+    out << "Decomposition: " << stats_.decomposition_time.count() << "s, solve: "
+        << stats_.solve_time.count() << "s, merge: " << stats_.merge_time.count() << "s\n";
+
+    std::vector<const ComponentTiming*> slowest;
+    for (const auto& item : stats_.work_items) {
+        slowest.push_back(&item);
+    }
+    std::sort(slowest.begin(), slowest.end(),
+              [](const auto* a, const auto* b) { return a->solve_time > b->solve_time; });
+    if (slowest.size() > max_items) {
+        slowest.resize(max_items);
+    }
+    out << "Slowest work items:\n";
+    for (const auto* item : slowest) {
+        out << "  " << std::setw(10) << item->solve_time.count() << "s  " << item->vertices << " vertices, "
+            << item->edges << " edges, " << item->components << " component(s), " << item->engine
+            << ", worker " << item->worker << "\n";
+    }
+}
+
+} // namespace solvers
+} // namespace ggg
@@ -0,0 +1,450 @@
+#include "constraint_codegen.hpp"
+#include "trace.hpp"
+#include <boost/graph/graph_traits.hpp>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#ifndef TEMPORIS_CODEGEN_COMPILER
+#define TEMPORIS_CODEGEN_COMPILER "c++"
+#endif
+
+namespace ggg {
+namespace codegen {
+
+namespace {
+
+// Formula variable -> C++ variable in the generated code
+using Scope = std::map<std::string, std::string>;
+
+// Bump when the generated code or its interface changes, so stale objects are not reused
+constexpr const char* kCodegenVersion = "temporis-codegen-1";
+
+std::string int_literal(int value) {
+    if (value == INT_MIN) {
+        return "(-2147483647 - 1)";
+    }
+    if (value >= 0) {
+        return std::to_string(value);
+    }
+    // Appended in steps; "(" + std::to_string(...) trips GCC 12's -Wrestrict
+    std::string literal = "(";
+    literal += std::to_string(value);
+    literal += ')';
+    return literal;
+}
+
+// Terms wrap like the interpreter's int arithmetic, without signed overflow
+void write_term(std::ostream& out, const graphs::PresburgerTerm& term, const Scope& scope) {
+    std::vector<std::pair<int, std::string>> products;
+    for (const auto& [var, coefficient] : term.coefficients_) {
+        auto it = scope.find(var);
+        if (it != scope.end() && coefficient != 0) {
+            products.emplace_back(coefficient, it->second);
+        }
+    }
+    if (products.empty()) {
+        out << int_literal(term.constant_);
+        return;
+    }
+    if (products.size() == 1 && term.constant_ == 0 && products[0].first == 1) {
+        out << products[0].second;
+        return;
+    }
+    out << "int(unsigned(" << int_literal(term.constant_) << ")";
+    for (const auto& [coefficient, name] : products) {
+        out << " + unsigned(" << int_literal(coefficient) << ") * unsigned(" << name << ")";
+    }
+    out << ")";
+}
+
+void write_formula(std::ostream& out, const graphs::PresburgerFormula& formula, const Scope& scope, int depth) {
+    using Formula = graphs::PresburgerFormula;
+    const char* comparison = nullptr;
+    switch (formula.type()) {
+        case Formula::EQUAL: comparison = " == "; break;
+        case Formula::GREATEREQUAL: comparison = " >= "; break;
+        case Formula::LESSEQUAL: comparison = " <= "; break;
+        case Formula::GREATER: comparison = " > "; break;
+        case Formula::LESS: comparison = " < "; break;
+        case Formula::MODULUS:
+            out << "(";
+            write_term(out, formula.left(), scope);
+            out << " % " << int_literal(formula.modulus_value()) << " == "
+                << int_literal(formula.remainder_value()) << ")";
+            return;
+        case Formula::AND:
+        case Formula::OR: {
+            bool conjunction = formula.type() == Formula::AND;
+            if (formula.children().empty()) {
+                out << (conjunction ? "true" : "false");
+                return;
+            }
+            out << "(";
+            for (size_t i = 0; i < formula.children().size(); ++i) {
+                if (i > 0) {
+                    out << (conjunction ? " && " : " || ");
+                }
+                write_formula(out, *formula.children()[i], scope, depth);
+            }
+            out << ")";
+            return;
+        }
+        case Formula::NOT:
+            if (formula.children().empty()) {
+                out << "false";
+                return;
+            }
+            out << "!";
+            write_formula(out, *formula.children()[0], scope, depth);
+            return;
+        case Formula::EXISTS: {
+            if (formula.children().empty()) {
+                out << "false";
+                return;
+            }
+            // Same bounded witness search as the interpreter; names are unique per nesting depth
+            std::string name = "x";
+            name += std::to_string(depth);
+            Scope inner = scope;
+            inner[formula.existential_var()] = name;
+            out << "[&]() -> bool { for (int " << name << " = -10; " << name << " <= 10; ++" << name
+                << ") { if (";
+            write_formula(out, *formula.children()[0], inner, depth + 1);
+            out << ") return true; } return false; }()";
+            return;
+        }
+        default:
+            out << "true";
+            return;
+    }
+    out << "(";
+    write_term(out, formula.left(), scope);
+    out << comparison;
+    write_term(out, formula.right(), scope);
+    out << ")";
+}
+
+uint64_t fnv1a(const std::string& data) {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string shell_quote(const std::string& value) {
+    std::string quoted = "'";
+    for (char c : value) {
+        if (c == '\'') {
+            quoted += "'\\''";
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "'";
+}
+
+std::string default_cache_dir() {
+    if (const char* dir = std::getenv("TEMPORIS_CODEGEN_CACHE"); dir && *dir) {
+        return dir;
+    }
+    if (const char* dir = std::getenv("XDG_CACHE_HOME"); dir && *dir) {
+        return std::string(dir) + "/temporis";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::string(home) + "/.cache/temporis";
+    }
+    // Per-user name: the temporary directory is shared and the cached objects get dlopen()ed
+    return (std::filesystem::temp_directory_path() / ("temporis-codegen-" + std::to_string(geteuid()))).string();
+}
+
+/**
+ * @brief Why objects in dir must not be loaded, or empty if only the current user can write there
+ */
+std::string unsafe_cache_dir(const std::string& dir) {
+    struct stat info;
+    if (stat(dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return dir + " is not a directory";
+    }
+    if (info.st_uid != geteuid()) {
+        return dir + " is owned by another user";
+    }
+    if (info.st_mode & (S_IWGRP | S_IWOTH)) {
+        return dir + " is writable by other users";
+    }
+    return "";
+}
+
+std::string first_error_line(const std::string& file) {
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find("error") != std::string::npos) {
+            return line;
+        }
+    }
+    return "";
+}
+
+struct LoadedModule {
+    void* handle = nullptr;
+    const graphs::CompiledConstraint* table = nullptr;
+    std::string error;
+};
+
+LoadedModule load_module(const std::string& path, size_t expected_count) {
+    LoadedModule module;
+    module.handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!module.handle) {
+        const char* error = dlerror();
+        module.error = error ? error : "dlopen failed";
+        return module;
+    }
+    auto* count = static_cast<const unsigned long*>(dlsym(module.handle, "temporis_constraint_count"));
+    auto* table = static_cast<const graphs::CompiledConstraint*>(dlsym(module.handle, "temporis_constraints"));
+    if (!count || !table || *count != expected_count) {
+        module.error = "unexpected symbols in " + path;
+        dlclose(module.handle);
+        module.handle = nullptr;
+        return module;
+    }
+    module.table = table;
+    return module;
+}
+
+} // namespace
+
+double CodegenReport::estimated_evaluations(uint64_t edge_checks) const {
+    return edges == 0 ? 0.0 : static_cast<double>(edge_checks) * constrained_edges / edges;
+}
+
+double CodegenReport::saved_seconds(double evaluations) const {
+    return evaluations * (interpreted_ns - compiled_ns) * 1e-9;
+}
+
+double CodegenReport::break_even_evaluations() const {
+    double saving_ns = interpreted_ns - compiled_ns;
+    return saving_ns > 0 ? total_time().count() * 1e9 / saving_ns : 0.0;
+}
+
+ConstraintCompiler::ConstraintCompiler(std::string cache_dir)
+    : cache_dir_(cache_dir.empty() ? default_cache_dir() : std::move(cache_dir)) {
+    if (const char* cxx = std::getenv("TEMPORIS_CODEGEN_CXX"); cxx && *cxx) {
+        compiler_ = cxx;
+    } else if (const char* cxx = std::getenv("CXX"); cxx && *cxx) {
+        compiler_ = cxx;
+    } else {
+        compiler_ = TEMPORIS_CODEGEN_COMPILER;
+    }
+}
+
+std::string ConstraintCompiler::expression(const graphs::PresburgerFormula& formula) {
+    std::ostringstream out;
+    write_formula(out, formula, Scope{{"time", "time"}}, 0);
+    return out.str();
+}
+
+std::string ConstraintCompiler::translation_unit(const std::vector<std::string>& expressions) {
+    std::ostringstream out;
+    out << "// Generated by temporis (" << kCodegenVersion << "): " << expressions.size()
+        << " constraint(s)\n";
+    out << "namespace {\n";
+    for (size_t i = 0; i < expressions.size(); ++i) {
+        out << "bool constraint_" << i << "(int time) { (void)time; return " << expressions[i] << "; }\n";
+    }
+    out << "} // namespace\n\n";
+    out << "extern \"C\" {\n";
+    out << "extern const unsigned long temporis_constraint_count;\n";
+    out << "extern bool (*const temporis_constraints[])(int);\n";
+    out << "const unsigned long temporis_constraint_count = " << expressions.size() << ";\n";
+    out << "bool (*const temporis_constraints[])(int) = {\n";
+    for (size_t i = 0; i < expressions.size(); ++i) {
+        out << "    constraint_" << i << ",\n";
+    }
+    out << "};\n";
+    out << "}\n";
+    return out.str();
+}
+
+bool ConstraintCompiler::compile(graphs::GGGTemporalGameManager& manager) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "constraint_codegen");
+    namespace fs = std::filesystem;
+    report_ = CodegenReport{};
+    const auto& graph = *manager.graph();
+    report_.edges = boost::num_edges(graph);
+
+    // One function per distinct generated expression, shared by all edges using it
+    auto generate_start = std::chrono::steady_clock::now();
+    std::vector<std::string> expressions;
+    std::unordered_map<std::string, size_t> function_of;
+    std::vector<std::pair<graphs::GGGTemporalEdge, size_t>> edge_functions;
+    std::vector<std::shared_ptr<const graphs::PresburgerFormula>> samples;
+    auto [edge_begin, edge_end] = boost::edges(graph);
+    for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+        auto formula = manager.edge_constraint(*edge_it);
+        if (!formula) {
+            continue;
+        }
+        auto [it, inserted] = function_of.emplace(expression(*formula), expressions.size());
+        if (inserted) {
+            expressions.push_back(it->first);
+            samples.push_back(formula);
+        }
+        edge_functions.emplace_back(*edge_it, it->second);
+    }
+    report_.constrained_edges = edge_functions.size();
+    report_.distinct_constraints = expressions.size();
+    if (expressions.empty()) {
+        report_.fallback_reason = "no constrained edges";
+        return false;
+    }
+
+    std::string source = translation_unit(expressions);
+    report_.source_bytes = source.size();
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0')
+        << fnv1a(source + '\0' + compiler_ + ' ' + flags_ + ' ' + kCodegenVersion);
+    fs::path base = fs::path(cache_dir_) / ("constraints_" + key.str());
+    fs::path object = base.string() + ".so";
+    report_.object_path = object.string();
+    report_.generate_time = std::chrono::steady_clock::now() - generate_start;
+
+    std::error_code error;
+    if (fs::create_directories(cache_dir_, error)) {
+        fs::permissions(cache_dir_, fs::perms::owner_all, error);
+    }
+    if (error) {
+        report_.fallback_reason = "cannot create cache directory " + cache_dir_ + ": " + error.message();
+        return false;
+    }
+    if (std::string unsafe = unsafe_cache_dir(cache_dir_); !unsafe.empty()) {
+        report_.fallback_reason = "refusing cache directory: " + unsafe;
+        return false;
+    }
+
+    LoadedModule module;
+    auto load_start = std::chrono::steady_clock::now();
+    if (fs::exists(object)) {
+        module = load_module(object.string(), expressions.size());
+        report_.cache_hit = module.handle != nullptr;
+    }
+    report_.load_time = std::chrono::steady_clock::now() - load_start;
+
+    if (!module.handle) {
+        TEMPORIS_TRACE_SCOPE("compile_constraints");
+        auto compile_start = std::chrono::steady_clock::now();
+        fs::path source_file = base.string() + ".cpp";
+        fs::path log_file = base.string() + ".log";
+        // Compile to a private name and rename, so concurrent runs never load a partial object
+        fs::path partial = base.string() + ".so." + std::to_string(getpid()) + ".tmp";
+        {
+            std::ofstream out(source_file);
+            out << source;
+            if (!out) {
+                report_.fallback_reason = "cannot write " + source_file.string();
+                return false;
+            }
+        }
+        std::string command = shell_quote(compiler_) + " " + flags_ + " -o " + shell_quote(partial.string()) +
+                              " " + shell_quote(source_file.string()) + " > " + shell_quote(log_file.string()) +
+                              " 2>&1";
+        int status = std::system(command.c_str());
+        report_.compile_time = std::chrono::steady_clock::now() - compile_start;
+        if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            if (status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 127) {
+                report_.fallback_reason = "compiler " + compiler_ + " not found";
+            } else {
+                std::string detail = first_error_line(log_file.string());
+                report_.fallback_reason = "compilation failed" + (detail.empty() ? "" : ": " + detail);
+            }
+            fs::remove(partial, error);
+            return false;
+        }
+        fs::rename(partial, object, error);
+        fs::remove(log_file, error);
+
+        auto reload_start = std::chrono::steady_clock::now();
+        module = load_module(object.string(), expressions.size());
+        report_.load_time += std::chrono::steady_clock::now() - reload_start;
+        if (!module.handle) {
+            report_.fallback_reason = module.error;
+            return false;
+        }
+    }
+
+    std::shared_ptr<const void> handle(module.handle, [](const void* h) { dlclose(const_cast<void*>(h)); });
+    manager.retain_compiled_module(handle);
+    for (const auto& [edge, function] : edge_functions) {
+        manager.set_compiled_constraint(edge, module.table[function]);
+    }
+    report_.compiled = true;
+
+    // Sample both evaluators the way the manager calls them
+    constexpr size_t kSampleConstraints = 64;
+    constexpr int kSampleTimes = 256;
+    size_t sampled = std::min(samples.size(), kSampleConstraints);
+    auto interpreted_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < sampled; ++i) {
+        for (int time = 0; time < kSampleTimes; ++time) {
+            std::map<std::string, int> variables = {{"time", time}};
+            samples[i]->evaluate(variables);
+        }
+    }
+    std::chrono::duration<double, std::nano> interpreted = std::chrono::steady_clock::now() - interpreted_start;
+
+    constexpr int kCompiledRepeats = 16;
+    auto compiled_start = std::chrono::steady_clock::now();
+    for (int repeat = 0; repeat < kCompiledRepeats; ++repeat) {
+        for (size_t i = 0; i < sampled; ++i) {
+            graphs::CompiledConstraint function = module.table[i];
+            for (int time = 0; time < kSampleTimes; ++time) {
+                function(time);
+            }
+        }
+    }
+    std::chrono::duration<double, std::nano> compiled = std::chrono::steady_clock::now() - compiled_start;
+
+    double evaluations = static_cast<double>(sampled) * kSampleTimes;
+    report_.interpreted_ns = interpreted.count() / evaluations;
+    report_.compiled_ns = compiled.count() / (evaluations * kCompiledRepeats);
+    TEMPORIS_TRACE_ARG(trace_scope, "distinct_constraints", expressions.size());
+    TEMPORIS_TRACE_ARG(trace_scope, "cache_hit", report_.cache_hit);
+    return true;
+}
+
+void ConstraintCompiler::write_report(std::ostream& out, double evaluations) const {
+    out << "\n=== Constraint Codegen ===\n";
+    out << "Constraints: " << report_.constrained_edges << " constrained edges, "
+        << report_.distinct_constraints << " distinct, " << report_.source_bytes << " bytes of C++\n";
+    if (!report_.compiled) {
+        out << "Not compiled (" << report_.fallback_reason << "), constraints were interpreted\n";
+        return;
+    }
+    out << std::fixed << std::setprecision(6);
+    out << "Object: " << report_.object_path << (report_.cache_hit ? " (cache hit)" : " (compiled)") << "\n";
+    out << "Generate: " << report_.generate_time.count() << "s, compile: " << report_.compile_time.count()
+        << "s, load: " << report_.load_time.count() << "s\n";
+    out << std::setprecision(1);
+    out << "Per evaluation: interpreted " << report_.interpreted_ns << " ns, compiled " << report_.compiled_ns
+        << " ns\n";
+    out << std::setprecision(0) << "Constraint evaluations (estimated): " << evaluations << "\n";
+    out << std::setprecision(6) << "Saved: " << report_.saved_seconds(evaluations) << "s against "
+        << report_.total_time().count() << "s of codegen";
+    out << std::setprecision(0) << " (break-even after " << report_.break_even_evaluations()
+        << " evaluations)\n";
+}
+
+} // namespace codegen
+} // namespace ggg
@@ -0,0 +1,237 @@
+#include "game_generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace ggg {
+namespace graphs {
+
+bool GameGeneratorOptions::set_constraint_mix(const std::string& mix) {
+    threshold_weight = interval_weight = modulus_weight = existential_weight = unconstrained_weight = 0.0;
+    if (mix == "mixed") {
+        threshold_weight = interval_weight = modulus_weight = existential_weight = 1.0;
+    } else if (mix == "threshold") {
+        threshold_weight = 1.0;
+    } else if (mix == "interval") {
+        interval_weight = 1.0;
+    } else if (mix == "modulus") {
+        modulus_weight = 1.0;
+    } else if (mix == "existential") {
+        existential_weight = 1.0;
+    } else if (mix == "none") {
+        unconstrained_weight = 1.0;
+    } else {
+        threshold_weight = interval_weight = modulus_weight = existential_weight = 1.0;
+        return false;
+    }
+    return true;
+}
+
+bool GameGeneratorOptions::parse_degree_distribution(const std::string& name, DegreeDistribution& out) {
+    if (name == "fixed") {
+        out = DegreeDistribution::FIXED;
+    } else if (name == "uniform") {
+        out = DegreeDistribution::UNIFORM;
+    } else if (name == "power-law") {
+        out = DegreeDistribution::POWER_LAW;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string GeneratedConstraint::to_string() const {
+    switch (kind) {
+        case Kind::ALWAYS: return "true";
+        case Kind::GREATEREQUAL: return "time >= " + std::to_string(a);
+        case Kind::LESSEQUAL: return "time <= " + std::to_string(a);
+        case Kind::NOTEQUAL: return "time != " + std::to_string(a);
+        case Kind::INTERVAL: return "time >= " + std::to_string(a) + " && time <= " + std::to_string(b);
+        case Kind::MODULUS: return "time % " + std::to_string(a) + " == " + std::to_string(b);
+        case Kind::MULTIPLE: return "exists k: time == " + std::to_string(a) + "*k";
+        case Kind::AND:
+        case Kind::OR: {
+            // The constraint grammar has no general parenthesization, so only
+            // disjunctions of conjunctions are emitted and precedence does the rest
+            std::string separator = kind == Kind::AND ? " && " : " || ";
+            std::string result;
+            for (size_t i = 0; i < children.size(); ++i) {
+                if (i > 0) result += separator;
+                result += children[i].to_string();
+            }
+            return result;
+        }
+        default: return "true";
+    }
+}
+
+bool GeneratedConstraint::evaluate(int time) const {
+    switch (kind) {
+        case Kind::ALWAYS: return true;
+        case Kind::GREATEREQUAL: return time >= a;
+        case Kind::LESSEQUAL: return time <= a;
+        case Kind::NOTEQUAL: return time != a;
+        case Kind::INTERVAL: return time >= a && time <= b;
+        case Kind::MODULUS: return time % a == b;
+        case Kind::MULTIPLE: return time % a == 0 && time / a >= -10 && time / a <= 10;
+        case Kind::AND:
+            return std::all_of(children.begin(), children.end(),
+                               [time](const GeneratedConstraint& child) { return child.evaluate(time); });
+        case Kind::OR:
+            return std::any_of(children.begin(), children.end(),
+                               [time](const GeneratedConstraint& child) { return child.evaluate(time); });
+        default: return true;
+    }
+}
+
+GameGenerator::GameGenerator(const GameGeneratorOptions& options)
+    : options_(options), rng_(options.seed),
+      family_dist_({options.threshold_weight, options.interval_weight, options.modulus_weight,
+                    options.existential_weight, options.unconstrained_weight}) {
+}
+
+uint64_t GameGenerator::sample_degree(uint64_t vertex) {
+    uint64_t vertices = std::max<uint64_t>(1, options_.vertices);
+    double mean = static_cast<double>(options_.edges) / vertices;
+    uint64_t degree = 0;
+
+    switch (options_.degree_distribution) {
+        case GameGeneratorOptions::DegreeDistribution::FIXED:
+            degree = options_.edges / vertices + (vertex < options_.edges % vertices ? 1 : 0);
+            break;
+        case GameGeneratorOptions::DegreeDistribution::UNIFORM: {
+            uint64_t upper = static_cast<uint64_t>(std::llround(2.0 * mean));
+            upper = upper > options_.min_degree ? upper - options_.min_degree : options_.min_degree;
+            std::uniform_int_distribution<uint64_t> dist(options_.min_degree, std::max(options_.min_degree, upper));
+            degree = dist(rng_);
+            break;
+        }
+        case GameGeneratorOptions::DegreeDistribution::POWER_LAW: {
+            // Pareto sample whose expectation equals the requested mean degree
+            double alpha = std::max(2.01, options_.power_law_exponent);
+            double x_min = mean * (alpha - 2.0) / (alpha - 1.0);
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            double sample = x_min * std::pow(1.0 - unit(rng_), -1.0 / (alpha - 1.0));
+            degree = static_cast<uint64_t>(std::llround(std::min(sample, static_cast<double>(vertices))));
+            break;
+        }
+    }
+    return std::max(degree, options_.min_degree);
+}
+
+GeneratedConstraint GameGenerator::generate_atom() {
+    int horizon = std::max(1, options_.time_bound);
+    std::uniform_int_distribution<int> time_dist(0, horizon - 1);
+    GeneratedConstraint atom;
+
+    switch (family_dist_(rng_)) {
+        case 0: {
+            static const GeneratedConstraint::Kind kinds[] = {
+                GeneratedConstraint::Kind::GREATEREQUAL, GeneratedConstraint::Kind::LESSEQUAL,
+                GeneratedConstraint::Kind::NOTEQUAL};
+            atom.kind = kinds[rng_() % 3];
+            atom.a = time_dist(rng_);
+            break;
+        }
+        case 1: {
+            int lower = time_dist(rng_);
+            int upper = time_dist(rng_);
+            atom.kind = GeneratedConstraint::Kind::INTERVAL;
+            atom.a = std::min(lower, upper);
+            atom.b = std::max(lower, upper);
+            break;
+        }
+        case 2:
+            atom.kind = GeneratedConstraint::Kind::MODULUS;
+            atom.a = 2 + static_cast<int>(rng_() % 6);
+            atom.b = static_cast<int>(rng_() % atom.a);
+            break;
+        case 3:
+            atom.kind = GeneratedConstraint::Kind::MULTIPLE;
+            atom.a = 2 + static_cast<int>(rng_() % 4);
+            break;
+        default:
+            atom.kind = GeneratedConstraint::Kind::ALWAYS;
+            break;
+    }
+    return atom;
+}
+
+GeneratedConstraint GameGenerator::generate_conjunction() {
+    GeneratedConstraint conjunction;
+    conjunction.kind = GeneratedConstraint::Kind::AND;
+    conjunction.children.push_back(generate_atom());
+    conjunction.children.push_back(generate_atom());
+    return conjunction;
+}
+
+GeneratedConstraint GameGenerator::generate_constraint() {
+    if (options_.nesting_depth <= 1) {
+        return generate_atom();
+    }
+    if (options_.nesting_depth == 2) {
+        return generate_conjunction();
+    }
+
+    GeneratedConstraint disjunction;
+    disjunction.kind = GeneratedConstraint::Kind::OR;
+    for (int i = 1; i < options_.nesting_depth; ++i) {
+        disjunction.children.push_back(generate_conjunction());
+    }
+    return disjunction;
+}
+
+uint64_t GameGenerator::write_dot(std::ostream& out) {
+    uint64_t vertices = options_.vertices;
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<uint64_t> target_dist(0, vertices > 0 ? vertices - 1 : 0);
+
+    out << "digraph G {\n";
+    out << "    // time_bound: " << options_.time_bound << "\n";
+    out << "    // generated by temporis_gen: seed=" << options_.seed << " vertices=" << options_.vertices
+        << " edges=" << options_.edges << " nesting_depth=" << options_.nesting_depth << "\n";
+
+    bool has_target = false;
+    for (uint64_t v = 0; v < vertices; ++v) {
+        int player = unit(rng_) < options_.player1_ratio ? 1 : 0;
+        bool target = unit(rng_) < options_.target_density;
+        // Guarantee at least one target so the game is well-formed
+        if (v + 1 == vertices && !has_target) {
+            target = true;
+        }
+        has_target = has_target || target;
+
+        out << "    v" << v << " [name=\"v" << v << "\", player=" << player;
+        if (target) {
+            out << ", target=1";
+        }
+        out << "];\n";
+    }
+
+    uint64_t edges_written = 0;
+    for (uint64_t v = 0; v < vertices; ++v) {
+        uint64_t degree = sample_degree(v);
+        for (uint64_t d = 0; d < degree; ++d) {
+            uint64_t target = target_dist(rng_);
+            GeneratedConstraint constraint = generate_constraint();
+            out << "    v" << v << " -> v" << target;
+            if (constraint.kind != GeneratedConstraint::Kind::ALWAYS) {
+                out << " [constraint=\"" << constraint.to_string() << "\"]";
+            }
+            out << ";\n";
+            ++edges_written;
+        }
+    }
+
+    out << "}\n";
+    return edges_written;
+}
+
+std::string GameGenerator::generate_dot() {
+    std::ostringstream out;
+    write_dot(out);
+    return out.str();
+}
+
+} // namespace graphs
+} // namespace ggg
@@ -1,15 +1,149 @@
 #include "ggg_temporal_graph.hpp"
 #include "presburger_formula.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "probes.hpp"
+#include "trace.hpp"
 #include <boost/graph/graph_traits.hpp>
+#include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <regex>
+#include <stdexcept>
+#include <string_view>
 #include <algorithm>
 
 namespace ggg {
 namespace graphs {
 
+namespace {
+
+bool is_space(char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+bool is_word(char c) { return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_'; }
+
+/**
+ * @brief Cursor over one DOT line for the hand-written line patterns below
+ *
+ * Each step consumes the longest match or nothing, which is all the patterns
+ * need: none of them can succeed by giving back part of a word, a number or a
+ * quoted string.
+ */
+struct LineCursor {
+    std::string_view line;
+    size_t pos = 0;
+
+    void skip_space() {
+        while (pos < line.size() && is_space(line[pos])) ++pos;
+    }
+    // \s*text
+    bool token(std::string_view text) {
+        skip_space();
+        if (line.substr(pos, text.size()) != text) return false;
+        pos += text.size();
+        return true;
+    }
+    // \s*(\w+) or \s*(\d+)
+    bool run(bool (*accept)(char), std::string_view& out) {
+        skip_space();
+        size_t start = pos;
+        while (pos < line.size() && accept(line[pos])) ++pos;
+        out = line.substr(start, pos - start);
+        return pos > start;
+    }
+    // \s*"([^"]*)" or \s*"([^"]+)"
+    bool quoted(std::string_view& out, bool allow_empty) {
+        if (!token("\"")) return false;
+        size_t close = line.find('"', pos);
+        if (close == std::string_view::npos || (!allow_empty && close == pos)) return false;
+        out = line.substr(pos, close - pos);
+        pos = close + 1;
+        return true;
+    }
+};
+
+struct VertexLine {
+    std::string_view id, name, player, target, target_constraint;
+};
+
+struct EdgeLine {
+    std::string_view source, target, attribute;   // label or constraint text
+};
+
+// Tries match at the start of every word of the line, leftmost first, like std::regex_search
+template <typename Match>
+bool search_line(std::string_view line, Match match) {
+    for (size_t start = 0; start < line.size();) {
+        if (!is_word(line[start])) {
+            ++start;
+            continue;
+        }
+        LineCursor cursor{line, start};
+        if (match(cursor)) return true;
+        while (start < line.size() && is_word(line[start])) ++start;
+    }
+    return false;
+}
+
+// (\w+) [ name = "([^"]+)" , player = (\d+) (, target = (\d+))? (, target_constraint = "([^"]+)")? ] ;
+bool match_vertex_line(std::string_view line, VertexLine& out) {
+    return search_line(line, [&](LineCursor& c) {
+        out = VertexLine{};
+        if (!(c.run(is_word, out.id) && c.token("[") && c.token("name") && c.token("=") &&
+              c.quoted(out.name, false) && c.token(",") && c.token("player") && c.token("=") &&
+              c.run(is_digit, out.player))) {
+            return false;
+        }
+        size_t optional = c.pos;
+        if (!(c.token(",") && c.token("target") && c.token("=") && c.run(is_digit, out.target))) {
+            c.pos = optional;
+            out.target = {};
+        }
+        optional = c.pos;
+        if (!(c.token(",") && c.token("target_constraint") && c.token("=") && c.quoted(out.target_constraint, false))) {
+            c.pos = optional;
+            out.target_constraint = {};
+        }
+        return c.token("]") && c.token(";");
+    });
+}
+
+// (\w+) -> (\w+) ([ label = "([^"]*)" ])? ;
+bool match_edge_line(std::string_view line, EdgeLine& out) {
+    return search_line(line, [&](LineCursor& c) {
+        out = EdgeLine{};
+        if (!(c.run(is_word, out.source) && c.token("->") && c.run(is_word, out.target))) {
+            return false;
+        }
+        size_t optional = c.pos;
+        if (!(c.token("[") && c.token("label") && c.token("=") && c.quoted(out.attribute, true) && c.token("]"))) {
+            c.pos = optional;
+            out.attribute = {};
+        }
+        return c.token(";");
+    });
+}
+
+// (\w+) -> (\w+) [ constraint = "([^"]+)" ] ;
+bool match_constraint_line(std::string_view line, EdgeLine& out) {
+    return search_line(line, [&](LineCursor& c) {
+        out = EdgeLine{};
+        return c.run(is_word, out.source) && c.token("->") && c.run(is_word, out.target) && c.token("[") &&
+               c.token("constraint") && c.token("=") && c.quoted(out.attribute, false) && c.token("]") &&
+               c.token(";");
+    });
+}
+
+} // namespace
+
+void LazyConstraintStatistics::write_report(std::ostream& out) const {
+    out << "\n=== Lazy Constraints ===\n";
+    out << "Deferred at load: " << deferred << " (" << arena_bytes << " bytes of text)\n";
+    out << "Materialized: " << materialized << " in " << std::fixed << std::setprecision(6)
+        << parse_time.count() << "s\n";
+    out << "Never materialized: " << never_materialized() << "\n";
+}
+
 GGGTemporalGameManager::GGGTemporalGameManager() 
     : graph_(std::make_shared<GGGTemporalGraph>()), current_time_(0) {
 }
@@ -24,19 +158,149 @@ std::pair<GGGTemporalEdge, bool> GGGTemporalGameManager::add_edge(
 }
 
 void GGGTemporalGameManager::add_edge_constraint(GGGTemporalEdge edge, 
-                                                std::unique_ptr<PresburgerFormula> constraint) {
-    edge_constraints_[edge] = std::move(constraint);
+                                                std::shared_ptr<const PresburgerFormula> constraint) {
+    edge_constraints_[edge] = EdgeConstraint{std::move(constraint), nullptr, nullptr};
+}
+
+std::shared_ptr<const PresburgerFormula> GGGTemporalGameManager::edge_constraint(GGGTemporalEdge edge) const {
+    auto it = edge_constraints_.find(edge);
+    return it == edge_constraints_.end() ? nullptr : materialize(it->second);
+}
+
+const std::shared_ptr<const PresburgerFormula>& GGGTemporalGameManager::materialize(
+    const EdgeConstraint& constraint) const {
+    if (!constraint.lazy) {
+        return constraint.formula;
+    }
+    LazyConstraint& lazy = *constraint.lazy;
+    std::call_once(lazy.parsed, [&] {
+        TEMPORIS_TRACE_SCOPE("materialize_constraint");
+        std::string text = lazy.store->arena.substr(lazy.offset, lazy.length);
+        auto parse_start = std::chrono::steady_clock::now();
+        TEMPORIS_PROBE2(constraint__compile__start, text.c_str(), text.size());
+        // A throwing callable would leave the flag unset and be parsed again by the next use
+        try {
+            lazy.formula = parse_edge_constraint(text);
+        } catch (const std::exception&) {
+            lazy.error = std::current_exception();
+        }
+        auto parse_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - parse_start).count();
+        TEMPORIS_PROBE3(constraint__compile__done, text.c_str(), text.size(), parse_ns);
+        lazy.store->parse_ns += parse_ns;
+        lazy.store->materialized++;
+    });
+    if (lazy.error) {
+        std::rethrow_exception(lazy.error);
+    }
+    return lazy.formula;
+}
+
+std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_edge_constraint(
+    const std::string& constraint_str) const {
+    try {
+        return parse_constraint(constraint_str);
+    } catch (const std::exception& e) {
+        throw std::invalid_argument("invalid constraint \"" + constraint_str + "\": " + e.what());
+    }
+}
+
+void GGGTemporalGameManager::retain(std::shared_ptr<const void> owner) {
+    if (std::find(retained_.begin(), retained_.end(), owner) == retained_.end()) {
+        retained_.push_back(std::move(owner));
+    }
+}
+
+void GGGTemporalGameManager::add_target_constraint(GGGTemporalVertex vertex,
+                                                   std::shared_ptr<const PresburgerFormula> constraint) {
+    target_constraints_[vertex] = std::move(constraint);
+}
+
+std::shared_ptr<const PresburgerFormula> GGGTemporalGameManager::target_constraint(GGGTemporalVertex vertex) const {
+    auto it = target_constraints_.find(vertex);
+    return it == target_constraints_.end() ? nullptr : it->second;
+}
+
+bool GGGTemporalGameManager::is_target_constraint_satisfied(GGGTemporalVertex vertex, int time) const {
+    auto it = target_constraints_.find(vertex);
+    if (it == target_constraints_.end()) {
+        return true;
+    }
+    try {
+        std::map<std::string, int> variables = {{"time", time}};
+        return it->second->evaluate(variables);
+    } catch (const std::exception&) {
+        return false; // Like an edge, a target whose constraint fails to evaluate does not count
+    }
+}
+
+std::set<GGGTemporalVertex> GGGTemporalGameManager::targets_at(const std::set<GGGTemporalVertex>& targets,
+                                                               int time) const {
+    if (target_constraints_.empty()) {
+        return targets;
+    }
+    std::set<GGGTemporalVertex> active;
+    for (auto target : targets) {
+        if (is_target_constraint_satisfied(target, time)) {
+            active.insert(active.end(), target);
+        }
+    }
+    return active;
 }
 
+void GGGTemporalGameManager::copy_edge_constraint(GGGTemporalEdge edge, const GGGTemporalGameManager& from,
+                                                  GGGTemporalEdge from_edge) {
+    auto it = from.edge_constraints_.find(from_edge);
+    if (it == from.edge_constraints_.end()) {
+        return;
+    }
+    edge_constraints_[edge] = it->second;
+    if (from.lazy_store_) {
+        retain(from.lazy_store_);
+    }
+    for (const auto& owner : from.retained_) {
+        retain(owner);
+    }
+}
+
+LazyConstraintStatistics GGGTemporalGameManager::lazy_constraint_statistics() const {
+    LazyConstraintStatistics stats;
+    if (lazy_store_) {
+        stats.deferred = lazy_store_->constraints.size();
+        stats.materialized = lazy_store_->materialized;
+        stats.arena_bytes = lazy_store_->arena.size();
+        stats.parse_time = std::chrono::nanoseconds(lazy_store_->parse_ns.load());
+    }
+    return stats;
+}
+
+void GGGTemporalGameManager::set_compiled_constraint(GGGTemporalEdge edge, CompiledConstraint compiled) {
+    auto it = edge_constraints_.find(edge);
+    if (it != edge_constraints_.end()) {
+        it->second.compiled = compiled;
+    }
+}
+
+CompiledConstraint GGGTemporalGameManager::compiled_constraint(GGGTemporalEdge edge) const {
+    auto it = edge_constraints_.find(edge);
+    return it == edge_constraints_.end() ? nullptr : it->second.compiled;
+}
+
+
 bool GGGTemporalGameManager::is_edge_constraint_satisfied(GGGTemporalEdge edge, int time) const {
     auto it = edge_constraints_.find(edge);
     if (it == edge_constraints_.end()) {
         return true; // No constraint means always available
     }
+    if (it->second.compiled) {
+        return it->second.compiled(time);
+    }
     
+    // A deferred constraint that does not parse throws here, as it would have failed an eager load
+    const auto& formula = materialize(it->second);
     try {
         std::map<std::string, int> variables = {{"time", time}};
-        return it->second->evaluate(variables);
+        return formula->evaluate(variables);
     } catch (const std::exception&) {
         return false; // If evaluation fails, edge is not available
     }
@@ -53,7 +317,11 @@ int GGGTemporalGameManager::current_time() const {
 void GGGTemporalGameManager::clear_graph() {
     graph_ = std::make_shared<GGGTemporalGraph>();
     edge_constraints_.clear();
+    target_constraints_.clear();
+    lazy_store_.reset();
+    retained_.clear();
     current_time_ = 0;
+    load_stats_ = LoadStatistics{};
 }
 
 std::vector<GGGTemporalVertex> GGGTemporalGameManager::get_available_moves(
@@ -91,113 +359,145 @@ bool GGGTemporalGameManager::load_from_dot_file(const std::string& filename) {
         return false;
     }
     
+    return load_from_stream(file);
+}
+
+bool GGGTemporalGameManager::load_from_dot_string(const std::string& dot_content) {
+    // Parse DOT content from string instead of file
+    std::istringstream stream(dot_content);
+    return load_from_stream(stream);
+}
+
+bool GGGTemporalGameManager::load_from_stream(std::istream& input) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "load_dot");
+    perf::ScopedPerfPhase perf_phase("load");
+    auto load_start = std::chrono::steady_clock::now();
+    TEMPORIS_PROBE0(load__start);
+    
     clear_graph();
+    if (lazy_constraints_) {
+        lazy_store_ = std::make_shared<LazyConstraintStore>();
+    }
     
     std::string line;
     std::map<std::string, GGGTemporalVertex> vertex_map;
     
-    // Regex patterns for parsing
-    std::regex vertex_pattern(R"(\s*(\w+)\s*\[\s*name\s*=\s*\"([^\"]+)\"\s*,\s*player\s*=\s*(\d+)(?:\s*,\s*target\s*=\s*(\d+))?\s*\]\s*;)");
-    std::regex edge_pattern(R"(\s*(\w+)\s*->\s*(\w+)(?:\s*\[\s*label\s*=\s*\"([^\"]*)\"\s*\])?\s*;)");
-    std::regex constraint_pattern(R"(\s*(\w+)\s*->\s*(\w+)\s*\[\s*constraint\s*=\s*\"([^\"]+)\"\s*\]\s*;)");
+    // Line patterns, tried in this order; each is matched in time linear in the line
+    VertexLine vertex_line;
+    EdgeLine edge_line;
     
-    while (std::getline(file, line)) {
-        std::smatch match;
+    while (std::getline(input, line)) {
+        load_stats_.bytes_read += line.size() + 1;
+        load_stats_.lines++;
         
         // Parse vertex definitions
-        if (std::regex_search(line, match, vertex_pattern)) {
-            std::string vertex_id = match[1].str();
-            std::string vertex_name = match[2].str();
-            int player = std::stoi(match[3].str());
-            int target = (match.size() > 4 && !match[4].str().empty()) ? std::stoi(match[4].str()) : 0;
+        if (match_vertex_line(line, vertex_line)) {
+            std::string vertex_id(vertex_line.id);
+            std::string vertex_name(vertex_line.name);
+            int player = std::stoi(std::string(vertex_line.player));
+            int target = !vertex_line.target.empty() ? std::stoi(std::string(vertex_line.target)) : 0;
+            
+            // A target constraint makes the vertex a target unless target=0 is given
+            std::string target_constraint(vertex_line.target_constraint);
+            if (!target_constraint.empty() && vertex_line.target.empty()) {
+                target = 1;
+            }
             
             GGGTemporalVertex vertex = add_vertex(vertex_name, player, target);
             vertex_map[vertex_id] = vertex;
+            if (!target_constraint.empty()) {
+                auto parse_start = std::chrono::steady_clock::now();
+                try {
+                    add_target_constraint(vertex, parse_edge_constraint(target_constraint));
+                } catch (const std::invalid_argument& e) {
+                    throw std::invalid_argument("target constraint of vertex \"" + vertex_name + "\": " + e.what());
+                }
+                load_stats_.constraint_parse_time += std::chrono::steady_clock::now() - parse_start;
+                load_stats_.constraints_parsed++;
+            }
         }
         // Parse edge definitions
-        else if (std::regex_search(line, match, edge_pattern)) {
-            std::string source_id = match[1].str();
-            std::string target_id = match[2].str();
-            std::string label = match.size() > 3 ? match[3].str() : "";
+        else if (match_edge_line(line, edge_line)) {
+            auto source = vertex_map.find(std::string(edge_line.source));
+            auto target = vertex_map.find(std::string(edge_line.target));
             
-            if (vertex_map.find(source_id) != vertex_map.end() && 
-                vertex_map.find(target_id) != vertex_map.end()) {
-                add_edge(vertex_map[source_id], vertex_map[target_id], label);
+            if (source != vertex_map.end() && target != vertex_map.end()) {
+                add_edge(source->second, target->second, std::string(edge_line.attribute));
             }
         }
         // Parse constraint edges (now with full constraint parsing)
-        else if (std::regex_search(line, match, constraint_pattern)) {
-            std::string source_id = match[1].str();
-            std::string target_id = match[2].str();
-            std::string constraint_str = match[3].str();
+        else if (match_constraint_line(line, edge_line)) {
+            auto source = vertex_map.find(std::string(edge_line.source));
+            auto target = vertex_map.find(std::string(edge_line.target));
+            std::string constraint_str(edge_line.attribute);
             
-            if (vertex_map.find(source_id) != vertex_map.end() && 
-                vertex_map.find(target_id) != vertex_map.end()) {
+            if (source != vertex_map.end() && target != vertex_map.end()) {
+                auto edge = add_edge(source->second, target->second);
+                if (lazy_store_) {
+                    // Only the text is kept; materialize() parses it on first use
+                    auto& record = lazy_store_->constraints.emplace_back(
+                        lazy_store_.get(), lazy_store_->arena.size(), constraint_str.size());
+                    lazy_store_->arena += constraint_str;
+                    edge_constraints_[edge.first] = EdgeConstraint{nullptr, &record, nullptr};
+                    load_stats_.constraints_deferred++;
+                    continue;
+                }
+                
                 // Add edge and parse constraint
-                auto edge = add_edge(vertex_map[source_id], vertex_map[target_id]);
-                auto constraint = parse_constraint(constraint_str);
+                auto parse_start = std::chrono::steady_clock::now();
+                TEMPORIS_PROBE2(constraint__compile__start, constraint_str.c_str(), constraint_str.size());
+                auto constraint = parse_edge_constraint(constraint_str);
+                auto parse_time = std::chrono::steady_clock::now() - parse_start;
+                load_stats_.constraint_parse_time += parse_time;
+                TEMPORIS_PROBE3(constraint__compile__done, constraint_str.c_str(), constraint_str.size(),
+                                std::chrono::duration_cast<std::chrono::nanoseconds>(parse_time).count());
+                load_stats_.constraints_parsed++;
                 add_edge_constraint(edge.first, std::move(constraint));
             }
         }
     }
     
+    load_stats_.load_time = std::chrono::steady_clock::now() - load_start;
+    TEMPORIS_PROBE4(load__done, load_stats_.bytes_read, boost::num_vertices(*graph_),
+                    boost::num_edges(*graph_), load_stats_.constraints_parsed + load_stats_.constraints_deferred);
+    TEMPORIS_TRACE_ARG(trace_scope, "bytes", load_stats_.bytes_read);
+    TEMPORIS_TRACE_ARG(trace_scope, "vertices", boost::num_vertices(*graph_));
+    TEMPORIS_TRACE_ARG(trace_scope, "edges", boost::num_edges(*graph_));
+    TEMPORIS_TRACE_ARG(trace_scope, "constraints", load_stats_.constraints_parsed);
+    TEMPORIS_TRACE_ARG(trace_scope, "constraints_deferred", load_stats_.constraints_deferred);
+    TEMPORIS_TRACE_ARG(trace_scope, "constraint_parse_us",
+                       std::chrono::duration_cast<std::chrono::microseconds>(load_stats_.constraint_parse_time).count());
+    
     return true;
 }
 
-bool GGGTemporalGameManager::load_from_dot_string(const std::string& dot_content) {
-    // Parse DOT content from string instead of file
-    clear_graph();
-    
-    std::istringstream stream(dot_content);
-    std::string line;
-    std::map<std::string, GGGTemporalVertex> vertex_map;
-    
-    // Regex patterns for parsing (same as load_from_dot_file)
-    std::regex vertex_pattern(R"(\s*(\w+)\s*\[\s*name\s*=\s*\"([^\"]+)\"\s*,\s*player\s*=\s*(\d+)(?:\s*,\s*target\s*=\s*(\d+))?\s*\]\s*;)");
-    std::regex edge_pattern(R"(\s*(\w+)\s*->\s*(\w+)(?:\s*\[\s*label\s*=\s*\"([^\"]*)\"\s*\])?\s*;)");
-    std::regex constraint_pattern(R"(\s*(\w+)\s*->\s*(\w+)\s*\[\s*constraint\s*=\s*\"([^\"]+)\"\s*\]\s*;)");
-    
-    while (std::getline(stream, line)) {
-        std::smatch match;
-        
-        // Parse vertex definitions
-        if (std::regex_search(line, match, vertex_pattern)) {
-            std::string vertex_id = match[1].str();
-            std::string vertex_name = match[2].str();
-            int player = std::stoi(match[3].str());
-            int target = (match.size() > 4 && !match[4].str().empty()) ? std::stoi(match[4].str()) : 0;
-            
-            GGGTemporalVertex vertex = add_vertex(vertex_name, player, target);
-            vertex_map[vertex_id] = vertex;
-        }
-        // Parse edge definitions
-        else if (std::regex_search(line, match, edge_pattern)) {
-            std::string source_id = match[1].str();
-            std::string target_id = match[2].str();
-            std::string label = match.size() > 3 ? match[3].str() : "";
-            
-            if (vertex_map.find(source_id) != vertex_map.end() && 
-                vertex_map.find(target_id) != vertex_map.end()) {
-                add_edge(vertex_map[source_id], vertex_map[target_id], label);
-            }
+size_t GGGTemporalGameManager::graph_memory_bytes() const {
+    return memory::estimate_graph_bytes(*graph_,
+        [](const auto& vertex) { return memory::string_heap_bytes(vertex.name); },
+        [](const auto& edge) { return memory::string_heap_bytes(edge.label); });
+}
+
+size_t GGGTemporalGameManager::constraint_memory_bytes() const {
+    size_t bytes = memory::container_bytes(edge_constraints_);
+    for (const auto& [edge, constraint] : edge_constraints_) {
+        if (constraint.formula) {
+            bytes += constraint.formula->memory_bytes();
         }
-        // Parse constraint edges
-        else if (std::regex_search(line, match, constraint_pattern)) {
-            std::string source_id = match[1].str();
-            std::string target_id = match[2].str();
-            std::string constraint_str = match[3].str();
-            
-            if (vertex_map.find(source_id) != vertex_map.end() && 
-                vertex_map.find(target_id) != vertex_map.end()) {
-                // Add edge and parse constraint
-                auto edge = add_edge(vertex_map[source_id], vertex_map[target_id]);
-                auto constraint = parse_constraint(constraint_str);
-                add_edge_constraint(edge.first, std::move(constraint));
+    }
+    bytes += memory::container_bytes(target_constraints_);
+    for (const auto& [vertex, constraint] : target_constraints_) {
+        bytes += constraint->memory_bytes();
+    }
+    // Deferred constraints cost their text until they are materialized
+    if (lazy_store_) {
+        bytes += lazy_store_->arena.capacity() + lazy_store_->constraints.size() * sizeof(LazyConstraint);
+        for (const auto& lazy : lazy_store_->constraints) {
+            if (lazy.formula) {
+                bytes += lazy.formula->memory_bytes();
             }
         }
     }
-    
-    return true;
+    return bytes;
 }
 
 bool GGGTemporalGameManager::validate_game_structure() const {
@@ -260,51 +560,117 @@ bool GGGReachabilityObjective::has_failed(GGGTemporalVertex vertex, int time) co
 }
 
 // Constraint parsing methods (adapted from PresburgerTemporalDotParser)
-std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_constraint(const std::string& constraint_str) {
+
+struct GGGTemporalGameManager::ConstraintText {
+    std::string text;
+    // First "||" / "&&" at or after each offset, text.size() if there is none
+    std::vector<size_t> next_or;
+    std::vector<size_t> next_and;
+
+    explicit ConstraintText(std::string cleaned)
+        : text(std::move(cleaned)), next_or(text.size() + 1, text.size()), next_and(text.size() + 1, text.size()) {
+        for (size_t i = text.size(); i-- > 0;) {
+            bool pair = i + 1 < text.size() && text[i] == text[i + 1];
+            next_or[i] = pair && text[i] == '|' ? i : next_or[i + 1];
+            next_and[i] = pair && text[i] == '&' ? i : next_and[i + 1];
+        }
+    }
+};
+
+std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_constraint(const std::string& constraint_str) const {
     // Remove whitespace
     std::string cleaned = constraint_str;
     cleaned.erase(std::remove_if(cleaned.begin(), cleaned.end(), ::isspace), cleaned.end());
-    
-    // Handle simple cases first
-    if (cleaned == "true") {
-        return PresburgerFormula::equal(
-            PresburgerTerm(1), 
-            PresburgerTerm(1)
-        );
-    }
-    if (cleaned == "false") {
-        return PresburgerFormula::equal(
-            PresburgerTerm(1), 
-            PresburgerTerm(0)
-        );
-    }
-    
-    // Parse existential quantifiers
-    if (cleaned.starts_with("exists")) {
-        return parse_existential_formula(cleaned);
-    }
-    
-    // Parse negation operator
-    if (cleaned.starts_with("!")) {
-        std::string inner_formula = cleaned.substr(1);
-        auto inner = parse_constraint(inner_formula);
-        return PresburgerFormula::not_formula(std::move(inner));
-    }
-    
-    // Parse parenthesized expressions
-    if (cleaned.starts_with("(") && cleaned.ends_with(")")) {
-        std::string inner_formula = cleaned.substr(1, cleaned.length() - 2);
-        return parse_constraint(inner_formula);
+    ConstraintText text(std::move(cleaned));
+    return parse_constraint_range(text, 0, text.text.size());
+}
+
+std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_constraint_range(const ConstraintText& text,
+                                                                                  size_t begin, size_t end) const {
+    // Prefixes and right operands are peeled off in a loop on offsets into text, so
+    // deep nesting and long chains cost neither copies nor stack. Left operands
+    // contain no operator of their split and recurse at most twice.
+    struct Pending {
+        PresburgerFormula::Type type;                // NOT, EXISTS, AND or OR
+        std::string variable;                        // EXISTS
+        std::unique_ptr<PresburgerFormula> left;     // AND, OR
+    };
+    std::vector<Pending> pending;
+    std::unique_ptr<PresburgerFormula> formula;
+    
+    while (!formula) {
+        std::string_view view(text.text.data() + begin, end - begin);
+        
+        // Handle simple cases first
+        if (view == "true") {
+            formula = PresburgerFormula::equal(PresburgerTerm(1), PresburgerTerm(1));
+        } else if (view == "false") {
+            formula = PresburgerFormula::equal(PresburgerTerm(1), PresburgerTerm(0));
+        }
+        // Parse existential quantifiers: 'exists x: ...' and 'exists x. ...'
+        else if (view.starts_with("exists")) {
+            size_t var_end = begin + 6;
+            while (var_end < end && is_word(text.text[var_end])) {
+                ++var_end;
+            }
+            if (var_end > begin + 6 && var_end + 1 < end && (text.text[var_end] == ':' || text.text[var_end] == '.')) {
+                pending.push_back({PresburgerFormula::EXISTS, text.text.substr(begin + 6, var_end - begin - 6), nullptr});
+                begin = var_end + 1;
+            } else {
+                formula = PresburgerFormula::equal(PresburgerTerm(1), PresburgerTerm(1));
+            }
+        }
+        // Parse negation operator
+        else if (view.starts_with('!')) {
+            pending.push_back({PresburgerFormula::NOT, {}, nullptr});
+            ++begin;
+        }
+        // Parse parenthesized expressions
+        else if (view.starts_with('(') && view.ends_with(')')) {
+            ++begin;
+            --end;
+        }
+        // Parse logical operators FIRST (lower precedence, should be at top level)
+        else if (text.next_or[begin] + 2 <= end || text.next_and[begin] + 2 <= end) {
+            bool is_or = text.next_or[begin] + 2 <= end;
+            size_t pos = is_or ? text.next_or[begin] : text.next_and[begin];
+            pending.push_back({is_or ? PresburgerFormula::OR : PresburgerFormula::AND, {},
+                               parse_constraint_range(text, begin, pos)});
+            begin = pos + 2;
+        } else {
+            formula = parse_atomic_formula(std::string(view));
+        }
     }
     
-    // Parse logical operators FIRST (lower precedence, should be at top level)
-    for (const auto& op : {"||", "&&"}) {
-        auto pos = cleaned.find(op);
-        if (pos != std::string::npos) {
-            return parse_logical_formula(cleaned, op, pos);
+    // Wrap innermost first; a chain of one operator becomes one n-ary formula
+    // and double negations cancel, so formula depth does not grow with the input
+    for (size_t i = pending.size(); i-- > 0;) {
+        PresburgerFormula::Type type = pending[i].type;
+        size_t first = i;
+        while (first > 0 && pending[first - 1].type == type && type != PresburgerFormula::EXISTS) {
+            --first;
         }
+        if (type == PresburgerFormula::NOT) {
+            if ((i - first + 1) % 2 == 1) {
+                formula = PresburgerFormula::not_formula(std::move(formula));
+            }
+        } else if (type == PresburgerFormula::EXISTS) {
+            formula = PresburgerFormula::exists(pending[i].variable, std::move(formula));
+        } else {
+            std::vector<std::unique_ptr<PresburgerFormula>> formulas;
+            for (size_t operand = first; operand <= i; ++operand) {
+                formulas.push_back(std::move(pending[operand].left));
+            }
+            formulas.push_back(std::move(formula));
+            formula = type == PresburgerFormula::AND ? PresburgerFormula::and_formula(std::move(formulas))
+                                                     : PresburgerFormula::or_formula(std::move(formulas));
+        }
+        i = first;
     }
-    
+    return formula;
+}
+
+std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_atomic_formula(const std::string& cleaned) const {
     // Parse modulus constraints: expr%m==r or expr mod m == r
     auto mod_pos = cleaned.find("mod");
     if (mod_pos != std::string::npos) {
@@ -332,24 +698,7 @@ std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_constraint(cons
     );
 }
 
-std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_existential_formula(const std::string& formula_str) {
-    // Extract variable name and inner formula
-    // Support both 'exists x: ...' and 'exists x. ...' syntax
-    std::regex exists_pattern(R"(exists(\w+)[:.]\s*(.+))");
-    std::smatch match;
-    
-    if (std::regex_match(formula_str, match, exists_pattern)) {
-        std::string var_name = match[1].str();
-        std::string inner_formula_str = match[2].str();
-        auto inner_formula = parse_constraint(inner_formula_str);
-        return PresburgerFormula::exists(var_name, std::move(inner_formula));
-    }
-    
-    // Default fallback
-    return PresburgerFormula::equal(PresburgerTerm(1), PresburgerTerm(1));
-}
-
-std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_comparison_formula(const std::string& formula_str, const std::string& op, size_t pos) {
+std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_comparison_formula(const std::string& formula_str, const std::string& op, size_t pos) const {
     std::string left_str = formula_str.substr(0, pos);
     std::string right_str = formula_str.substr(pos + op.length());
     
@@ -375,29 +724,7 @@ std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_comparison_form
     }
 }
 
-std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_logical_formula(const std::string& formula_str, const std::string& op, size_t pos) {
-    std::string left_str = formula_str.substr(0, pos);
-    std::string right_str = formula_str.substr(pos + op.length());
-    
-    auto left_formula = parse_constraint(left_str);
-    auto right_formula = parse_constraint(right_str);
-    
-    if (op == "&&") {
-        std::vector<std::unique_ptr<PresburgerFormula>> formulas;
-        formulas.push_back(std::move(left_formula));
-        formulas.push_back(std::move(right_formula));
-        return PresburgerFormula::and_formula(std::move(formulas));
-    } else if (op == "||") {
-        std::vector<std::unique_ptr<PresburgerFormula>> formulas;
-        formulas.push_back(std::move(left_formula));
-        formulas.push_back(std::move(right_formula));
-        return PresburgerFormula::or_formula(std::move(formulas));
-    }
-    
-    return PresburgerFormula::equal(PresburgerTerm(1), PresburgerTerm(1));
-}
-
-std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_modulus_constraint(const std::string& formula_str, size_t mod_pos) {
+std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_modulus_constraint(const std::string& formula_str, size_t mod_pos) const {
     // Parse expressions like "expr mod m == r"
     std::string expr_str = formula_str.substr(0, mod_pos);
     std::string remainder_str = formula_str.substr(mod_pos + 3); // skip "mod"
@@ -418,7 +745,7 @@ std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_modulus_constra
     return PresburgerFormula::modulus(*expr_term, modulus, result);
 }
 
-std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_percent_modulus_constraint(const std::string& formula_str, size_t percent_pos) {
+std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_percent_modulus_constraint(const std::string& formula_str, size_t percent_pos) const {
     // Parse expressions like "expr%m==r"
     std::string expr_str = formula_str.substr(0, percent_pos);
     std::string remainder_str = formula_str.substr(percent_pos + 1); // skip "%"
@@ -439,7 +766,7 @@ std::unique_ptr<PresburgerFormula> GGGTemporalGameManager::parse_percent_modulus
     return PresburgerFormula::modulus(*expr_term, modulus, result);
 }
 
-std::unique_ptr<PresburgerTerm> GGGTemporalGameManager::parse_presburger_term(const std::string& term_str) {
+std::unique_ptr<PresburgerTerm> GGGTemporalGameManager::parse_presburger_term(const std::string& term_str) const {
     // Handle simple constant
     if (std::all_of(term_str.begin(), term_str.end(), [](char c) { return std::isdigit(c) || c == '-'; })) {
         return std::make_unique<PresburgerTerm>(std::stoi(term_str));
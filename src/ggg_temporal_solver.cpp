@@ -1,7 +1,13 @@
 #include "ggg_temporal_solver.hpp"
+#include "component_solver.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "probes.hpp"
+#include "trace.hpp"
 #include <boost/graph/graph_traits.hpp>
 #include <iostream>
 #include <algorithm>
+#include <mutex>
 
 namespace ggg {
 namespace solvers {
@@ -11,6 +17,35 @@ GGGTemporalReachabilitySolver::GGGTemporalReachabilitySolver(
     std::shared_ptr<graphs::GGGReachabilityObjective> objective,
     int max_time, bool verbose)
     : manager_(manager), objective_(objective), max_time_(max_time), verbose_(verbose) {
+    refresh_final_layer();
+}
+
+void GGGTemporalReachabilitySolver::refresh_final_layer() {
+    final_targets_ = manager_->targets_at(objective_->get_targets(), max_time_);
+    final_layer_ = LayerSet::from_sorted(boost::num_vertices(*manager_->graph()),
+                                         final_targets_.begin(), final_targets_.end(), layer_dense_ratio_);
+}
+
+void GGGTemporalReachabilitySolver::prepare_activity_index() {
+    activity_cursor_.reset();
+    activity_index_.reset();
+    if (!use_activity_index_ || max_time_ <= 0) {
+        return;
+    }
+    TEMPORIS_TRACE_SCOPE("activity_index");
+    activity_index_ = VertexActivityIndex::build(*manager_, max_time_);
+    stats_.activity = activity_index_->get_statistics();
+    if (!activity_index_->worthwhile()) {
+        activity_index_.reset();
+        return;
+    }
+    stats_.activity_index = true;
+    activity_cursor_ = std::make_unique<VertexActivityIndex::Cursor>(*activity_index_);
+    
+    if (verbose_) {
+        std::cout << "Activity index: " << stats_.activity.windows << " windows, vertices active in "
+                  << stats_.activity.coverage() * 100.0 << "% of the layers\n";
+    }
 }
 
 std::string GGGTemporalReachabilitySolver::get_name() const {
@@ -18,22 +53,35 @@ std::string GGGTemporalReachabilitySolver::get_name() const {
 }
 
 GGGTemporalReachabilitySolver::SolutionType GGGTemporalReachabilitySolver::solve(const GraphType& graph) {
+    TEMPORIS_TRACE_SCOPE("backwards_solve");
+    perf::ScopedPerfPhase perf_phase("solve");
+    
     // Reset statistics for this solve
     stats_.reset();
     auto solve_start = std::chrono::high_resolution_clock::now();
     
+    // Target constraints are evaluated once, at the final time
+    refresh_final_layer();
+    
     // Compute backwards temporal attractor
-    std::set<Vertex> player0_winning = compute_backwards_temporal_attractor();
+    bool fast_path = single_player_fast_path_ && !layer_series_ && SinglePlayerReachability::applies(graph);
+    LayerSet player0_winning = fast_path ? compute_single_player_attractor()
+                             : speculation_ && !layer_series_ ? compute_speculative_attractor()
+                                                              : compute_backwards_temporal_attractor();
     
     // Build solution
+    TEMPORIS_TRACE_SCOPE("build_solution");
+    perf::ScopedPerfPhase build_phase("build_solution");
+    auto solution_start = std::chrono::high_resolution_clock::now();
     SolutionType solution;
+    size_t strategies = 0;
     
     // Set winning regions
     auto [vertex_begin, vertex_end] = boost::vertices(graph);
     for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
         Vertex vertex = *vertex_it;
         
-        if (player0_winning.find(vertex) != player0_winning.end()) {
+        if (player0_winning.contains(static_cast<uint32_t>(vertex))) {
             solution.set_winning_player(vertex, 0);
             
             // Build strategy: find the time when Player 0 should make a move
@@ -46,6 +94,7 @@ GGGTemporalReachabilitySolver::SolutionType GGGTemporalReachabilitySolver::solve
                     // Pick the first available move (could be improved with better heuristics)
                     solution.set_strategy(vertex, moves[0]);
                     strategy_found = true;
+                    ++strategies;
                 }
             }
             // If no strategy found, don't set any strategy (indicates staying/no moves)
@@ -54,127 +103,127 @@ GGGTemporalReachabilitySolver::SolutionType GGGTemporalReachabilitySolver::solve
         }
     }
     
+    stats_.solution_bytes = memory::solution_bytes<Vertex>(boost::num_vertices(graph), strategies);
+    
     // Record total solve time
     auto solve_end = std::chrono::high_resolution_clock::now();
+    stats_.solution_time = solve_end - solution_start;
     stats_.total_solve_time = solve_end - solve_start;
     
     return solution;
 }
 
 GGGTemporalReachabilitySolver::SolutionType GGGTemporalReachabilitySolver::solve_from_state(Vertex initial_vertex, int initial_time) {
-    // For backwards attractor, just solve the entire game and extract result for this vertex
-    return solve(*manager_->graph());
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "solve_from_state");
+    const auto& graph = *manager_->graph();
+    
+    // The winner of a vertex only depends on what it can reach
+    std::vector<bool> reached(boost::num_vertices(graph), false);
+    std::vector<Vertex> reachable = {initial_vertex};
+    reached[initial_vertex] = true;
+    for (size_t next = 0; next < reachable.size(); ++next) {
+        auto [edge_begin, edge_end] = boost::out_edges(reachable[next], graph);
+        for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+            Vertex target = boost::target(*edge_it, graph);
+            if (!reached[target]) {
+                reached[target] = true;
+                reachable.push_back(target);
+            }
+        }
+    }
+    std::sort(reachable.begin(), reachable.end());
+    TEMPORIS_TRACE_ARG(trace_scope, "reachable_vertices", reachable.size());
+    
+    // For backwards attractor, just solve the reachable part and extract the result for it
+    SubGame sub = ComponentSolver::extract(*manager_, *objective_, reachable);
+    GGGTemporalReachabilitySolver part(sub.manager, sub.objective, max_time_, verbose_);
+    part.set_single_player_fast_path(single_player_fast_path_);
+    part.set_window_mode(window_mode_);
+    part.set_layer_series(layer_series_);
+    part.set_layer_dense_ratio(layer_dense_ratio_);
+    part.set_speculation(speculation_);
+    part.set_activity_index(use_activity_index_);
+    auto part_solution = part.solve(*sub.manager->graph());
+    stats_ = part.get_statistics();
+    
+    SolutionType solution;
+    for (size_t local = 0; local < reachable.size(); ++local) {
+        solution.set_winning_player(reachable[local], part_solution.get_winning_player(local));
+        if (part_solution.has_strategy(local)) {
+            solution.set_strategy(reachable[local], reachable[part_solution.get_strategy(local)]);
+        }
+    }
+    return solution;
 }
 
-std::set<GGGTemporalReachabilitySolver::Vertex> GGGTemporalReachabilitySolver::compute_backwards_temporal_attractor() {
+LayerSet GGGTemporalReachabilitySolver::compute_backwards_temporal_attractor() {
+    TEMPORIS_TRACE_SCOPE("backwards_attractor");
+    perf::ScopedPerfPhase perf_phase("backwards_attractor");
+    
     // Time the graph traversal
     auto traversal_start = std::chrono::high_resolution_clock::now();
     
     // Start with empty attractor for punctual reachability
     // In punctual reachability, vertices must be actively reachable through gameplay
-    std::set<Vertex> current_attractor;
-    
-    auto [vertex_begin, vertex_end] = boost::vertices(*manager_->graph());
+    LayerSet current_attractor(boost::num_vertices(*manager_->graph()), layer_dense_ratio_);
+    prepare_activity_index();
     
     if (verbose_) {
         std::cout << "Starting backwards attractor from time " << max_time_ 
                   << " with empty initial attractor (punctual reachability)\n";
     }
     
+    // Layers are traced in blocks so long horizons keep the trace readable
+    auto& tracer = trace::Tracer::instance();
+    const int trace_block = std::max(1, max_time_ / kMaxTracedLayerBlocks);
+    int64_t block_start_ns = tracer.enabled() ? tracer.now_ns() : 0;
+    int block_layers = 0;
+    
+    if (layer_series_) {
+        layer_series_->clear();
+    }
+    
     // Work backwards from max_time to 0
     for (int time = max_time_ - 1; time >= 0; --time) {
         stats_.states_explored++;
         
-        std::set<Vertex> new_attractor;
+        auto layer_start = layer_series_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+        size_t checks_before = stats_.edge_constraint_checks;
+        TEMPORIS_PROBE2(layer__start, time, current_attractor.size());
         
-        // For each vertex, check if it should be in the attractor at this time
-        for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
-            Vertex vertex = *vertex_it;
-            
-            // Get available moves from this vertex at this time
-            std::vector<Vertex> moves = manager_->get_available_moves(vertex, time);
-            stats_.constraint_evaluations++;
-            
-            if (moves.empty()) {
-                // No moves available - in punctual reachability, this means the player
-                // cannot actively reach the target set through gameplay, so this vertex
-                // should NOT be in the attractor (even if it's a target vertex)
-                stats_.constraint_failures++;
-                continue;
-            }
-            stats_.constraint_passes++;
-            
-            int player = (*manager_->graph())[vertex].player;
-            
-            // Special case: if we're at max_time-1, check if moves lead to targets
-            if (time == max_time_ - 1) {
-                if (player == 0) {
-                    // Player 0: needs at least one move to a target
-                    bool has_move_to_target = false;
-                    for (auto move : moves) {
-                        if (objective_->is_target(move)) {
-                            has_move_to_target = true;
-                            break;
-                        }
-                    }
-                    if (has_move_to_target) {
-                        new_attractor.insert(vertex);
-                    }
-                } else {
-                    // Player 1: all moves must lead to targets (for this to help Player 0)
-                    bool all_moves_to_targets = true;
-                    for (auto move : moves) {
-                        if (!objective_->is_target(move)) {
-                            all_moves_to_targets = false;
-                            break;
-                        }
-                    }
-                    if (all_moves_to_targets) {
-                        new_attractor.insert(vertex);
-                    }
-                }
-            } else {
-                // Standard attractor computation for earlier times
-                if (player == 0) {
-                    // Player 0 (existential): needs AT LEAST ONE edge to current attractor
-                    bool has_edge_to_attractor = false;
-                    for (auto move : moves) {
-                        if (current_attractor.find(move) != current_attractor.end()) {
-                            has_edge_to_attractor = true;
-                            break;
-                        }
-                    }
-                    if (has_edge_to_attractor) {
-                        new_attractor.insert(vertex);
-                    }
-                } else {
-                    // Player 1 (universal): needs ALL EDGES to go to current attractor
-                    bool all_edges_to_attractor = true;
-                    for (auto move : moves) {
-                        if (current_attractor.find(move) == current_attractor.end()) {
-                            all_edges_to_attractor = false;
-                            break;
-                        }
-                    }
-                    if (all_edges_to_attractor) {
-                        new_attractor.insert(vertex);
-                    }
-                }
-            }
+        LayerSet new_attractor = compute_attractor_layer(time, current_attractor);
+        (new_attractor.dense() ? stats_.dense_layers : stats_.sparse_layers)++;
+        stats_.layer_conversions += new_attractor.conversions();
+        TEMPORIS_PROBE4(layer__done, time, new_attractor.size(), move_targets_.size(),
+                        stats_.edge_constraint_checks - checks_before);
+        
+        if (layer_series_) {
+            layer_series_->add_layer(time, new_attractor.size(), move_targets_.size(),
+                                     stats_.edge_constraint_checks - checks_before,
+                                     std::chrono::steady_clock::now() - layer_start);
         }
         
+        // Both layers and the move buffers are live at this point
+        stats_.peak_layer_bytes = std::max(stats_.peak_layer_bytes,
+            current_attractor.memory_bytes() + new_attractor.memory_bytes() +
+            memory::container_bytes(move_offsets_) + memory::container_bytes(move_targets_));
+        
         // Update current attractor (non-monotonic: replace, don't union)
-        current_attractor = new_attractor;
+        current_attractor = std::move(new_attractor);
+        
+        ++block_layers;
+        if (tracer.enabled() && (time % trace_block == 0)) {
+            int64_t block_end_ns = tracer.now_ns();
+            tracer.record({"layers", "layer", block_start_ns, block_end_ns - block_start_ns,
+                           {{"first_time", time}, {"layers", block_layers},
+                            {"attractor_size", static_cast<int64_t>(current_attractor.size())}}});
+            block_start_ns = block_end_ns;
+            block_layers = 0;
+        }
         
         if (verbose_) {
-            std::cout << "Time " << time << ": attractor has " << current_attractor.size() << " vertices: {";
-            bool first = true;
-            for (auto vertex : current_attractor) {
-                if (!first) std::cout << ", ";
-                std::cout << (*manager_->graph())[vertex].name;
-                first = false;
-            }
-            std::cout << "}\n";
+            std::cout << "Time " << time << ": attractor has " << current_attractor.size() << " vertices: ";
+            print_layer(current_attractor);
         }
     }
     
@@ -183,17 +232,178 @@ std::set<GGGTemporalReachabilitySolver::Vertex> GGGTemporalReachabilitySolver::c
     stats_.graph_traversal_time += (traversal_end - traversal_start);
     
     if (verbose_) {
-        std::cout << "Final attractor at time 0 has " << current_attractor.size() << " vertices: {";
-        bool first = true;
-        for (auto vertex : current_attractor) {
-            if (!first) std::cout << ", ";
+        std::cout << "Final attractor at time 0 has " << current_attractor.size() << " vertices: ";
+        print_layer(current_attractor);
+    }
+    
+    return current_attractor;
+}
+
+LayerSet GGGTemporalReachabilitySolver::compute_single_player_attractor() {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "single_player_attractor");
+    perf::ScopedPerfPhase perf_phase("backwards_attractor");
+    auto traversal_start = std::chrono::high_resolution_clock::now();
+    
+    if (verbose_) {
+        std::cout << "No Player 1 choices: solving as temporal graph reachability over "
+                  << max_time_ << " time steps\n";
+    }
+    
+    SinglePlayerReachability engine(manager_, max_time_);
+    engine.set_window_mode(window_mode_);
+    std::set<Vertex> winning = engine.solve(final_targets_, stats_.edge_constraint_checks);
+    
+    stats_.single_player_fast_path = true;
+    stats_.single_player = engine.get_statistics();
+    stats_.states_explored = static_cast<size_t>(std::max(0, max_time_));
+    stats_.graph_traversal_time += std::chrono::high_resolution_clock::now() - traversal_start;
+    TEMPORIS_TRACE_ARG(trace_scope, "windows", stats_.single_player.constant_windows);
+    TEMPORIS_TRACE_ARG(trace_scope, "matrix_power_windows", stats_.single_player.matrix_power_windows);
+    
+    if (verbose_) {
+        std::cout << "Constant-availability windows: " << stats_.single_player.constant_windows
+                  << " (" << stats_.single_player.matrix_power_windows << " by repeated squaring)\n";
+        std::cout << "Final attractor at time 0 has " << winning.size() << " vertices: ";
+    }
+    
+    LayerSet layer = LayerSet::from_sorted(boost::num_vertices(*manager_->graph()), winning.begin(), winning.end(),
+                                           layer_dense_ratio_);
+    if (verbose_) {
+        print_layer(layer);
+    }
+    return layer;
+}
+
+LayerSet GGGTemporalReachabilitySolver::compute_speculative_attractor() {
+    TEMPORIS_TRACE_SCOPE("speculative_attractor");
+    perf::ScopedPerfPhase perf_phase("backwards_attractor");
+    auto traversal_start = std::chrono::high_resolution_clock::now();
+    
+    if (verbose_) {
+        std::cout << "Starting speculative backwards attractor from time " << max_time_ << "\n";
+    }
+    
+    prepare_activity_index();
+    
+    // Every thread steps layers on its own solver, for its own move buffers, statistics and activity cursor
+    std::mutex workers_mutex;
+    std::vector<std::unique_ptr<GGGTemporalReachabilitySolver>> workers;
+    auto make_step = [&]() -> SpeculativeSweep::LayerStep {
+        auto worker = std::make_unique<GGGTemporalReachabilitySolver>(manager_, objective_, max_time_, false);
+        worker->set_layer_dense_ratio(layer_dense_ratio_);
+        if (activity_index_) {
+            worker->activity_index_ = activity_index_;
+            worker->activity_cursor_ = std::make_unique<VertexActivityIndex::Cursor>(*activity_index_);
+        }
+        GGGTemporalReachabilitySolver* solver = worker.get();
+        std::lock_guard<std::mutex> lock(workers_mutex);
+        workers.push_back(std::move(worker));
+        return [solver](int time, const LayerSet& next) { return solver->compute_attractor_layer(time, next); };
+    };
+    LayerSet winning = speculation_->run(max_time_, final_layer_, make_step);
+    
+    for (const auto& worker : workers) {
+        stats_.accumulate(worker->get_statistics());
+    }
+    const auto& speculation = speculation_->get_statistics();
+    stats_.states_explored = speculation.probe_layers + speculation.warmup_layers + speculation.speculative_layers +
+                             speculation.recomputed_layers;
+    stats_.graph_traversal_time += std::chrono::high_resolution_clock::now() - traversal_start;
+    
+    if (verbose_) {
+        std::cout << "Final attractor at time 0 has " << winning.size() << " vertices: ";
+        print_layer(winning);
+    }
+    return winning;
+}
+
+void GGGTemporalReachabilitySolver::print_layer(const LayerSet& layer) const {
+    std::cout << "{";
+    size_t printed = 0;
+    layer.for_each([&](uint32_t vertex) {
+        if (printed > kMaxVerboseLayerNames) {
+            return;
+        }
+        if (printed == kMaxVerboseLayerNames) {
+            std::cout << ", ... (" << layer.size() - printed << " more)";
+        } else {
+            if (printed > 0) std::cout << ", ";
             std::cout << (*manager_->graph())[vertex].name;
-            first = false;
         }
-        std::cout << "}\n";
+        ++printed;
+    });
+    std::cout << "}\n";
+}
+
+LayerSet GGGTemporalReachabilitySolver::compute_attractor_layer(int time, const LayerSet& current_attractor) {
+    const auto& graph = *manager_->graph();
+    
+    // Vertices without an out-edge that can be enabled at this time never join the layer
+    const size_t vertex_count = boost::num_vertices(graph);
+    const std::vector<uint32_t>* active = activity_cursor_ ? &activity_cursor_->at(time) : nullptr;
+    const size_t candidates = active ? active->size() : vertex_count;
+    auto candidate = [&](size_t index) -> Vertex { return active ? (*active)[index] : index; };
+    // Skipped vertices count as evaluated without a move, as in a sweep that visits them
+    const size_t idle = vertex_count - candidates;
+    stats_.idle_vertex_layers += idle;
+    stats_.constraint_evaluations += idle;
+    stats_.constraint_failures += idle;
+    
+    // Phase 1: evaluate edge constraints to collect the moves enabled at this time
+    auto eval_start = std::chrono::high_resolution_clock::now();
+    move_offsets_.clear();
+    move_targets_.clear();
+    for (size_t index = 0; index < candidates; ++index) {
+        Vertex vertex = candidate(index);
+        move_offsets_.push_back(move_targets_.size());
+        stats_.edge_constraint_checks += boost::out_degree(vertex, graph);
+        auto [edge_begin, edge_end] = boost::out_edges(vertex, graph);
+        for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+            if (manager_->is_edge_constraint_satisfied(*edge_it, time)) {
+                move_targets_.push_back(boost::target(*edge_it, graph));
+            }
+        }
     }
+    move_offsets_.push_back(move_targets_.size());
+    stats_.constraint_eval_time += std::chrono::high_resolution_clock::now() - eval_start;
     
-    return current_attractor;
+    // Phase 2: decide attractor membership from the enabled moves
+    // At max_time-1 moves must lead to targets, earlier they must lead into the next layer
+    const LayerSet& next_layer = time == max_time_ - 1 ? final_layer_ : current_attractor;
+    LayerSet new_attractor(vertex_count, layer_dense_ratio_);
+    
+    for (size_t index = 0; index < candidates; ++index) {
+        Vertex vertex = candidate(index);
+        auto moves_begin = move_targets_.begin() + move_offsets_[index];
+        auto moves_end = move_targets_.begin() + move_offsets_[index + 1];
+        stats_.constraint_evaluations++;
+        
+        if (moves_begin == moves_end) {
+            // No moves available - in punctual reachability, this means the player
+            // cannot actively reach the target set through gameplay, so this vertex
+            // should NOT be in the attractor (even if it's a target vertex)
+            stats_.constraint_failures++;
+            continue;
+        }
+        stats_.constraint_passes++;
+        
+        int player = graph[vertex].player;
+        
+        if (player == 0) {
+            // Player 0 (existential): needs AT LEAST ONE move into the next layer
+            if (next_layer.contains_any(moves_begin, moves_end)) {
+                new_attractor.push_back(static_cast<uint32_t>(vertex));
+            }
+        } else {
+            // Player 1 (universal): needs ALL moves to go into the next layer
+            if (next_layer.contains_all(moves_begin, moves_end)) {
+                new_attractor.push_back(static_cast<uint32_t>(vertex));
+            }
+        }
+    }
+    
+    new_attractor.shrink();
+    return new_attractor;
 }
 
 // TemporalReachabilitySolution implementation
@@ -0,0 +1,157 @@
+#include "lane_batch_solver.hpp"
+#include "trace.hpp"
+#include <boost/graph/graph_traits.hpp>
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+namespace ggg {
+namespace solvers {
+
+std::optional<TinyGame> TinyGame::reduce(const graphs::GGGTemporalGameManager& manager,
+                                         const graphs::GGGReachabilityObjective& objective, int time_bound) {
+    const auto& graph = *manager.graph();
+    auto index = boost::get(boost::vertex_index, graph);
+    size_t vertex_count = boost::num_vertices(graph);
+    if (vertex_count > static_cast<size_t>(kMaxVertices)) {
+        return std::nullopt;
+    }
+
+    TinyGame game;
+    game.vertices = static_cast<int>(vertex_count);
+    game.time_bound = std::max(0, time_bound);
+    auto [vertex_begin, vertex_end] = boost::vertices(graph);
+    for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+        uint64_t bit = uint64_t{1} << index[*vertex_it];
+        if (graph[*vertex_it].player == 0) {
+            game.player0 |= bit;
+        }
+    }
+    for (auto target : manager.targets_at(objective.get_targets(), game.time_bound)) {
+        game.final_targets |= uint64_t{1} << index[target];
+    }
+
+    // Same availability as is_edge_constraint_satisfied, with one constraint lookup per edge
+    game.successors.assign(static_cast<size_t>(game.time_bound) * vertex_count, 0);
+    std::map<std::string, int> variables = {{"time", 0}};
+    int& time_value = variables["time"];
+    auto [edge_begin, edge_end] = boost::edges(graph);
+    for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+        size_t source = index[boost::source(*edge_it, graph)];
+        uint64_t target_bit = uint64_t{1} << index[boost::target(*edge_it, graph)];
+        auto compiled = manager.compiled_constraint(*edge_it);
+        auto formula = compiled ? nullptr : manager.edge_constraint(*edge_it);
+        for (int time = 0; time < game.time_bound; ++time) {
+            bool enabled = true;
+            if (compiled) {
+                enabled = compiled(time);
+            } else if (formula) {
+                time_value = time;
+                try {
+                    enabled = formula->evaluate(variables);
+                } catch (const std::exception&) {
+                    enabled = false;
+                }
+            }
+            if (enabled) {
+                game.successors[static_cast<size_t>(time) * vertex_count + source] |= target_bit;
+            }
+        }
+    }
+    return game;
+}
+
+double LaneBatchStatistics::lane_occupancy() const {
+    size_t lanes = batches * LaneBatchSolver::kLanes;
+    return lanes > 0 ? static_cast<double>(lanes - padded_lanes) / static_cast<double>(lanes) : 0.0;
+}
+
+double LaneBatchStatistics::games_per_second() const {
+    double seconds = (pack_time + solve_time).count();
+    return seconds > 0.0 ? static_cast<double>(games) / seconds : 0.0;
+}
+
+std::vector<uint64_t> LaneBatchSolver::solve(const std::vector<TinyGame>& games) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "lane_batch_solve");
+    stats_ = LaneBatchStatistics{};
+    stats_.games = games.size();
+    std::vector<uint64_t> winning(games.size(), 0);
+
+    // Only games with the same horizon share a batch
+    std::vector<size_t> order(games.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return games[a].time_bound < games[b].time_bound; });
+
+    std::vector<const TinyGame*> lanes;
+    std::vector<uint64_t> lane_winning;
+    for (size_t first = 0; first < order.size();) {
+        size_t last = first;
+        lanes.clear();
+        while (last < order.size() && lanes.size() < kLanes &&
+               games[order[last]].time_bound == games[order[first]].time_bound) {
+            lanes.push_back(&games[order[last]]);
+            ++last;
+        }
+        solve_batch(lanes, lane_winning);
+        for (size_t lane = 0; lane < lanes.size(); ++lane) {
+            winning[order[first + lane]] = lane_winning[lane];
+        }
+        stats_.batches++;
+        stats_.padded_lanes += kLanes - lanes.size();
+        first = last;
+    }
+    TEMPORIS_TRACE_ARG(trace_scope, "batches", stats_.batches);
+    return winning;
+}
+
+void LaneBatchSolver::solve_batch(const std::vector<const TinyGame*>& lanes, std::vector<uint64_t>& winning) {
+    auto pack_start = std::chrono::steady_clock::now();
+    const int time_bound = lanes.front()->time_bound;
+    size_t width = 0;
+    for (const TinyGame* game : lanes) {
+        width = std::max(width, static_cast<size_t>(game->vertices));
+    }
+
+    // Row (t, v) holds the successor masks of vertex v at time t for every lane
+    alignas(64) uint64_t player0[kLanes] = {};
+    alignas(64) uint64_t next[kLanes] = {};
+    alignas(64) uint64_t layer[kLanes];
+    packed_.assign(static_cast<size_t>(time_bound) * width * kLanes, 0);
+    for (size_t lane = 0; lane < lanes.size(); ++lane) {
+        const TinyGame& game = *lanes[lane];
+        size_t vertices = static_cast<size_t>(game.vertices);
+        player0[lane] = game.player0;
+        next[lane] = game.final_targets;
+        for (size_t time = 0; time < static_cast<size_t>(time_bound); ++time) {
+            for (size_t v = 0; v < vertices; ++v) {
+                packed_[(time * width + v) * kLanes + lane] = game.successors[time * vertices + v];
+            }
+        }
+    }
+    auto solve_start = std::chrono::steady_clock::now();
+    stats_.pack_time += solve_start - pack_start;
+
+    for (int time = time_bound - 1; time >= 0; --time) {
+        const uint64_t* row = packed_.data() + static_cast<size_t>(time) * width * kLanes;
+        std::fill(layer, layer + kLanes, 0);
+        for (size_t v = 0; v < width; ++v, row += kLanes) {
+            const uint64_t bit = uint64_t{1} << v;
+            // Fixed trip count and no branches, so the lane loop is unrolled and vectorized
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                uint64_t successors = row[lane];
+                uint64_t any = uint64_t{0} - static_cast<uint64_t>((successors & next[lane]) != 0);
+                uint64_t all = uint64_t{0} - static_cast<uint64_t>((successors != 0) &
+                                                                   ((successors & ~next[lane]) == 0));
+                layer[lane] |= bit & ((player0[lane] & any) | (~player0[lane] & all));
+            }
+        }
+        std::copy(layer, layer + kLanes, next);
+    }
+
+    winning.assign(next, next + lanes.size());
+    stats_.solve_time += std::chrono::steady_clock::now() - solve_start;
+}
+
+} // namespace solvers
+} // namespace ggg
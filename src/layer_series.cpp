@@ -0,0 +1,84 @@
+#include "layer_series.hpp"
+#include <algorithm>
+#include <fstream>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+template<typename T>
+void write_le(std::ostream& out, T value) {
+    unsigned char bytes[sizeof(T)];
+    auto raw = static_cast<uint64_t>(value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<unsigned char>(raw >> (8 * i));
+    }
+    out.write(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+} // namespace
+
+LayerSeries::LayerSeries(int sample_every) : sample_every_(std::max(1, sample_every)) {
+}
+
+void LayerSeries::clear() {
+    pending_ = LayerSample{};
+    samples_.clear();
+}
+
+void LayerSeries::add_layer(int time, size_t attractor_size, size_t enabled_edges,
+                            size_t constraint_evaluations, std::chrono::nanoseconds elapsed) {
+    pending_.time = time;
+    pending_.layers++;
+    pending_.attractor_size = attractor_size;
+    pending_.enabled_edges += enabled_edges;
+    pending_.constraint_evaluations += constraint_evaluations;
+    pending_.elapsed_ns += static_cast<uint64_t>(elapsed.count());
+
+    // The sweep ends at time 0, which always closes the last block
+    if (time % sample_every_ == 0) {
+        samples_.push_back(pending_);
+        pending_ = LayerSample{};
+    }
+}
+
+void LayerSeries::write_csv(std::ostream& out) const {
+    out << "time,layers,attractor_size,enabled_edges,constraint_evaluations,elapsed_ns\n";
+    for (const auto& sample : samples_) {
+        out << sample.time << "," << sample.layers << "," << sample.attractor_size << ","
+            << sample.enabled_edges << "," << sample.constraint_evaluations << ","
+            << sample.elapsed_ns << "\n";
+    }
+}
+
+void LayerSeries::write_binary(std::ostream& out) const {
+    out.write("TLS1", 4);
+    write_le<uint32_t>(out, static_cast<uint32_t>(sample_every_));
+    write_le<uint64_t>(out, samples_.size());
+    for (const auto& sample : samples_) {
+        write_le<uint32_t>(out, static_cast<uint32_t>(sample.time));
+        write_le<uint32_t>(out, sample.layers);
+        write_le<uint64_t>(out, sample.attractor_size);
+        write_le<uint64_t>(out, sample.enabled_edges);
+        write_le<uint64_t>(out, sample.constraint_evaluations);
+        write_le<uint64_t>(out, sample.elapsed_ns);
+    }
+}
+
+bool LayerSeries::write(const std::string& file) const {
+    bool binary = file.size() >= 4 && file.compare(file.size() - 4, 4, ".bin") == 0;
+    std::ofstream out(file, binary ? std::ios::binary : std::ios::out);
+    if (!out.is_open()) {
+        return false;
+    }
+    if (binary) {
+        write_binary(out);
+    } else {
+        write_csv(out);
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace solvers
+} // namespace ggg
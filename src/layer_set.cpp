@@ -0,0 +1,56 @@
+#include "layer_set.hpp"
+
+namespace ggg {
+namespace solvers {
+
+void LayerSet::clear(size_t universe) {
+    universe_ = universe;
+    size_ = 0;
+    dense_ = false;
+    sparse_.clear();
+    bits_.clear();
+    conversions_ = 0;
+}
+
+void LayerSet::to_dense() {
+    bits_.assign((universe_ + 63) / 64, 0);
+    for (uint32_t vertex : sparse_) {
+        bits_[vertex >> 6] |= uint64_t{1} << (vertex & 63);
+    }
+    sparse_.clear();
+    dense_ = true;
+    conversions_++;
+}
+
+void LayerSet::to_sparse() {
+    sparse_.clear();
+    sparse_.reserve(size_);
+    for (size_t word = 0; word < bits_.size(); ++word) {
+        for (uint64_t bits = bits_[word]; bits != 0; bits &= bits - 1) {
+            sparse_.push_back(static_cast<uint32_t>(word * 64 + static_cast<size_t>(std::countr_zero(bits))));
+        }
+    }
+    bits_.clear();
+    dense_ = false;
+    conversions_++;
+}
+
+bool LayerSet::operator==(const LayerSet& other) const {
+    if (size_ != other.size_ || universe_ != other.universe_) {
+        return false;
+    }
+    if (dense_ == other.dense_) {
+        return dense_ ? bits_ == other.bits_ : sparse_ == other.sparse_;
+    }
+    const LayerSet& sparse = dense_ ? other : *this;
+    const LayerSet& dense = dense_ ? *this : other;
+    return std::all_of(sparse.sparse_.begin(), sparse.sparse_.end(),
+                       [&](uint32_t vertex) { return dense.dense_contains(vertex); });
+}
+
+size_t LayerSet::memory_bytes() const {
+    return sizeof(*this) + sparse_.capacity() * sizeof(uint32_t) + bits_.capacity() * sizeof(uint64_t);
+}
+
+} // namespace solvers
+} // namespace ggg
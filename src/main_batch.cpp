@@ -0,0 +1,324 @@
+#include "ggg_temporal_graph.hpp"
+#include "ggg_temporal_solver.hpp"
+#include "lane_batch_solver.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Simple logging helpers for temporis_batch
+namespace {
+    bool g_verbose = false;
+
+    template<typename... Args>
+    void log_error(Args... args) {
+        std::cerr << "[ERROR] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+
+    template<typename... Args>
+    void log_info(Args... args) {
+        if (g_verbose) {
+            std::cerr << "[INFO] ";
+            ((std::cerr << args), ...);
+            std::cerr << std::endl;
+        }
+    }
+
+    // Same "// time_bound: N" comment the solvers read
+    int extract_time_bound(const std::string& content) {
+        size_t pos = content.find("// time_bound:");
+        if (pos == std::string::npos) {
+            return -1;
+        }
+        std::istringstream iss(content.substr(pos + 14, 32));
+        int time_bound;
+        return (iss >> time_bound && time_bound > 0) ? time_bound : -1;
+    }
+}
+
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
+/**
+ * @brief Solves many games in one process, packing tiny games into SIMD lanes
+ */
+class BatchExecutor {
+private:
+    enum class Engine { LANES, SCALAR };
+
+    struct GameResult {
+        std::string file;
+        size_t vertices = 0;
+        int time_bound = 0;
+        bool lanes = false;
+        std::vector<std::string> names;   // vertex names by index
+        std::vector<std::string> winning;
+    };
+
+    std::vector<std::string> files_;
+    std::string output_file_;
+    int time_bound_ = -1;
+    Engine engine_ = Engine::LANES;
+
+    std::vector<GameResult> results_;
+    std::chrono::duration<double> load_time_{0};
+    std::chrono::duration<double> reduce_time_{0};
+    std::chrono::duration<double> scalar_time_{0};
+    size_t scalar_games_ = 0;
+
+    bool add_list(const std::string& list_file) {
+        std::ifstream input(list_file);
+        if (!input) {
+            log_error("Cannot open list file: ", list_file);
+            return false;
+        }
+        std::string line;
+        while (std::getline(input, line)) {
+            if (!line.empty() && line[0] != '#') {
+                files_.push_back(line);
+            }
+        }
+        return true;
+    }
+
+    // Directories contribute their .dot files in name order
+    void add_path(const std::string& path) {
+        if (!std::filesystem::is_directory(path)) {
+            files_.push_back(path);
+            return;
+        }
+        std::vector<std::string> dot_files;
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".dot") {
+                dot_files.push_back(entry.path().string());
+            }
+        }
+        std::sort(dot_files.begin(), dot_files.end());
+        files_.insert(files_.end(), dot_files.begin(), dot_files.end());
+    }
+
+public:
+    ParseResult parse_arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            std::string value;
+            auto next_value = [&]() {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+
+            try {
+                if (arg == "--help" || arg == "-h") {
+                    print_usage();
+                    return ParseResult::HELP;
+                } else if (arg == "--verbose" || arg == "-v") {
+                    g_verbose = true;
+                } else if (arg == "--list") {
+                    if (!next_value() || !add_list(value)) return ParseResult::INVALID;
+                } else if (arg == "--time-bound" || arg == "-t") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    time_bound_ = std::stoi(value);
+                    if (time_bound_ <= 0) {
+                        log_error("Time bound must be positive");
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--engine") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    if (value == "lanes") {
+                        engine_ = Engine::LANES;
+                    } else if (value == "scalar") {
+                        engine_ = Engine::SCALAR;
+                    } else {
+                        log_error("Unknown engine: ", value, " (expected lanes or scalar)");
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--output" || arg == "-o") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    output_file_ = value;
+                } else if (!arg.empty() && arg[0] == '-') {
+                    log_error("Unknown option: ", arg);
+                    return ParseResult::INVALID;
+                } else {
+                    add_path(arg);
+                }
+            } catch (const std::exception&) {
+                log_error("Invalid value for ", arg, ": ", value);
+                return ParseResult::INVALID;
+            }
+        }
+        if (files_.empty()) {
+            log_error("No games given");
+            print_usage();
+            return ParseResult::INVALID;
+        }
+        return ParseResult::RUN;
+    }
+
+    int run() {
+        auto run_start = std::chrono::steady_clock::now();
+        std::vector<ggg::solvers::TinyGame> tiny_games;
+        std::vector<size_t> tiny_results;
+
+        for (const auto& file : files_) {
+            auto load_start = std::chrono::steady_clock::now();
+            std::ifstream input(file);
+            if (!input) {
+                log_error("Cannot open game: ", file);
+                return 1;
+            }
+            std::stringstream buffer;
+            buffer << input.rdbuf();
+            std::string content = buffer.str();
+            auto manager = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+            if (!manager->load_from_dot_string(content)) {
+                log_error("Failed to load game: ", file);
+                return 1;
+            }
+            auto objective = std::make_shared<ggg::graphs::GGGReachabilityObjective>(
+                ggg::graphs::GGGReachabilityObjective::Type::REACHABILITY, manager->get_target_vertices());
+
+            GameResult result;
+            result.file = file;
+            result.time_bound = time_bound_ > 0 ? time_bound_ : extract_time_bound(content);
+            if (result.time_bound <= 0) {
+                result.time_bound = 50;
+            }
+            const auto& graph = *manager->graph();
+            result.vertices = boost::num_vertices(graph);
+            result.names.resize(result.vertices);
+            auto [vertex_begin, vertex_end] = boost::vertices(graph);
+            for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+                result.names[*vertex_it] = graph[*vertex_it].name;
+            }
+            load_time_ += std::chrono::steady_clock::now() - load_start;
+
+            if (engine_ == Engine::LANES) {
+                auto reduce_start = std::chrono::steady_clock::now();
+                auto tiny = ggg::solvers::TinyGame::reduce(*manager, *objective, result.time_bound);
+                reduce_time_ += std::chrono::steady_clock::now() - reduce_start;
+                if (tiny) {
+                    result.lanes = true;
+                    tiny_games.push_back(std::move(*tiny));
+                    tiny_results.push_back(results_.size());
+                    results_.push_back(std::move(result));
+                    continue;
+                }
+            }
+
+            // Scalar engine, and games too large for a lane
+            auto scalar_start = std::chrono::steady_clock::now();
+            ggg::solvers::GGGTemporalReachabilitySolver solver(manager, objective, result.time_bound, false);
+            auto solution = solver.solve(graph);
+            for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+                if (solution.is_won_by_player0(*vertex_it)) {
+                    result.winning.push_back(graph[*vertex_it].name);
+                }
+            }
+            scalar_time_ += std::chrono::steady_clock::now() - scalar_start;
+            scalar_games_++;
+            results_.push_back(std::move(result));
+        }
+
+        ggg::solvers::LaneBatchSolver lanes;
+        auto winning = lanes.solve(tiny_games);
+        for (size_t i = 0; i < tiny_games.size(); ++i) {
+            GameResult& result = results_[tiny_results[i]];
+            for (size_t v = 0; v < result.vertices; ++v) {
+                if ((winning[i] >> v) & 1) {
+                    result.winning.push_back(result.names[v]);
+                }
+            }
+        }
+        std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - run_start;
+
+        if (!output_file_.empty() && !write_results()) {
+            return 1;
+        }
+        write_report(std::cout, lanes.get_statistics(), wall_time);
+        return 0;
+    }
+
+    bool write_results() const {
+        std::ofstream out(output_file_);
+        if (!out) {
+            log_error("Cannot write results: ", output_file_);
+            return false;
+        }
+        out << "file,vertices,time_bound,engine,player0_winning\n";
+        for (const auto& result : results_) {
+            out << result.file << "," << result.vertices << "," << result.time_bound << ","
+                << (result.lanes ? "lanes" : "scalar") << ",";
+            for (size_t i = 0; i < result.winning.size(); ++i) {
+                out << (i > 0 ? " " : "") << result.winning[i];
+            }
+            out << "\n";
+        }
+        log_info("Results written to ", output_file_);
+        return true;
+    }
+
+    void write_report(std::ostream& out, const ggg::solvers::LaneBatchStatistics& lanes,
+                      std::chrono::duration<double> wall_time) const {
+        auto rate = [](size_t games, std::chrono::duration<double> time) {
+            return time.count() > 0.0 ? static_cast<double>(games) / time.count() : 0.0;
+        };
+        out << std::fixed << std::setprecision(3);
+        out << "Games: " << results_.size() << " (" << lanes.games << " lane-batched, "
+            << scalar_games_ << " scalar)\n";
+        if (lanes.batches > 0) {
+            out << "Batches: " << lanes.batches << " of " << ggg::solvers::LaneBatchSolver::kLanes
+                << " lanes, occupancy " << std::setprecision(1) << lanes.lane_occupancy() * 100.0 << "%\n"
+                << std::setprecision(3);
+        }
+        out << "Load: " << load_time_.count() << "s, reduce: " << reduce_time_.count()
+            << "s, pack: " << lanes.pack_time.count() << "s, lane solve: " << lanes.solve_time.count()
+            << "s, scalar solve: " << scalar_time_.count() << "s\n";
+        out << std::setprecision(0);
+        if (lanes.games > 0) {
+            out << "Lane throughput: " << rate(lanes.games, reduce_time_ + lanes.pack_time + lanes.solve_time)
+                << " games/s with constraint reduction (" << lanes.games_per_second()
+                << " games/s for the lane recurrence alone)\n";
+        }
+        if (scalar_games_ > 0) {
+            out << "Scalar throughput: " << rate(scalar_games_, scalar_time_) << " games/s\n";
+        }
+        out << "End to end: " << rate(results_.size(), wall_time) << " games/s\n";
+    }
+
+    void print_usage() const {
+        std::cout << "Temporis Batch Solver\n\n";
+        std::cout << "USAGE:\n";
+        std::cout << "  temporis_batch [OPTIONS] GAME.dot|DIRECTORY...\n\n";
+        std::cout << "OPTIONS:\n";
+        std::cout << "  --list FILE            Read game paths from FILE, one per line\n";
+        std::cout << "  -t, --time-bound N     Time bound for every game (default: the game's time_bound comment, else 50)\n";
+        std::cout << "  --engine lanes|scalar  lanes packs games of at most 64 vertices into SIMD lanes and\n";
+        std::cout << "                         solves larger ones with the backwards solver; scalar solves\n";
+        std::cout << "                         every game with the backwards solver (default: lanes)\n";
+        std::cout << "  -o, --output FILE      Write file,vertices,time_bound,engine,player0_winning rows to FILE\n";
+        std::cout << "  -v, --verbose          Log progress on stderr\n";
+        std::cout << "  -h, --help             Show this help\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    BatchExecutor executor;
+
+    ParseResult parsed = executor.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 1;
+    }
+
+    return executor.run();
+}
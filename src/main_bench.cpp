@@ -0,0 +1,496 @@
+#include "game_generator.hpp"
+#include "ggg_temporal_graph.hpp"
+#include "ggg_temporal_solver.hpp"
+#include "static_expansion_solver.hpp"
+#include "workload_bundle.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Microbenchmark driver for the solver hot paths
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    template<typename... Args>
+    void log_error(Args... args) {
+        std::cerr << "[ERROR] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+
+    // Keep the optimizer from discarding benchmarked results
+    template<typename T>
+    void do_not_optimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct BenchConfig {
+        std::vector<int> vertices = {100, 1000};
+        std::vector<int> degrees = {4};
+        std::vector<int> time_bounds = {50, 200};
+        std::vector<std::string> mixes = {"mixed"};
+        int nesting_depth = 1;
+        int repeats = 5;
+        double min_sample_seconds = 0.02;
+        unsigned seed = 42;
+        std::string format = "json";
+        std::string filter;
+        std::string output_file;
+        std::vector<std::string> bundles;  // captured workloads replacing the generated games
+    };
+
+    /**
+     * @brief One benchmark measurement; times are per operation
+     */
+    struct BenchResult {
+        std::string name;
+        int vertices = 0;
+        size_t edges = 0;
+        int time_bound = 0;
+        std::string mix;
+        size_t iterations = 0;
+        double median_ns = 0.0;
+        double min_ns = 0.0;
+        double max_ns = 0.0;
+        double throughput = 0.0;
+        std::string throughput_unit;
+    };
+
+    const std::vector<std::string> kConstraintFamilies = {"threshold", "interval", "modulus", "existential"};
+
+    std::vector<std::string> split_list(const std::string& value) {
+        std::vector<std::string> items;
+        std::istringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    std::vector<int> split_int_list(const std::string& value) {
+        std::vector<int> items;
+        for (const auto& item : split_list(value)) {
+            items.push_back(std::stoi(item));
+        }
+        return items;
+    }
+
+    // Generator options for one benchmark configuration
+    ggg::graphs::GameGeneratorOptions make_generator_options(const BenchConfig& config, int vertices, int degree,
+                                                             int time_bound, const std::string& mix) {
+        ggg::graphs::GameGeneratorOptions options;
+        options.vertices = static_cast<uint64_t>(vertices);
+        options.edges = static_cast<uint64_t>(vertices) * static_cast<uint64_t>(degree);
+        options.time_bound = time_bound;
+        options.nesting_depth = config.nesting_depth;
+        options.seed = config.seed;
+        options.set_constraint_mix(mix);
+        return options;
+    }
+
+    /**
+     * @brief Run a callable repeatedly and collect per-operation timings
+     *
+     * The iteration count is calibrated so that one sample lasts at least
+     * min_sample_seconds; the reported statistics are over config.repeats samples.
+     * The callable returns the number of operations it performed.
+     */
+    BenchResult measure(const BenchConfig& config, const std::function<size_t()>& op) {
+        size_t iterations = 1;
+        while (true) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i) {
+                op();
+            }
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            if (elapsed.count() >= config.min_sample_seconds || iterations >= (size_t{1} << 30)) {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        std::vector<double> samples;
+        size_t ops_per_sample = 0;
+        for (int r = 0; r < config.repeats; ++r) {
+            ops_per_sample = 0;
+            auto start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i) {
+                ops_per_sample += op();
+            }
+            std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            samples.push_back(elapsed.count() / std::max<size_t>(1, ops_per_sample));
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchResult result;
+        result.iterations = ops_per_sample;
+        result.median_ns = samples[samples.size() / 2];
+        result.min_ns = samples.front();
+        result.max_ns = samples.back();
+        result.throughput = result.median_ns > 0.0 ? 1e9 / result.median_ns : 0.0;
+        result.throughput_unit = "ops/s";
+        return result;
+    }
+
+    // Summarize externally timed samples (in seconds) as a result
+    BenchResult summarize(std::vector<double> seconds) {
+        std::sort(seconds.begin(), seconds.end());
+        BenchResult result;
+        result.iterations = seconds.size();
+        result.median_ns = seconds[seconds.size() / 2] * 1e9;
+        result.min_ns = seconds.front() * 1e9;
+        result.max_ns = seconds.back() * 1e9;
+        result.throughput = result.median_ns > 0.0 ? 1e9 / result.median_ns : 0.0;
+        result.throughput_unit = "ops/s";
+        return result;
+    }
+}
+
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
+/**
+ * @brief Benchmark suite covering constraint evaluation, parsing, loading and both solvers
+ */
+class TemporisBenchmarkSuite {
+private:
+    BenchConfig config_;
+    std::vector<BenchResult> results_;
+
+public:
+    ParseResult parse_arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next_value = [&](std::string& value) {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+
+            std::string value;
+            try {
+                if (arg == "--help" || arg == "-h") {
+                    print_usage();
+                    return ParseResult::HELP;
+                } else if (arg == "--vertices") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.vertices = split_int_list(value);
+                } else if (arg == "--degree") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.degrees = split_int_list(value);
+                } else if (arg == "--time-bound") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.time_bounds = split_int_list(value);
+                } else if (arg == "--mix") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.mixes = split_list(value);
+                } else if (arg == "--nesting-depth") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.nesting_depth = std::max(1, std::stoi(value));
+                } else if (arg == "--repeat") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.repeats = std::max(1, std::stoi(value));
+                } else if (arg == "--min-time") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.min_sample_seconds = std::stod(value);
+                } else if (arg == "--seed") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.seed = static_cast<unsigned>(std::stoul(value));
+                } else if (arg == "--filter") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.filter = value;
+                } else if (arg == "--format") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    if (value != "json" && value != "csv") {
+                        log_error("Unknown format: ", value);
+                        return ParseResult::INVALID;
+                    }
+                    config_.format = value;
+                } else if (arg == "--output" || arg == "-o") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.output_file = value;
+                } else if (arg == "--bundle") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.bundles.push_back(value);
+                } else {
+                    log_error("Unknown option: ", arg);
+                    return ParseResult::INVALID;
+                }
+            } catch (const std::exception&) {
+                log_error("Invalid value for ", arg, ": ", value);
+                return ParseResult::INVALID;
+            }
+        }
+        return ParseResult::RUN;
+    }
+
+    bool run() {
+        if (!config_.bundles.empty()) {
+            return run_bundle_benchmarks();
+        }
+        run_formula_benchmarks();
+        run_parse_benchmarks();
+
+        for (int vertices : config_.vertices) {
+            for (int degree : config_.degrees) {
+                for (int time_bound : config_.time_bounds) {
+                    for (const auto& mix : config_.mixes) {
+                        ggg::graphs::GameGenerator generator(
+                            make_generator_options(config_, vertices, degree, time_bound, mix));
+                        run_game_benchmarks(generator.generate_dot(), time_bound, mix);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    void write_results() const {
+        if (config_.output_file.empty()) {
+            write_results(std::cout);
+            return;
+        }
+        std::ofstream out(config_.output_file);
+        if (!out.is_open()) {
+            log_error("Cannot open output file: ", config_.output_file);
+            return;
+        }
+        write_results(out);
+    }
+
+private:
+    bool enabled(const std::string& name) const {
+        return config_.filter.empty() || name.find(config_.filter) != std::string::npos;
+    }
+
+    void record(BenchResult result, const std::string& name, int vertices, size_t edges,
+                int time_bound, const std::string& mix) {
+        result.name = name;
+        result.vertices = vertices;
+        result.edges = edges;
+        result.time_bound = time_bound;
+        result.mix = mix;
+        results_.push_back(result);
+        std::cerr << "  " << std::left << std::setw(34) << name << " V=" << vertices << " E=" << edges
+                  << " T=" << time_bound << " mix=" << mix << ": " << std::fixed << std::setprecision(1)
+                  << result.median_ns << " ns/op" << std::endl;
+    }
+
+    // PresburgerFormula::evaluate for each constraint family
+    void run_formula_benchmarks() {
+        ggg::graphs::GGGTemporalGameManager manager;
+        for (int time_bound : config_.time_bounds) {
+            for (const auto& family : kConstraintFamilies) {
+                std::string name = "formula_evaluate/" + family;
+                if (!enabled(name)) continue;
+
+                ggg::graphs::GameGenerator generator(make_generator_options(config_, 0, 0, time_bound, family));
+                auto formula = manager.parse_constraint(generator.generate_constraint().to_string());
+                std::map<std::string, int> values = {{"time", 0}};
+                int time = 0;
+                auto result = measure(config_, [&]() {
+                    values["time"] = time;
+                    time = (time + 1) % time_bound;
+                    do_not_optimize(formula->evaluate(values));
+                    return size_t{1};
+                });
+                record(result, name, 0, 0, time_bound, family);
+            }
+        }
+    }
+
+    // GGGTemporalGameManager::parse_constraint over a pool of generated strings
+    void run_parse_benchmarks() {
+        ggg::graphs::GGGTemporalGameManager manager;
+        std::vector<std::string> mixes = kConstraintFamilies;
+        mixes.push_back("mixed");
+        for (const auto& mix : mixes) {
+            std::string name = "parse_constraint/" + mix;
+            if (!enabled(name)) continue;
+
+            ggg::graphs::GameGenerator generator(make_generator_options(config_, 0, 0, 100, mix));
+            std::vector<std::string> pool;
+            for (int i = 0; i < 256; ++i) {
+                pool.push_back(generator.generate_constraint().to_string());
+            }
+            size_t index = 0;
+            auto result = measure(config_, [&]() {
+                auto formula = manager.parse_constraint(pool[index]);
+                index = (index + 1) % pool.size();
+                do_not_optimize(formula.get());
+                return size_t{1};
+            });
+            record(result, name, 0, 0, 0, mix);
+        }
+    }
+
+    // The game benchmarks on captured inputs, labelled bundle:<name> in the mix column
+    bool run_bundle_benchmarks() {
+        auto files = ggg::stats::WorkloadBundle::collect(config_.bundles);
+        if (files.empty()) {
+            log_error("No bundles found");
+            return false;
+        }
+        for (const auto& file : files) {
+            std::string error;
+            auto bundle = ggg::stats::WorkloadBundle::load(file, error);
+            if (!bundle) {
+                log_error(error);
+                return false;
+            }
+            run_game_benchmarks(bundle->input, bundle->time_bound, "bundle:" + bundle->name);
+        }
+        return true;
+    }
+
+    void run_game_benchmarks(const std::string& dot, int time_bound, const std::string& mix) {
+        using Vertex = ggg::graphs::GGGTemporalVertex;
+
+        auto manager = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+        manager->load_from_dot_string(dot);
+        int vertices = static_cast<int>(boost::num_vertices(*manager->graph()));
+        size_t edges = boost::num_edges(*manager->graph());
+        auto objective = std::make_shared<ggg::graphs::GGGReachabilityObjective>(
+            ggg::graphs::GGGReachabilityObjective::Type::REACHABILITY, manager->get_target_vertices());
+
+        // DOT loading, reported as throughput in MB/s
+        if (enabled("dot_load")) {
+            ggg::graphs::GGGTemporalGameManager loader;
+            auto result = measure(config_, [&]() {
+                loader.load_from_dot_string(dot);
+                return size_t{1};
+            });
+            double megabytes = static_cast<double>(dot.size()) / (1024.0 * 1024.0);
+            result.throughput = result.median_ns > 0.0 ? megabytes * 1e9 / result.median_ns : 0.0;
+            result.throughput_unit = "MB/s";
+            record(result, "dot_load", vertices, edges, time_bound, mix);
+        }
+
+        // get_available_moves, one call per vertex at varying times
+        if (enabled("get_available_moves")) {
+            std::vector<Vertex> all_vertices;
+            auto [vertex_begin, vertex_end] = boost::vertices(*manager->graph());
+            all_vertices.assign(vertex_begin, vertex_end);
+            size_t index = 0;
+            int time = 0;
+            auto result = measure(config_, [&]() {
+                do_not_optimize(manager->get_available_moves(all_vertices[index], time).size());
+                if (++index == all_vertices.size()) {
+                    index = 0;
+                    time = (time + 1) % time_bound;
+                }
+                return size_t{1};
+            });
+            record(result, "get_available_moves", vertices, edges, time_bound, mix);
+        }
+
+        // One layer of the backwards attractor, fed with a realistic successor layer
+        if (enabled("attractor_layer") && time_bound >= 2) {
+            ggg::solvers::GGGTemporalReachabilitySolver solver(manager, objective, time_bound, false);
+            int layer_time = time_bound / 2;
+            ggg::solvers::LayerSet next_layer(boost::num_vertices(*manager->graph()));
+            for (int time = time_bound - 1; time > layer_time; --time) {
+                next_layer = solver.compute_attractor_layer(time, next_layer);
+            }
+            auto result = measure(config_, [&]() {
+                do_not_optimize(solver.compute_attractor_layer(layer_time, next_layer).size());
+                return size_t{1};
+            });
+            record(result, "attractor_layer", vertices, edges, time_bound, mix);
+        }
+
+        // Static expansion phases, timed by the solver's own statistics
+        if (enabled("static_expansion")) {
+            ggg::solvers::StaticExpansionSolver solver(manager, objective, time_bound, false);
+            std::vector<double> expansion_times;
+            std::vector<double> attractor_times;
+            for (int r = 0; r < config_.repeats; ++r) {
+                solver.solve(*manager->graph());
+                expansion_times.push_back(solver.get_statistics().expansion_time.count());
+                attractor_times.push_back(solver.get_statistics().attractor_time.count());
+            }
+            record(summarize(expansion_times), "static_expansion/expansion", vertices, edges, time_bound, mix);
+            record(summarize(attractor_times), "static_expansion/attractor", vertices, edges, time_bound, mix);
+        }
+    }
+
+    void write_results(std::ostream& out) const {
+        if (config_.format == "csv") {
+            out << "benchmark,vertices,edges,time_bound,mix,iterations,median_ns,min_ns,max_ns,throughput,throughput_unit\n";
+            for (const auto& r : results_) {
+                out << r.name << "," << r.vertices << "," << r.edges << "," << r.time_bound << ","
+                    << r.mix << "," << r.iterations << "," << std::fixed << std::setprecision(3)
+                    << r.median_ns << "," << r.min_ns << "," << r.max_ns << ","
+                    << r.throughput << "," << r.throughput_unit << "\n";
+            }
+            return;
+        }
+
+        out << "[\n";
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const auto& r = results_[i];
+            out << "  {\"benchmark\": \"" << r.name << "\", \"vertices\": " << r.vertices
+                << ", \"edges\": " << r.edges << ", \"time_bound\": " << r.time_bound
+                << ", \"mix\": \"" << r.mix << "\", \"iterations\": " << r.iterations
+                << std::fixed << std::setprecision(3)
+                << ", \"median_ns\": " << r.median_ns << ", \"min_ns\": " << r.min_ns
+                << ", \"max_ns\": " << r.max_ns << ", \"throughput\": " << r.throughput
+                << ", \"throughput_unit\": \"" << r.throughput_unit << "\"}"
+                << (i + 1 < results_.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+    void print_usage() const {
+        std::cout << "Temporis Microbenchmark Suite\n\n";
+        std::cout << "USAGE:\n";
+        std::cout << "  temporis_bench [OPTIONS]\n\n";
+        std::cout << "OPTIONS:\n";
+        std::cout << "  --vertices LIST        Vertex counts to sweep (default: 100,1000)\n";
+        std::cout << "  --degree LIST          Out-degrees to sweep; E = V * degree (default: 4)\n";
+        std::cout << "  --time-bound LIST      Time bounds to sweep (default: 50,200)\n";
+        std::cout << "  --mix LIST             Constraint mixes: threshold, interval, modulus,\n";
+        std::cout << "                         existential, mixed (default: mixed)\n";
+        std::cout << "  --nesting-depth D      Constraint nesting depth, as in temporis_gen (default: 1)\n";
+        std::cout << "  --repeat N             Samples per benchmark (default: 5)\n";
+        std::cout << "  --min-time SECONDS     Minimum duration of one sample (default: 0.02)\n";
+        std::cout << "  --seed N               Seed for generated games (default: 42)\n";
+        std::cout << "  --filter NAME          Only run benchmarks whose name contains NAME\n";
+        std::cout << "  --format json|csv      Result format (default: json)\n";
+        std::cout << "  -o, --output FILE      Write results to FILE instead of stdout\n";
+        std::cout << "  --bundle PATH          Run the game benchmarks on a bundle from temporis --capture, or on\n";
+        std::cout << "                         every *.tbundle in a directory, instead of generated games (repeatable)\n";
+        std::cout << "  -h, --help             Show this help\n\n";
+        std::cout << "BENCHMARKS:\n";
+        std::cout << "  formula_evaluate/<family>, parse_constraint/<mix>, dot_load,\n";
+        std::cout << "  get_available_moves, attractor_layer,\n";
+        std::cout << "  static_expansion/expansion, static_expansion/attractor\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    TemporisBenchmarkSuite suite;
+
+    ParseResult parsed = suite.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 1;
+    }
+
+    if (!suite.run()) {
+        return 1;
+    }
+    suite.write_results();
+    return 0;
+}
@@ -0,0 +1,1022 @@
+#include "component_solver.hpp"
+#include "constraint_codegen.hpp"
+#include "game_generator.hpp"
+#include "ggg_temporal_graph.hpp"
+#include "ggg_temporal_solver.hpp"
+#include "lane_batch_solver.hpp"
+#include "sensitivity_analysis.hpp"
+#include "speculative_sweep.hpp"
+#include "static_expansion_solver.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Differential tester: solver engines and formula evaluators must agree on random games
+namespace {
+    using ggg::graphs::GeneratedConstraint;
+
+    template<typename... Args>
+    void log_error(Args... args) {
+        std::cerr << "[ERROR] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+
+    template<typename... Args>
+    void log_info(Args... args) {
+        std::cout << "[INFO] ";
+        ((std::cout << args), ...);
+        std::cout << std::endl;
+    }
+
+    struct DiffEdge {
+        size_t source;
+        size_t target;
+        bool constrained;
+        GeneratedConstraint constraint;
+    };
+
+    /**
+     * @brief Game kept in structured form so it can be shrunk and written back as DOT
+     */
+    struct DiffGame {
+        int time_bound = 1;
+        std::vector<int> players;
+        std::vector<bool> targets;
+        std::vector<std::optional<GeneratedConstraint>> target_constraints;   // targets only
+        std::vector<DiffEdge> edges;
+
+        size_t vertex_count() const { return players.size(); }
+
+        bool has_target() const {
+            return std::find(targets.begin(), targets.end(), true) != targets.end();
+        }
+
+        std::string to_dot(const std::string& comment) const {
+            std::ostringstream out;
+            out << "digraph G {\n";
+            out << "    // time_bound: " << time_bound << "\n";
+            if (!comment.empty()) {
+                out << "    // " << comment << "\n";
+            }
+            for (size_t v = 0; v < players.size(); ++v) {
+                out << "    v" << v << " [name=\"v" << v << "\", player=" << players[v];
+                if (targets[v]) {
+                    out << ", target=1";
+                    if (target_constraints[v]) {
+                        out << ", target_constraint=\"" << target_constraints[v]->to_string() << "\"";
+                    }
+                }
+                out << "];\n";
+            }
+            for (const auto& edge : edges) {
+                out << "    v" << edge.source << " -> v" << edge.target;
+                if (edge.constrained) {
+                    out << " [constraint=\"" << edge.constraint.to_string() << "\"]";
+                }
+                out << ";\n";
+            }
+            out << "}\n";
+            return out.str();
+        }
+    };
+
+    /**
+     * @brief A DiffGame loaded through the production DOT parser
+     */
+    struct LoadedGame {
+        std::shared_ptr<ggg::graphs::GGGTemporalGameManager> manager;
+        std::shared_ptr<ggg::graphs::GGGReachabilityObjective> objective;
+    };
+
+    // Winner (0 or 1) per vertex, indexed like DiffGame::players
+    using Winners = std::vector<int>;
+
+    /**
+     * @brief A solver under test; every engine must reproduce the reference winners
+     */
+    struct Engine {
+        std::string name;
+        std::function<Winners(const DiffGame&, const LoadedGame&)> solve;
+    };
+
+    /**
+     * @brief A constraint evaluator under test, prepared once per constraint
+     *
+     * prepare_game, if set, is given all constraints of a game first, so that an
+     * evaluator with a per-call setup cost can prepare them together.
+     */
+    struct FormulaEngine {
+        std::string name;
+        std::function<std::function<bool(int)>(const GeneratedConstraint&)> prepare;
+        std::function<void(const std::vector<GeneratedConstraint>&)> prepare_game = nullptr;
+    };
+
+    // Map a solver solution back to DiffGame vertex indices through the "v<i>" names
+    template<typename Solution>
+    Winners collect_winners(const DiffGame& game, const LoadedGame& loaded, const Solution& solution) {
+        Winners winners(game.vertex_count(), 1);
+        const auto& graph = *loaded.manager->graph();
+        auto [vertex_begin, vertex_end] = boost::vertices(graph);
+        for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+            size_t index = std::stoul(graph[*vertex_it].name.substr(1));
+            winners[index] = solution.is_won_by_player0(*vertex_it) ? 0 : 1;
+        }
+        return winners;
+    }
+
+    // Layer-by-layer evaluation straight from the definition, on the syntax trees;
+    // edge disabled_edge is treated as unavailable at disabled_time
+    Winners solve_by_definition(const DiffGame& game, size_t disabled_edge = SIZE_MAX, int disabled_time = -1) {
+        std::vector<bool> next(game.vertex_count());
+        for (size_t v = 0; v < game.vertex_count(); ++v) {
+            next[v] = game.targets[v] && (!game.target_constraints[v] ||
+                                          game.target_constraints[v]->evaluate(game.time_bound));
+        }
+        std::vector<bool> layer(game.vertex_count());
+        std::vector<std::vector<size_t>> moves(game.vertex_count());
+        for (int time = game.time_bound - 1; time >= 0; --time) {
+            for (auto& vertex_moves : moves) {
+                vertex_moves.clear();
+            }
+            for (size_t e = 0; e < game.edges.size(); ++e) {
+                const auto& edge = game.edges[e];
+                if (e == disabled_edge && time == disabled_time) {
+                    continue;
+                }
+                if (!edge.constrained || edge.constraint.evaluate(time)) {
+                    moves[edge.source].push_back(edge.target);
+                }
+            }
+            for (size_t v = 0; v < game.vertex_count(); ++v) {
+                auto in_next = [&](size_t target) { return static_cast<bool>(next[target]); };
+                if (moves[v].empty()) {
+                    layer[v] = false;
+                } else if (game.players[v] == 0) {
+                    layer[v] = std::any_of(moves[v].begin(), moves[v].end(), in_next);
+                } else {
+                    layer[v] = std::all_of(moves[v].begin(), moves[v].end(), in_next);
+                }
+            }
+            next = layer;
+        }
+        Winners winners(game.vertex_count());
+        for (size_t v = 0; v < game.vertex_count(); ++v) {
+            winners[v] = next[v] ? 0 : 1;
+        }
+        return winners;
+    }
+
+    Winners solve_backwards(const DiffGame& game, const LoadedGame& loaded, bool fast_path,
+                            ggg::solvers::SinglePlayerReachability::WindowMode mode) {
+        ggg::solvers::GGGTemporalReachabilitySolver solver(loaded.manager, loaded.objective, game.time_bound, false);
+        solver.set_single_player_fast_path(fast_path);
+        solver.set_window_mode(mode);
+        return collect_winners(game, loaded, solver.solve(*loaded.manager->graph()));
+    }
+
+    // Every component is its own work item so extraction and merging are exercised on small games
+    template<typename PartSolver>
+    Winners solve_components(const DiffGame& game, const LoadedGame& loaded) {
+        ggg::solvers::ComponentSolver components(loaded.manager, loaded.objective, 3, 1);
+        auto solution = components.solve([&](const ggg::solvers::SubGame& sub, std::string& engine) {
+            PartSolver part(sub.manager, sub.objective, game.time_bound, false);
+            engine = part.get_name();
+            return part.solve(*sub.manager->graph());
+        });
+        return collect_winners(game, loaded, solution);
+    }
+
+    // Lazily loaded game queried one vertex at a time, so each query parses only its reachable constraints
+    Winners solve_lazy_queries(const DiffGame& game) {
+        LoadedGame lazy;
+        lazy.manager = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+        lazy.manager->set_lazy_constraints(true);
+        if (!lazy.manager->load_from_dot_string(game.to_dot(""))) {
+            throw std::runtime_error("DOT loader rejected the game");
+        }
+        lazy.objective = std::make_shared<ggg::graphs::GGGReachabilityObjective>(
+            ggg::graphs::GGGReachabilityObjective::Type::REACHABILITY, lazy.manager->get_target_vertices());
+
+        Winners winners(game.vertex_count(), 1);
+        const auto& graph = *lazy.manager->graph();
+        auto [vertex_begin, vertex_end] = boost::vertices(graph);
+        for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+            ggg::solvers::GGGTemporalReachabilitySolver solver(lazy.manager, lazy.objective, game.time_bound, false);
+            auto solution = solver.solve_from_state(*vertex_it);
+            size_t index = std::stoul(graph[*vertex_it].name.substr(1));
+            winners[index] = solution.is_won_by_player0(*vertex_it) ? 0 : 1;
+        }
+        return winners;
+    }
+
+    // The first entry is the reference every other engine is compared with; it shares no
+    // code with the production sweeps, so a bug common to their optimisations still shows
+    std::vector<Engine> all_engines() {
+        using WindowMode = ggg::solvers::SinglePlayerReachability::WindowMode;
+        return {
+            {"definition", [](const DiffGame& game, const LoadedGame&) {
+                return solve_by_definition(game);
+            }},
+            {"backwards", [](const DiffGame& game, const LoadedGame& loaded) {
+                return solve_backwards(game, loaded, false, WindowMode::COST_MODEL);
+            }},
+            // Every vertex in every layer, the kernel before the activity index
+            {"backwards_all_vertices", [](const DiffGame& game, const LoadedGame& loaded) {
+                ggg::solvers::GGGTemporalReachabilitySolver solver(loaded.manager, loaded.objective,
+                                                                   game.time_bound, false);
+                solver.set_single_player_fast_path(false);
+                solver.set_activity_index(false);
+                return collect_winners(game, loaded, solver.solve(*loaded.manager->graph()));
+            }},
+            // The fast-path engines fall back to the layered sweep when Player 1 has choices
+            {"single_player", [](const DiffGame& game, const LoadedGame& loaded) {
+                return solve_backwards(game, loaded, true, WindowMode::COST_MODEL);
+            }},
+            {"single_player_step", [](const DiffGame& game, const LoadedGame& loaded) {
+                return solve_backwards(game, loaded, true, WindowMode::ALWAYS_STEP);
+            }},
+            {"single_player_square", [](const DiffGame& game, const LoadedGame& loaded) {
+                return solve_backwards(game, loaded, true, WindowMode::ALWAYS_SQUARE);
+            }},
+            // A one-layer warm-up mispredicts often, so validation recomputes chunks;
+            // horizons below 32 (see --max-time) run as one sequential chunk
+            {"speculative", [](const DiffGame& game, const LoadedGame& loaded) {
+                ggg::solvers::SpeculativeSweep speculation(2, 8, ggg::solvers::SpeculativeSweep::Predictor::WARMUP);
+                speculation.set_warmup_layers(1);
+                ggg::solvers::GGGTemporalReachabilitySolver solver(loaded.manager, loaded.objective,
+                                                                   game.time_bound, false);
+                solver.set_single_player_fast_path(false);
+                solver.set_speculation(&speculation);
+                return collect_winners(game, loaded, solver.solve(*loaded.manager->graph()));
+            }},
+            {"static_expansion", [](const DiffGame& game, const LoadedGame& loaded) {
+                ggg::solvers::StaticExpansionSolver solver(loaded.manager, loaded.objective,
+                                                           game.time_bound, false);
+                return collect_winners(game, loaded, solver.solve(*loaded.manager->graph()));
+            }},
+            // Small games fit in one chunk, but every frontier still passes through the worker barrier
+            {"static_expansion_parallel", [](const DiffGame& game, const LoadedGame& loaded) {
+                ggg::solvers::StaticExpansionSolver solver(loaded.manager, loaded.objective,
+                                                           game.time_bound, false);
+                solver.set_attractor_threads(3);
+                return collect_winners(game, loaded, solver.solve(*loaded.manager->graph()));
+            }},
+            {"components", [](const DiffGame& game, const LoadedGame& loaded) {
+                return solve_components<ggg::solvers::GGGTemporalReachabilitySolver>(game, loaded);
+            }},
+            {"components_static_expansion", [](const DiffGame& game, const LoadedGame& loaded) {
+                return solve_components<ggg::solvers::StaticExpansionSolver>(game, loaded);
+            }},
+            // A batch of one game; the other lanes are padding
+            {"lane_batch", [](const DiffGame& game, const LoadedGame& loaded) {
+                auto tiny = ggg::solvers::TinyGame::reduce(*loaded.manager, *loaded.objective, game.time_bound);
+                if (!tiny) {
+                    return solve_backwards(game, loaded, false, WindowMode::COST_MODEL);
+                }
+                ggg::solvers::LaneBatchSolver lanes;
+                uint64_t winning = lanes.solve({*tiny}).front();
+                Winners winners(game.vertex_count(), 1);
+                const auto& graph = *loaded.manager->graph();
+                auto [vertex_begin, vertex_end] = boost::vertices(graph);
+                for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+                    size_t index = std::stoul(graph[*vertex_it].name.substr(1));
+                    winners[index] = ((winning >> *vertex_it) & 1) ? 0 : 1;
+                }
+                return winners;
+            }},
+            {"lazy_query", [](const DiffGame& game, const LoadedGame&) {
+                return solve_lazy_queries(game);
+            }},
+        };
+    }
+
+    // Kept apart from the user's cache: difftest compiles many throwaway constraints. Per user,
+    // since the compiler refuses a cache directory another user owns
+    std::string codegen_cache_dir() {
+        return (std::filesystem::temp_directory_path() /
+                ("temporis-difftest-codegen-" + std::to_string(geteuid()))).string();
+    }
+
+    // Whether constraints can be compiled here at all, by compiling a trivial one
+    bool codegen_available(std::string& reason) {
+        ggg::graphs::GGGTemporalGameManager manager;
+        auto vertex = manager.add_vertex("v0", 0);
+        auto edge = manager.add_edge(vertex, vertex).first;
+        manager.add_edge_constraint(edge, manager.parse_constraint("time >= 0"));
+        ggg::codegen::ConstraintCompiler compiler(codegen_cache_dir());
+        if (compiler.compile(manager)) {
+            return true;
+        }
+        reason = compiler.get_report().fallback_reason;
+        return false;
+    }
+
+    // The first entry is the reference every other evaluator is compared with
+    std::vector<FormulaEngine> all_formula_engines(bool compiled) {
+        auto parser = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+        std::vector<FormulaEngine> engines = {
+            {"interpreted", [parser](const GeneratedConstraint& constraint) -> std::function<bool(int)> {
+                std::shared_ptr<ggg::graphs::PresburgerFormula> formula =
+                    parser->parse_constraint(constraint.to_string());
+                return [formula](int time) {
+                    std::map<std::string, int> values = {{"time", time}};
+                    return formula->evaluate(values);
+                };
+            }},
+            {"syntax_tree", [](const GeneratedConstraint& constraint) -> std::function<bool(int)> {
+                return [constraint](int time) { return constraint.evaluate(time); };
+            }},
+        };
+        if (compiled) {
+            // One shared object per game; constraints met only while minimizing get one each,
+            // and the cache makes re-preparing them cheap
+            using Prepared = std::map<std::string, std::function<bool(int)>>;
+            auto game_constraints = std::make_shared<Prepared>();
+            auto compile = [cache = codegen_cache_dir()](const std::vector<std::string>& texts) {
+                auto manager = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+                Prepared prepared;
+                for (const auto& text : texts) {
+                    auto vertex = manager->add_vertex("v" + std::to_string(prepared.size()), 0);
+                    auto edge = manager->add_edge(vertex, vertex).first;
+                    manager->add_edge_constraint(edge, manager->parse_constraint(text));
+                    prepared[text] = [manager, edge](int time) {
+                        return manager->is_edge_constraint_satisfied(edge, time);
+                    };
+                }
+                ggg::codegen::ConstraintCompiler compiler(cache);
+                if (!compiler.compile(*manager)) {
+                    throw std::runtime_error("constraint codegen failed: " + compiler.get_report().fallback_reason);
+                }
+                return prepared;
+            };
+            engines.push_back({"compiled",
+                [game_constraints, compile](const GeneratedConstraint& constraint) -> std::function<bool(int)> {
+                    std::string text = constraint.to_string();
+                    auto it = game_constraints->find(text);
+                    return it != game_constraints->end() ? it->second : compile({text}).at(text);
+                },
+                [game_constraints, compile](const std::vector<GeneratedConstraint>& constraints) {
+                    std::set<std::string> texts;
+                    for (const auto& constraint : constraints) {
+                        texts.insert(constraint.to_string());
+                    }
+                    *game_constraints = texts.empty() ? Prepared{}
+                                                      : compile(std::vector<std::string>(texts.begin(), texts.end()));
+                }});
+        }
+        return engines;
+    }
+
+    std::vector<std::string> split_list(const std::string& value) {
+        std::vector<std::string> items;
+        std::istringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    struct DiffConfig {
+        int games = 200;
+        uint64_t seed = 1;
+        size_t min_vertices = 2;
+        size_t max_vertices = 12;
+        size_t max_degree = 3;
+        int max_time = 30;
+        int max_nesting_depth = 3;
+        double unconstrained_ratio = 0.2;
+        double target_ratio = 0.3;
+        double single_player_ratio = 0.3;
+        double target_constraint_ratio = 0.3;
+        std::vector<std::string> engines;
+        std::string output_dir = "difftest_failures";
+        int max_failures = 10;
+        bool minimize = true;
+        bool quiet = false;
+        bool compile_constraints = false;
+        bool compiled_evaluator = true;   // whenever a compiler is available
+        bool sensitivity = false;
+    };
+}
+
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
+/**
+ * @brief Generates random games, cross-checks engines and shrinks failing cases
+ */
+class DifferentialTester {
+private:
+    DiffConfig config_;
+    std::vector<Engine> engines_;
+    std::vector<FormulaEngine> formula_engines_;
+    size_t games_checked_ = 0;
+    size_t vertices_checked_ = 0;
+    size_t formula_checks_ = 0;
+    size_t critical_checked_ = 0;
+    size_t critical_missed_ = 0;
+    int failures_ = 0;
+
+public:
+    ParseResult parse_arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next_value = [&](std::string& value) {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+
+            std::string value;
+            try {
+                if (arg == "--help" || arg == "-h") {
+                    print_usage();
+                    return ParseResult::HELP;
+                } else if (arg == "--games" || arg == "-n") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.games = std::max(1, std::stoi(value));
+                } else if (arg == "--seed" || arg == "-s") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.seed = std::stoull(value);
+                } else if (arg == "--min-vertices") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.min_vertices = std::max<size_t>(1, std::stoul(value));
+                } else if (arg == "--max-vertices") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.max_vertices = std::max<size_t>(1, std::stoul(value));
+                } else if (arg == "--max-degree") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.max_degree = std::stoul(value);
+                } else if (arg == "--max-time") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.max_time = std::max(1, std::stoi(value));
+                } else if (arg == "--nesting-depth") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.max_nesting_depth = std::max(1, std::stoi(value));
+                } else if (arg == "--engines") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.engines = split_list(value);
+                } else if (arg == "--output-dir" || arg == "-o") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.output_dir = value;
+                } else if (arg == "--max-failures") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    config_.max_failures = std::max(1, std::stoi(value));
+                } else if (arg == "--no-minimize") {
+                    config_.minimize = false;
+                } else if (arg == "--quiet" || arg == "-q") {
+                    config_.quiet = true;
+                } else if (arg == "--compile-constraints") {
+                    config_.compile_constraints = true;
+                } else if (arg == "--no-compiled-evaluator") {
+                    config_.compiled_evaluator = false;
+                } else if (arg == "--sensitivity") {
+                    config_.sensitivity = true;
+                } else {
+                    log_error("Unknown option: ", arg);
+                    return ParseResult::INVALID;
+                }
+            } catch (const std::exception&) {
+                log_error("Invalid value for ", arg, ": ", value);
+                return ParseResult::INVALID;
+            }
+        }
+        if (config_.min_vertices > config_.max_vertices) {
+            log_error("--min-vertices must not exceed --max-vertices");
+            return ParseResult::INVALID;
+        }
+        return select_engines() ? ParseResult::RUN : ParseResult::INVALID;
+    }
+
+    /**
+     * @brief Run all games
+     * @return true if every check passed
+     */
+    bool run() {
+        for (int index = 0; index < config_.games && failures_ < config_.max_failures; ++index) {
+            uint64_t game_seed = config_.seed + static_cast<uint64_t>(index);
+            DiffGame game = generate_game(game_seed);
+            games_checked_++;
+            vertices_checked_ += game.vertex_count();
+
+            check_formulas(game, game_seed);
+            if (config_.sensitivity) {
+                check_sensitivity(game, game_seed);
+            }
+
+            std::string report;
+            if (engines_disagree(game, &report)) {
+                report_game_failure(game, game_seed, report);
+            }
+        }
+
+        std::cout << "Checked " << games_checked_ << " games (" << vertices_checked_ << " vertices) on "
+                  << engines_.size() << " engines and " << formula_checks_ << " (constraint, time) pairs on "
+                  << formula_engines_.size() << " evaluators: " << failures_ << " failure(s)\n";
+        if (config_.sensitivity) {
+            std::cout << "Sensitivity: " << critical_checked_ << " critical (edge, time) pairs confirmed by re-solving, "
+                      << critical_missed_ << " missed (joint flips)\n";
+        }
+        return failures_ == 0;
+    }
+
+private:
+    bool select_engines() {
+        engines_ = all_engines();
+        bool compiled = config_.compile_constraints;
+        if (!compiled && config_.compiled_evaluator) {
+            std::string reason;
+            compiled = codegen_available(reason);
+            if (!compiled && !config_.quiet) {
+                log_info("Skipping the compiled constraint evaluator: ", reason);
+            }
+        }
+        formula_engines_ = all_formula_engines(compiled);
+        if (config_.engines.empty()) {
+            return true;
+        }
+        // The reference engine always runs; others only when requested
+        std::vector<Engine> selected = {engines_.front()};
+        for (const auto& name : config_.engines) {
+            auto it = std::find_if(engines_.begin(), engines_.end(),
+                                   [&](const Engine& engine) { return engine.name == name; });
+            if (it == engines_.end()) {
+                log_error("Unknown engine: ", name);
+                return false;
+            }
+            if (it != engines_.begin()) {
+                selected.push_back(*it);
+            }
+        }
+        engines_ = selected;
+        return true;
+    }
+
+    DiffGame generate_game(uint64_t game_seed) const {
+        std::mt19937_64 rng(game_seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        DiffGame game;
+        size_t vertices = config_.min_vertices + rng() % (config_.max_vertices - config_.min_vertices + 1);
+        game.time_bound = 1 + static_cast<int>(rng() % static_cast<uint64_t>(config_.max_time));
+
+        ggg::graphs::GameGeneratorOptions options;
+        options.time_bound = game.time_bound;
+        options.nesting_depth = 1 + static_cast<int>(rng() % static_cast<uint64_t>(config_.max_nesting_depth));
+        options.seed = rng();
+        ggg::graphs::GameGenerator constraints(options);
+
+        // Some games leave Player 1 without choices so the single-player fast path is exercised
+        bool single_player = unit(rng) < config_.single_player_ratio;
+        for (size_t v = 0; v < vertices; ++v) {
+            game.players.push_back(static_cast<int>(rng() % 2));
+            game.targets.push_back(unit(rng) < config_.target_ratio);
+        }
+        if (!game.has_target()) {
+            game.targets[rng() % vertices] = true;
+        }
+
+        // Own stream, so the rest of the game is the same as without target constraints
+        std::mt19937_64 target_rng(game_seed ^ 0x7461726765747321ULL);
+        options.seed = target_rng();
+        ggg::graphs::GameGenerator target_constraints(options);
+        game.target_constraints.assign(vertices, std::nullopt);
+        for (size_t v = 0; v < vertices; ++v) {
+            if (game.targets[v] && std::uniform_real_distribution<double>(0.0, 1.0)(target_rng) <
+                                       config_.target_constraint_ratio) {
+                game.target_constraints[v] = target_constraints.generate_constraint();
+            }
+        }
+
+        for (size_t v = 0; v < vertices; ++v) {
+            size_t degree = rng() % (config_.max_degree + 1);
+            if (single_player && game.players[v] == 1) {
+                degree = std::min<size_t>(degree, 1);
+            }
+            std::vector<size_t> used;
+            for (size_t d = 0; d < degree; ++d) {
+                size_t target = rng() % vertices;
+                if (std::find(used.begin(), used.end(), target) != used.end()) {
+                    continue;
+                }
+                used.push_back(target);
+                bool constrained = unit(rng) >= config_.unconstrained_ratio;
+                game.edges.push_back({v, target, constrained,
+                                      constrained ? constraints.generate_constraint() : GeneratedConstraint{}});
+            }
+        }
+        return game;
+    }
+
+    LoadedGame load(const DiffGame& game) const {
+        LoadedGame loaded;
+        loaded.manager = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+        if (!loaded.manager->load_from_dot_string(game.to_dot(""))) {
+            throw std::runtime_error("DOT loader rejected the game");
+        }
+        if (config_.compile_constraints) {
+            ggg::codegen::ConstraintCompiler compiler(codegen_cache_dir());
+            if (!compiler.compile(*loaded.manager) && compiler.get_report().constrained_edges > 0) {
+                throw std::runtime_error("constraint codegen failed: " + compiler.get_report().fallback_reason);
+            }
+        }
+        loaded.objective = std::make_shared<ggg::graphs::GGGReachabilityObjective>(
+            ggg::graphs::GGGReachabilityObjective::Type::REACHABILITY, loaded.manager->get_target_vertices());
+        return loaded;
+    }
+
+    /**
+     * @brief Run every engine; describe the first disagreement with the reference in report
+     */
+    bool engines_disagree(const DiffGame& game, std::string* report) const {
+        std::vector<Winners> results;
+        std::ostringstream out;
+        try {
+            LoadedGame loaded = load(game);
+            for (const auto& engine : engines_) {
+                results.push_back(engine.solve(game, loaded));
+            }
+        } catch (const std::exception& e) {
+            if (report) *report = std::string("exception: ") + e.what();
+            return true;
+        }
+
+        bool disagree = false;
+        for (size_t e = 1; e < engines_.size(); ++e) {
+            for (size_t v = 0; v < game.vertex_count(); ++v) {
+                if (results[e][v] != results[0][v]) {
+                    disagree = true;
+                    out << "  v" << v << ": " << engines_[0].name << " says player " << results[0][v]
+                        << ", " << engines_[e].name << " says player " << results[e][v] << "\n";
+                }
+            }
+        }
+        if (report) *report = out.str();
+        return disagree;
+    }
+
+    void check_formulas(const DiffGame& game, uint64_t game_seed) {
+        std::vector<GeneratedConstraint> constraints;
+        for (const auto& edge : game.edges) {
+            if (edge.constrained) {
+                constraints.push_back(edge.constraint);
+            }
+        }
+        for (const auto& engine : formula_engines_) {
+            if (engine.prepare_game) {
+                engine.prepare_game(constraints);
+            }
+        }
+        for (const auto& edge : game.edges) {
+            if (!edge.constrained) {
+                continue;
+            }
+            int time = -1;
+            std::string evaluator;
+            if (find_formula_mismatch(edge.constraint, game.time_bound, &time, &evaluator)) {
+                report_formula_failure(edge.constraint, game.time_bound, game_seed, evaluator);
+            }
+        }
+    }
+
+    /**
+     * @brief Re-solve with each (edge, time) removed; every reported critical pair must change layer 0
+     *
+     * Pairs the analysis misses are counted, not failures: it does not see flips
+     * that only change layer 0 together.
+     */
+    void check_sensitivity(const DiffGame& game, uint64_t game_seed) {
+        // Brute force: the direction in which layer 0 moves for each (edge, time), 0 if it does not
+        Winners base = solve_by_definition(game);
+        std::vector<std::vector<int>> effect(game.edges.size(), std::vector<int>(game.time_bound, 0));
+        for (size_t e = 0; e < game.edges.size(); ++e) {
+            for (int time = 0; time < game.time_bound; ++time) {
+                Winners changed = solve_by_definition(game, e, time);
+                for (size_t v = 0; v < game.vertex_count(); ++v) {
+                    if (changed[v] != base[v]) {
+                        effect[e][time] = changed[v] == 1 ? -1 : 1;
+                    }
+                }
+            }
+        }
+
+        std::ostringstream out;
+        try {
+            LoadedGame loaded = load(game);
+            ggg::solvers::SensitivityAnalysis analysis(loaded.manager, loaded.objective, game.time_bound);
+            const auto& graph = *loaded.manager->graph();
+            for (const auto& critical : analysis.analyze()) {
+                // Generated games have no parallel edges, so endpoints identify the edge
+                size_t source = std::stoul(graph[boost::source(critical.edge, graph)].name.substr(1));
+                size_t target = std::stoul(graph[boost::target(critical.edge, graph)].name.substr(1));
+                size_t e = static_cast<size_t>(std::find_if(game.edges.begin(), game.edges.end(),
+                    [&](const DiffEdge& edge) { return edge.source == source && edge.target == target; })
+                    - game.edges.begin());
+                for (const auto& [first, last] : critical.windows) {
+                    for (int time = first; time <= last; ++time) {
+                        if (effect[e][time] != (critical.player0_loses ? -1 : 1)) {
+                            out << "  v" << source << " -> v" << target << " at time " << time << " reported "
+                                << (critical.player0_loses ? "player0_loses" : "player0_gains")
+                                << ", re-solving says " << (effect[e][time] == 0 ? "no change" : "the opposite")
+                                << "\n";
+                        }
+                        effect[e][time] = 0;
+                        critical_checked_++;
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            out << "  exception: " << e.what() << "\n";
+        }
+        for (const auto& times : effect) {
+            critical_missed_ += static_cast<size_t>(std::count_if(times.begin(), times.end(),
+                                                                  [](int moved) { return moved != 0; }));
+        }
+
+        if (!out.str().empty()) {
+            failures_++;
+            std::string comment = "temporis_difftest sensitivity mismatch (game seed " + std::to_string(game_seed) + ")";
+            std::string file = write_reproducer("sensitivity_" + std::to_string(game_seed) + "_" +
+                                                std::to_string(failures_), game, comment);
+            log_error("Sensitivity analysis reports a non-critical edge on game seed ", game_seed, ": ", file);
+            if (!config_.quiet) {
+                std::cerr << out.str();
+            }
+        }
+    }
+
+    // Compare every evaluator with the reference at each time step in [0, time_bound]
+    bool find_formula_mismatch(const GeneratedConstraint& constraint, int time_bound,
+                               int* mismatch_time, std::string* evaluator) {
+        std::vector<std::function<bool(int)>> prepared;
+        for (const auto& engine : formula_engines_) {
+            prepared.push_back(engine.prepare(constraint));
+        }
+        for (int time = 0; time <= time_bound; ++time) {
+            bool expected = prepared[0](time);
+            for (size_t e = 1; e < prepared.size(); ++e) {
+                formula_checks_++;
+                if (prepared[e](time) != expected) {
+                    *mismatch_time = time;
+                    *evaluator = formula_engines_[e].name;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void report_formula_failure(GeneratedConstraint constraint, int time_bound, uint64_t game_seed,
+                                const std::string& evaluator) {
+        failures_++;
+        int time = -1;
+        std::string current_evaluator = evaluator;
+
+        // Shrink to the smallest sub-constraint that still mismatches
+        bool progress = config_.minimize;
+        while (progress) {
+            progress = false;
+            for (const auto& child : constraint.children) {
+                int child_time = -1;
+                std::string child_evaluator;
+                if (find_formula_mismatch(child, time_bound, &child_time, &child_evaluator)) {
+                    constraint = child;
+                    progress = true;
+                    break;
+                }
+            }
+        }
+        find_formula_mismatch(constraint, time_bound, &time, &current_evaluator);
+
+        // One edge into a target, enabled exactly when the constraint holds at the last step
+        DiffGame repro;
+        repro.time_bound = time + 1;
+        repro.players = {0, 0};
+        repro.targets = {false, true};
+        repro.target_constraints = {std::nullopt, std::nullopt};
+        repro.edges.push_back({0, 1, true, constraint});
+
+        auto& engines = formula_engines_;
+        std::ostringstream comment;
+        comment << "temporis_difftest formula mismatch (game seed " << game_seed << "): \""
+                << constraint.to_string() << "\" at time " << time << ", " << engines.front().name
+                << " vs " << current_evaluator;
+        std::string name = "formula_" + std::to_string(game_seed) + "_" + std::to_string(failures_);
+        std::string file = write_reproducer(name, repro, comment.str());
+        log_error("Formula mismatch: \"", constraint.to_string(), "\" at time ", time, " (",
+                  engines.front().name, " vs ", current_evaluator, "), reproducer ", file);
+    }
+
+    void report_game_failure(const DiffGame& game, uint64_t game_seed, const std::string& report) {
+        failures_++;
+        DiffGame reduced = config_.minimize ? minimize(game) : game;
+        std::string reduced_report;
+        engines_disagree(reduced, &reduced_report);
+
+        std::string comment = "temporis_difftest engine mismatch (game seed " + std::to_string(game_seed) + ")";
+        std::string name = "game_" + std::to_string(game_seed) + "_" + std::to_string(failures_);
+        std::string file = write_reproducer(name, reduced, comment);
+        log_error("Engines disagree on game seed ", game_seed, " (", game.vertex_count(), " vertices, ",
+                  game.edges.size(), " edges, time bound ", game.time_bound, "); minimized to ",
+                  reduced.vertex_count(), " vertices, ", reduced.edges.size(), " edges, time bound ",
+                  reduced.time_bound, ": ", file);
+        if (!config_.quiet) {
+            std::cerr << (reduced_report.empty() ? report : reduced_report);
+        }
+    }
+
+    /**
+     * @brief Greedily shrink a failing game while the engines keep disagreeing
+     *
+     * Tries, until nothing changes: shorter horizons, removing chunks of edges,
+     * removing vertices and simplifying constraints to a child or to no constraint.
+     */
+    DiffGame minimize(DiffGame game) const {
+        auto fails = [this](const DiffGame& candidate) {
+            return candidate.has_target() && engines_disagree(candidate, nullptr);
+        };
+
+        bool progress = true;
+        while (progress) {
+            progress = false;
+
+            for (int time_bound : {1, game.time_bound / 2, game.time_bound - 1}) {
+                if (time_bound >= 1 && time_bound < game.time_bound) {
+                    DiffGame candidate = game;
+                    candidate.time_bound = time_bound;
+                    if (fails(candidate)) {
+                        game = candidate;
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+
+            for (size_t chunk = std::max<size_t>(1, game.edges.size() / 2); chunk >= 1; chunk /= 2) {
+                for (size_t start = 0; start < game.edges.size();) {
+                    DiffGame candidate = game;
+                    size_t end = std::min(start + chunk, candidate.edges.size());
+                    candidate.edges.erase(candidate.edges.begin() + start, candidate.edges.begin() + end);
+                    if (fails(candidate)) {
+                        game = candidate;
+                        progress = true;
+                    } else {
+                        start += chunk;
+                    }
+                }
+                if (chunk == 1) break;
+            }
+
+            for (size_t v = 0; v < game.vertex_count();) {
+                DiffGame candidate = remove_vertex(game, v);
+                if (fails(candidate)) {
+                    game = candidate;
+                    progress = true;
+                } else {
+                    ++v;
+                }
+            }
+
+            for (size_t v = 0; v < game.vertex_count(); ++v) {
+                if (!game.target_constraints[v]) {
+                    continue;
+                }
+                DiffGame candidate = game;
+                candidate.target_constraints[v].reset();
+                if (fails(candidate)) {
+                    game = candidate;
+                    progress = true;
+                }
+            }
+
+            for (size_t e = 0; e < game.edges.size(); ++e) {
+                if (!game.edges[e].constrained) {
+                    continue;
+                }
+                DiffGame candidate = game;
+                candidate.edges[e].constrained = false;
+                if (fails(candidate)) {
+                    game = candidate;
+                    progress = true;
+                    continue;
+                }
+                for (const auto& child : game.edges[e].constraint.children) {
+                    candidate = game;
+                    candidate.edges[e].constraint = child;
+                    if (fails(candidate)) {
+                        game = candidate;
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+        }
+        return game;
+    }
+
+    static DiffGame remove_vertex(const DiffGame& game, size_t removed) {
+        DiffGame result;
+        result.time_bound = game.time_bound;
+        for (size_t v = 0; v < game.vertex_count(); ++v) {
+            if (v != removed) {
+                result.players.push_back(game.players[v]);
+                result.targets.push_back(game.targets[v]);
+                result.target_constraints.push_back(game.target_constraints[v]);
+            }
+        }
+        for (auto edge : game.edges) {
+            if (edge.source == removed || edge.target == removed) {
+                continue;
+            }
+            if (edge.source > removed) edge.source--;
+            if (edge.target > removed) edge.target--;
+            result.edges.push_back(edge);
+        }
+        return result;
+    }
+
+    std::string write_reproducer(const std::string& name, const DiffGame& game, const std::string& comment) const {
+        std::error_code error;
+        std::filesystem::create_directories(config_.output_dir, error);
+        std::string file = (std::filesystem::path(config_.output_dir) / (name + ".dot")).string();
+        std::ofstream out(file);
+        if (!out.is_open()) {
+            log_error("Cannot write reproducer ", file);
+            return "(not written)";
+        }
+        out << game.to_dot(comment);
+        return file;
+    }
+
+    void print_usage() const {
+        std::cout << "Temporis Differential Tester\n\n";
+        std::cout << "USAGE:\n";
+        std::cout << "  temporis_difftest [OPTIONS]\n\n";
+        std::cout << "Generates random games and checks that every solver engine computes the same\n";
+        std::cout << "winner for every vertex, and that every constraint evaluator agrees with the\n";
+        std::cout << "tree-interpreted PresburgerFormula for each (constraint, time). Failing cases\n";
+        std::cout << "are minimized and written as DOT reproducers.\n\n";
+        std::cout << "OPTIONS:\n";
+        std::cout << "  -n, --games N          Number of random games (default: 200)\n";
+        std::cout << "  -s, --seed N           Seed of the first game; game i uses seed + i (default: 1)\n";
+        std::cout << "  --min-vertices N       Minimum vertices per game (default: 2)\n";
+        std::cout << "  --max-vertices N       Maximum vertices per game (default: 12)\n";
+        std::cout << "  --max-degree N         Maximum out-degree (default: 3)\n";
+        std::cout << "  --max-time N           Maximum time bound (default: 30)\n";
+        std::cout << "  --nesting-depth D      Maximum constraint nesting depth (default: 3)\n";
+        std::cout << "  --engines LIST         Engines compared with the reference (default: all)\n";
+        std::cout << "  -o, --output-dir DIR   Directory for reproducers (default: difftest_failures)\n";
+        std::cout << "  --max-failures N       Stop after N failures (default: 10)\n";
+        std::cout << "  --no-minimize          Write failing games without shrinking them\n";
+        std::cout << "  -q, --quiet            Do not print per-vertex disagreements\n";
+        std::cout << "  --compile-constraints  Also solve games with natively compiled constraints, and require the\n";
+        std::cout << "                         compiled evaluator (needs a C++ compiler)\n";
+        std::cout << "  --no-compiled-evaluator  Skip the compiled evaluator, which runs whenever a compiler is found\n";
+        std::cout << "  --sensitivity          Also check the reported critical edges by re-solving without them\n";
+        std::cout << "  -h, --help             Show this help\n\n";
+        std::cout << "ENGINES:\n ";
+        for (const auto& engine : all_engines()) {
+            std::cout << " " << engine.name;
+        }
+        std::cout << " (the first is the reference)\n";
+        std::cout << "CONSTRAINT EVALUATORS:\n ";
+        for (const auto& engine : all_formula_engines(true)) {
+            std::cout << " " << engine.name;
+        }
+        std::cout << " (the first is the reference)\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    DifferentialTester tester;
+
+    ParseResult parsed = tester.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 1;
+    }
+
+    try {
+        return tester.run() ? 0 : 1;
+    } catch (const std::exception& e) {
+        log_error(e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,247 @@
+#include "game_generator.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// Simple logging helpers for temporis_gen
+namespace {
+    template<typename... Args>
+    void log_error(Args... args) {
+        std::cerr << "[ERROR] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+
+    template<typename... Args>
+    void log_info(Args... args) {
+        std::cerr << "[INFO] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+}
+
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
+/**
+ * @brief Command line front end for the synthetic temporal game generator
+ */
+class GameGeneratorExecutor {
+private:
+    ggg::graphs::GameGeneratorOptions options_;
+    std::string output_file_;
+    bool quiet_ = false;
+
+    // std::stoull wraps a negative value to a huge count instead of rejecting it
+    static size_t parse_count(const std::string& value) {
+        if (value.find('-') != std::string::npos) {
+            throw std::invalid_argument(value);
+        }
+        return std::stoull(value);
+    }
+
+public:
+    ParseResult parse_arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            std::string value;
+            auto next_value = [&]() {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+
+            try {
+                if (arg == "--help" || arg == "-h") {
+                    print_usage();
+                    return ParseResult::HELP;
+                } else if (arg == "--quiet" || arg == "-q") {
+                    quiet_ = true;
+                } else if (arg == "--vertices" || arg == "-n") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.vertices = parse_count(value);
+                    if (options_.vertices == 0) {
+                        log_error("Vertex count must be positive");
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--edges" || arg == "-m") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.edges = parse_count(value);
+                } else if (arg == "--degree-dist") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    if (!ggg::graphs::GameGeneratorOptions::parse_degree_distribution(value, options_.degree_distribution)) {
+                        log_error("Unknown degree distribution: ", value);
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--power-law-exponent") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.power_law_exponent = std::stod(value);
+                    if (options_.power_law_exponent <= 2.0) {
+                        log_error("Power-law exponent must be greater than 2");
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--min-degree") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.min_degree = parse_count(value);
+                } else if (arg == "--player1-ratio") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.player1_ratio = std::stod(value);
+                } else if (arg == "--target-density") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.target_density = std::stod(value);
+                } else if (arg == "--time-bound" || arg == "-t") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.time_bound = std::stoi(value);
+                    if (options_.time_bound <= 0) {
+                        log_error("Time bound must be positive");
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--mix") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    if (!options_.set_constraint_mix(value)) {
+                        log_error("Unknown constraint mix: ", value);
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--families") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    if (!parse_family_weights(value)) {
+                        return ParseResult::INVALID;
+                    }
+                } else if (arg == "--nesting-depth") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.nesting_depth = std::max(1, std::stoi(value));
+                } else if (arg == "--seed" || arg == "-s") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    options_.seed = std::stoull(value);
+                } else if (arg == "--output" || arg == "-o") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    output_file_ = value;
+                } else {
+                    log_error("Unknown option: ", arg);
+                    return ParseResult::INVALID;
+                }
+            } catch (const std::exception&) {
+                log_error("Invalid value for ", arg, ": ", value);
+                return ParseResult::INVALID;
+            }
+        }
+        return ParseResult::RUN;
+    }
+
+    int run() {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t edges_written = 0;
+
+        ggg::graphs::GameGenerator generator(options_);
+        if (output_file_.empty()) {
+            std::ios::sync_with_stdio(false);
+            edges_written = generator.write_dot(std::cout);
+            std::cout.flush();
+        } else {
+            // Large stream buffer so multi-gigabyte games are written efficiently
+            std::vector<char> buffer(1 << 22);
+            std::ofstream out;
+            out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            out.open(output_file_, std::ios::binary);
+            if (!out.is_open()) {
+                log_error("Cannot open output file: ", output_file_);
+                return 1;
+            }
+            edges_written = generator.write_dot(out);
+            out.close();
+            if (!out) {
+                log_error("Failed writing output file: ", output_file_);
+                return 1;
+            }
+        }
+
+        if (!quiet_) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            log_info("Generated ", options_.vertices, " vertices, ", edges_written, " edges in ",
+                     std::fixed, std::setprecision(3), elapsed.count(), "s");
+        }
+        return 0;
+    }
+
+private:
+    // Parse "threshold=1,interval=0.5,..." into family weights
+    bool parse_family_weights(const std::string& value) {
+        options_.threshold_weight = options_.interval_weight = options_.modulus_weight = 0.0;
+        options_.existential_weight = options_.unconstrained_weight = 0.0;
+
+        std::istringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            auto eq = item.find('=');
+            std::string family = item.substr(0, eq);
+            double weight = eq == std::string::npos ? 1.0 : std::stod(item.substr(eq + 1));
+
+            if (family == "threshold") {
+                options_.threshold_weight = weight;
+            } else if (family == "interval") {
+                options_.interval_weight = weight;
+            } else if (family == "modulus") {
+                options_.modulus_weight = weight;
+            } else if (family == "existential") {
+                options_.existential_weight = weight;
+            } else if (family == "none") {
+                options_.unconstrained_weight = weight;
+            } else {
+                log_error("Unknown constraint family: ", family);
+                return false;
+            }
+        }
+
+        if (options_.threshold_weight + options_.interval_weight + options_.modulus_weight +
+            options_.existential_weight + options_.unconstrained_weight <= 0.0) {
+            log_error("At least one constraint family needs a positive weight");
+            return false;
+        }
+        return true;
+    }
+
+    void print_usage() const {
+        std::cout << "Temporis Synthetic Game Generator\n\n";
+        std::cout << "USAGE:\n";
+        std::cout << "  temporis_gen [OPTIONS] > game.dot\n";
+        std::cout << "  temporis_gen [OPTIONS] -o game.dot\n\n";
+        std::cout << "OPTIONS:\n";
+        std::cout << "  -n, --vertices N            Number of vertices (default: 100)\n";
+        std::cout << "  -m, --edges N               Number of edges (exact for fixed degrees, mean otherwise; default: 400)\n";
+        std::cout << "  --degree-dist NAME          fixed, uniform or power-law (default: fixed)\n";
+        std::cout << "  --power-law-exponent A      Exponent of the power-law distribution, > 2 (default: 2.5)\n";
+        std::cout << "  --min-degree N              Minimum out-degree per vertex (default: 1)\n";
+        std::cout << "  --player1-ratio R           Fraction of player 1 vertices (default: 0.5)\n";
+        std::cout << "  --target-density D          Fraction of target vertices (default: 0.1)\n";
+        std::cout << "  -t, --time-bound T          Horizon written as the time_bound comment (default: 50)\n";
+        std::cout << "  --mix NAME                  Single family or 'mixed' (default: mixed)\n";
+        std::cout << "  --families LIST             Family weights, e.g. threshold=2,modulus=1,none=1\n";
+        std::cout << "                              Families: threshold, interval, modulus, existential, none\n";
+        std::cout << "  --nesting-depth D           1 = atoms, 2 = conjunctions, >= 3 = disjunctions of\n";
+        std::cout << "                              D-1 conjunctions (default: 1)\n";
+        std::cout << "  -s, --seed N                Random seed (default: 42)\n";
+        std::cout << "  -o, --output FILE           Write to FILE instead of stdout\n";
+        std::cout << "  -q, --quiet                 Suppress the summary on stderr\n";
+        std::cout << "  -h, --help                  Show this help\n\n";
+        std::cout << "Output is streamed, so instances larger than memory can be generated.\n";
+        std::cout << "The same options and seed always produce identical games.\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    GameGeneratorExecutor executor;
+
+    ParseResult parsed = executor.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 1;
+    }
+
+    return executor.run();
+}
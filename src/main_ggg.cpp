@@ -1,10 +1,26 @@
+#include "autotune.hpp"
+#include "component_solver.hpp"
+#include "constraint_codegen.hpp"
 #include "ggg_temporal_solver.hpp"
 #include "ggg_temporal_graph.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "play_simulator.hpp"
+#include "run_statistics.hpp"
+#include "sensitivity_analysis.hpp"
+#include "trace.hpp"
+#include "workload_bundle.hpp"
 #include "libggg/utils/solver_wrapper.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <mutex>
 #include <sstream>
+#include <optional>
 
 // Simple logging helpers for temporis
 namespace {
@@ -48,10 +64,11 @@ class TemporalReachabilityExecutor {
 private:
     std::shared_ptr<ggg::graphs::GGGTemporalGameManager> manager_;
     std::shared_ptr<ggg::graphs::GGGReachabilityObjective> objective_;
+    ggg::stats::RunStatistics run_stats_;
     
 public:
     TemporalReachabilityExecutor() 
-        : manager_(std::make_shared<ggg::graphs::GGGTemporalGameManager>()) {}
+        : manager_(std::make_shared<ggg::graphs::GGGTemporalGameManager>()), run_stats_("temporis") {}
     
     // Extract time bound from DOT content comments
     int extract_time_bound_from_content(const std::string& content) {
@@ -83,12 +100,36 @@ public:
         bool validate_only = false;
         bool csv_output = false;
         bool time_only = false;
+        bool perf_counters = false;
+        bool fast_path = true;
+        bool activity_index = true;
+        bool decompose = false;
+        int threads = -1;
+        bool autotune = false;
+        bool use_profile = true;
+        std::string profile_file;
+        bool compile_constraints = false;
+        std::string codegen_cache;
+        bool lazy_constraints = false;
+        std::string query;
+        std::string stats_json_file;
+        std::string capture_file;
+        std::optional<ggg::solvers::SpeculativeSweep::Predictor> speculate;
+        int speculate_chunks = 0;
+        int speculate_warmup = ggg::solvers::SpeculativeSweep::kDefaultWarmupLayers;
+        std::string speculate_table;
+        std::vector<std::string> run_arguments;
+        std::string layer_series_file;
+        std::string sensitivity_file;
+        ggg::solvers::SimulationOptions simulation;
+        int layer_sample = 1;
         std::string filename;
         int user_time_bound = -1;
         
         // Set up logging based on verbosity
         for (int i = 1; i < argc; i++) {
             std::string arg = argv[i];
+            int option_start = i;
             if (arg == "--verbose" || arg == "-v") {
                 verbose = true;
                 g_verbose = true;
@@ -106,6 +147,177 @@ public:
                 csv_output = true;
             } else if (arg == "--time-only") {
                 time_only = true;
+            } else if (arg == "--trace") {
+                if (i + 1 >= argc) {
+                    log_error("--trace requires a file name");
+                    return 1;
+                }
+                start_tracing(argv[++i]);
+            } else if (arg == "--no-fast-path") {
+                fast_path = false;
+            } else if (arg == "--no-activity-index") {
+                activity_index = false;
+            } else if (arg == "--decompose") {
+                decompose = true;
+            } else if (arg == "--threads") {
+                if (i + 1 >= argc) {
+                    log_error("--threads requires a value");
+                    return 1;
+                }
+                try {
+                    threads = std::stoi(argv[++i]);
+                } catch (const std::exception&) {
+                    threads = -1;
+                }
+                if (threads < 0) {
+                    log_error("Invalid thread count: ", argv[i]);
+                    return 1;
+                }
+            } else if (arg == "--autotune") {
+                autotune = true;
+            } else if (arg == "--profile") {
+                if (i + 1 >= argc) {
+                    log_error("--profile requires a file name");
+                    return 1;
+                }
+                profile_file = argv[++i];
+            } else if (arg == "--no-profile") {
+                use_profile = false;
+            } else if (arg == "--speculate") {
+                ggg::solvers::SpeculativeSweep::Predictor predictor;
+                if (i + 1 >= argc || !ggg::solvers::SpeculativeSweep::parse_predictor(argv[i + 1], predictor)) {
+                    log_error("--speculate requires periodic or warmup");
+                    return 1;
+                }
+                speculate = predictor;
+                ++i;
+            } else if (arg == "--speculate-chunks" || arg == "--speculate-warmup") {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return 1;
+                }
+                int value = 0;
+                try {
+                    value = std::stoi(argv[++i]);
+                } catch (const std::exception&) {
+                    value = 0;
+                }
+                if (value <= 0) {
+                    log_error("Invalid value for ", arg, ": ", argv[i]);
+                    return 1;
+                }
+                (arg == "--speculate-chunks" ? speculate_chunks : speculate_warmup) = value;
+            } else if (arg == "--speculate-table") {
+                if (i + 1 >= argc) {
+                    log_error("--speculate-table requires a file name");
+                    return 1;
+                }
+                speculate_table = argv[++i];
+            } else if (arg == "--lazy-constraints") {
+                lazy_constraints = true;
+            } else if (arg == "--query") {
+                if (i + 1 >= argc) {
+                    log_error("--query requires a vertex name");
+                    return 1;
+                }
+                query = argv[++i];
+            } else if (arg == "--compile-constraints") {
+                compile_constraints = true;
+            } else if (arg == "--codegen-cache") {
+                if (i + 1 >= argc) {
+                    log_error("--codegen-cache requires a directory");
+                    return 1;
+                }
+                codegen_cache = argv[++i];
+                compile_constraints = true;
+            } else if (arg == "--perf-counters") {
+                perf_counters = true;
+            } else if (arg == "--stats-json") {
+                if (i + 1 >= argc) {
+                    log_error("--stats-json requires a file name");
+                    return 1;
+                }
+                stats_json_file = argv[++i];
+            } else if (arg == "--capture") {
+                if (i + 1 >= argc) {
+                    log_error("--capture requires a file name");
+                    return 1;
+                }
+                capture_file = argv[++i];
+            } else if (arg == "--layer-series") {
+                if (i + 1 >= argc) {
+                    log_error("--layer-series requires a file name");
+                    return 1;
+                }
+                layer_series_file = argv[++i];
+            } else if (arg == "--sensitivity") {
+                if (i + 1 >= argc) {
+                    log_error("--sensitivity requires a file name");
+                    return 1;
+                }
+                sensitivity_file = argv[++i];
+            } else if (arg == "--simulate") {
+                if (i + 1 >= argc) {
+                    log_error("--simulate requires a number of plays");
+                    return 1;
+                }
+                // Digits only: stoull accepts a sign and wraps negative counts
+                std::string plays = argv[++i];
+                simulation.plays = 0;
+                if (!plays.empty() && std::all_of(plays.begin(), plays.end(), [](unsigned char c) { return std::isdigit(c); })) {
+                    try {
+                        simulation.plays = std::stoull(plays);
+                    } catch (const std::exception&) {
+                        simulation.plays = 0;
+                    }
+                }
+                if (simulation.plays == 0) {
+                    log_error("Invalid number of plays: ", argv[i]);
+                    return 1;
+                }
+            } else if (arg == "--simulate-player0" || arg == "--simulate-player1") {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a policy");
+                    return 1;
+                }
+                std::string policy = argv[++i];
+                bool known = arg == "--simulate-player0" ? ggg::solvers::SimulationOptions::parse(policy, simulation.player0)
+                                                         : ggg::solvers::SimulationOptions::parse(policy, simulation.player1);
+                if (!known) {
+                    log_error("Unknown ", arg, " policy: ", policy);
+                    return 1;
+                }
+            } else if (arg == "--simulate-from") {
+                if (i + 1 >= argc || (std::string(argv[i + 1]) != "winning" && std::string(argv[i + 1]) != "all")) {
+                    log_error("--simulate-from requires winning or all");
+                    return 1;
+                }
+                simulation.from_winning = std::string(argv[++i]) == "winning";
+            } else if (arg == "--simulate-seed") {
+                if (i + 1 >= argc) {
+                    log_error("--simulate-seed requires a value");
+                    return 1;
+                }
+                try {
+                    simulation.seed = std::stoull(argv[++i]);
+                } catch (const std::exception&) {
+                    log_error("Invalid simulation seed: ", argv[i]);
+                    return 1;
+                }
+            } else if (arg == "--layer-sample") {
+                if (i + 1 >= argc) {
+                    log_error("--layer-sample requires a value");
+                    return 1;
+                }
+                try {
+                    layer_sample = std::stoi(argv[++i]);
+                } catch (const std::exception&) {
+                    layer_sample = 0;
+                }
+                if (layer_sample <= 0) {
+                    log_error("Invalid layer sample interval: ", argv[i]);
+                    return 1;
+                }
             } else if (arg == "--help" || arg == "-h") {
                 print_usage();
                 return 0;
@@ -129,18 +341,48 @@ public:
             } else if (arg.find(".dot") != std::string::npos) {
                 filename = arg;
             }
+            
+            // Options of a captured run; the bundle carries the input itself, and output files are
+            // left out so that a replay cannot overwrite what the captured run wrote
+            bool input_file = option_start == i && arg == filename;
+            bool output_file = arg == "--capture" || arg == "--stats-json" || arg == "--trace" ||
+                               arg == "--layer-series" || arg == "--sensitivity";
+            if (!output_file && !input_file) {
+                run_arguments.insert(run_arguments.end(), argv + option_start, argv + i + 1);
+            }
+        }
+        
+        if (autotune) {
+            return run_autotune(profile_file, threads);
+        }
+        
+        // Explicit options win over the profile, the profile over the built-in defaults
+        ggg::solvers::TuningProfile profile;
+        if (use_profile) {
+            load_profile(profile_file, profile);
+        }
+        if (threads < 0) {
+            threads = profile.threads;
+        }
+        
+        if (perf_counters && !ggg::perf::PerfCounters::instance().enable()) {
+            log_debug("Hardware counters unavailable: ", ggg::perf::PerfCounters::instance().unavailable_reason());
         }
         
         // Handle input: either from file or stdin
         std::string game_content;
         bool using_stdin = filename.empty();
         
+        ggg::trace::Tracer::instance().set_thread_name("main");
+        std::optional<ggg::trace::ScopedTrace> read_trace(std::in_place, "read_input", "io");
+        std::optional<ggg::stats::ScopedPhase> read_phase(std::in_place, run_stats_, "read");
         if (using_stdin) {
             log_debug("Reading game from stdin");
-            // Read entire input from stdin
-            std::string line;
-            while (std::getline(std::cin, line)) {
-                game_content += line + "\n";
+            // Read entire input from stdin, byte for byte so that --capture stores it unchanged
+            char chunk[1 << 16];
+            size_t chunk_size;
+            while ((chunk_size = std::fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+                game_content.append(chunk, chunk_size);
             }
             
             if (game_content.empty()) {
@@ -160,29 +402,32 @@ public:
         } else {
             log_debug("Loading game from file: ", filename);
             
+            // Read the file once; it is parsed from memory below
+            std::ifstream file(filename);
+            if (!file.is_open()) {
+                log_error("Failed to load game from: ", filename);
+                return 1;
+            }
+            game_content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            
             // Extract time bound from file content if not provided via command line
             if (user_time_bound <= 0) {
-                std::ifstream file(filename);
-                if (file.is_open()) {
-                    std::string file_content((std::istreambuf_iterator<char>(file)),
-                                           std::istreambuf_iterator<char>());
-                    int extracted_time_bound = extract_time_bound_from_content(file_content);
-                    if (extracted_time_bound > 0) {
-                        user_time_bound = extracted_time_bound;
-                        log_debug("Using time bound from file content: ", user_time_bound);
-                    }
-                    file.close();
+                int extracted_time_bound = extract_time_bound_from_content(game_content);
+                if (extracted_time_bound > 0) {
+                    user_time_bound = extracted_time_bound;
+                    log_debug("Using time bound from file content: ", user_time_bound);
                 }
             }
         }
         
-        // Load the game (either from file or from string content)
-        bool load_success;
-        if (using_stdin) {
-            load_success = manager_->load_from_dot_string(game_content);
-        } else {
-            load_success = manager_->load_from_dot_file(filename);
-        }
+        read_phase.reset();
+        read_trace.reset();
+        
+        // Load the game from the content read above
+        manager_->set_lazy_constraints(lazy_constraints);
+        bool load_success = manager_->load_from_dot_string(game_content);
+        run_stats_.set_input(using_stdin ? "stdin" : filename);
+        run_stats_.add_load_statistics(manager_->load_statistics());
         
         if (!load_success) {
             if (using_stdin) {
@@ -203,7 +448,20 @@ public:
             return valid ? 0 : 1;
         }
         
+        std::optional<ggg::codegen::ConstraintCompiler> codegen;
+        if (compile_constraints) {
+            codegen.emplace(codegen_cache);
+            if (codegen->compile(*manager_)) {
+                log_debug("Constraints compiled to ", codegen->get_report().object_path,
+                          codegen->get_report().cache_hit ? " (cache hit)" : "");
+            } else if (!csv_output && !time_only) {
+                log_info("Constraint codegen unavailable (", codegen->get_report().fallback_reason,
+                         "), interpreting constraints");
+            }
+        }
+        
         // Create objective from target vertices
+        std::optional<ggg::stats::ScopedPhase> preprocess_phase(std::in_place, run_stats_, "preprocess");
         auto targets = manager_->get_target_vertices();
         if (targets.empty()) {
             log_error("No target vertices found in game");
@@ -218,6 +476,11 @@ public:
         // Create and run solver
         auto solver = std::make_shared<ggg::solvers::GGGTemporalReachabilitySolver>(
             manager_, objective_, user_time_bound > 0 ? user_time_bound : 50, verbose);
+        solver->set_single_player_fast_path(fast_path);
+        solver->set_activity_index(activity_index);
+        if (profile.layer_dense_ratio > 0) {
+            solver->set_layer_dense_ratio(profile.layer_dense_ratio);
+        }
         
         // Only show solver info in normal output modes
         if (!csv_output && !time_only) {
@@ -225,27 +488,364 @@ public:
         }
         log_debug("Graph: ", boost::num_vertices(*manager_->graph()), " vertices, ",
                                  boost::num_edges(*manager_->graph()), " edges");
+        if (!speculate && (speculate_chunks > 0 || !speculate_table.empty())) {
+            speculate = ggg::solvers::SpeculativeSweep::Predictor::PERIODIC;
+        }
+        // The profile only decomposes runs that could have been given --decompose
+        if (!decompose && profile.decompose_min_components > 0 && query.empty() && layer_series_file.empty() &&
+            !speculate) {
+            size_t component_count = ggg::solvers::ComponentSolver::weakly_connected_components(*manager_->graph()).size();
+            if (component_count >= profile.decompose_min_components) {
+                log_debug("Decomposing: ", component_count, " components, profile threshold ",
+                          profile.decompose_min_components);
+                decompose = true;
+            }
+        }
+        if (decompose && !layer_series_file.empty()) {
+            log_error("--layer-series cannot be combined with --decompose");
+            return 1;
+        }
+        if (speculate && (decompose || !layer_series_file.empty())) {
+            log_error("--speculate cannot be combined with --decompose or --layer-series");
+            return 1;
+        }
+        std::optional<ggg::graphs::GGGTemporalVertex> query_vertex;
+        if (!query.empty()) {
+            if (decompose) {
+                log_error("--query cannot be combined with --decompose");
+                return 1;
+            }
+            query_vertex = find_vertex(query);
+            if (!query_vertex) {
+                log_error("No vertex named ", query);
+                return 1;
+            }
+        }
+        std::optional<ggg::solvers::SpeculativeSweep> speculation;
+        if (speculate) {
+            speculation.emplace(threads, speculate_chunks, *speculate);
+            speculation->set_warmup_layers(speculate_warmup);
+            std::string table_error;
+            if (!speculate_table.empty() && std::filesystem::exists(speculate_table) &&
+                !speculation->load_table(speculate_table, boost::num_vertices(*manager_->graph()), table_error)) {
+                log_debug("Ignoring speculation table: ", table_error);
+            }
+            solver->set_speculation(&*speculation);
+        }
+        std::optional<ggg::solvers::LayerSeries> layer_series;
+        if (!layer_series_file.empty()) {
+            layer_series.emplace(layer_sample);
+            solver->set_layer_series(&*layer_series);
+        }
+        preprocess_phase.reset();
         
         // Solve the game
-        auto solution = solver->solve(*manager_->graph());
+        int time_bound = user_time_bound > 0 ? user_time_bound : 50;
+        auto solve_start = std::chrono::steady_clock::now();
+        ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph> solution;
+        std::optional<ggg::solvers::ComponentSolver> components;
+        ggg::solvers::SolverStatistics component_totals;
+        if (decompose) {
+            components.emplace(manager_, objective_, threads,
+                               profile.component_batch_vertices > 0 ? profile.component_batch_vertices
+                                                                    : ggg::solvers::ComponentSolver::kDefaultBatchVertices);
+            solution = solve_components(*components, time_bound, fast_path, activity_index,
+                                        profile.layer_dense_ratio, component_totals);
+            component_totals.total_solve_time = std::chrono::steady_clock::now() - solve_start;
+        } else if (query_vertex) {
+            solution = solver->solve_from_state(*query_vertex);
+        } else {
+            solution = solver->solve(*manager_->graph());
+        }
+        run_stats_.add_phase("solve", std::chrono::steady_clock::now() - solve_start);
+        const auto& solve_stats = decompose ? component_totals : solver->get_statistics();
+        
+        // Only a layered sweep speculates; the single-player fast path does not
+        bool speculated = speculation && speculation->get_statistics().chunks > 0;
+        if (speculated && !speculate_table.empty() && !speculation->save_table(speculate_table)) {
+            log_error("Cannot write speculation table ", speculate_table);
+            return 1;
+        }
+        
+        if (layer_series && !layer_series->write(layer_series_file)) {
+            log_error("Cannot write layer series file ", layer_series_file);
+            return 1;
+        }
+        
+        // Critical edges of the whole game, independent of how it was solved
+        std::optional<ggg::solvers::SensitivityAnalysis> sensitivity;
+        std::vector<ggg::solvers::CriticalEdge> critical_edges;
+        if (!sensitivity_file.empty()) {
+            sensitivity.emplace(manager_, objective_, time_bound);
+            critical_edges = sensitivity->analyze();
+            std::ofstream out(sensitivity_file);
+            if (out) {
+                sensitivity->write_csv(out, critical_edges);
+            }
+            if (!out) {
+                log_error("Cannot write sensitivity file ", sensitivity_file);
+                return 1;
+            }
+            if (!csv_output && !time_only) {
+                log_info("Critical edges: ", critical_edges.size(), ", critical (edge, time) pairs: ",
+                         sensitivity->get_statistics().critical_edge_times, ", written to ", sensitivity_file);
+            }
+        }
+        
+        // Plays over the loaded game, using the solution's strategy for the solution policy
+        std::optional<ggg::solvers::PlaySimulator> simulator;
+        if (simulation.plays > 0) {
+            ggg::stats::ScopedPhase simulate_phase(run_stats_, "simulate");
+            simulator.emplace(manager_, objective_, time_bound);
+            simulator->set_solution(solution);
+            simulation.threads = threads;
+            if (query_vertex) {
+                simulation.start_vertex = boost::get(boost::vertex_index, *manager_->graph())[*query_vertex];
+            }
+            simulator->simulate(simulation);
+        }
+        ggg::memory::MemoryReport memory = memory_report(solve_stats);
         
         // Handle different output modes
-        if (csv_output) {
-            output_csv(solution, solver->get_statistics(), filename);
-        } else if (time_only) {
-            output_time_only(solver->get_statistics());
-        } else {
-            // Standard output mode
-            if (verbose) {
-                output_statistics(solver->get_statistics());
+        {
+            TEMPORIS_TRACE_SCOPE("output");
+            ggg::stats::ScopedPhase output_phase(run_stats_, "output");
+            if (csv_output) {
+                output_csv(solution, solve_stats, memory, filename);
+            } else if (time_only) {
+                output_time_only(solve_stats);
+            } else {
+                // Standard output mode
+                if (verbose) {
+                    output_statistics(solve_stats);
+                    if (components) {
+                        components->write_report(std::cout);
+                    }
+                    if (speculated) {
+                        speculation->write_report(std::cout, time_bound);
+                    }
+                    if (codegen) {
+                        codegen->write_report(std::cout, constraint_evaluations(*codegen, solve_stats));
+                    }
+                    if (lazy_constraints) {
+                        manager_->lazy_constraint_statistics().write_report(std::cout);
+                    }
+                    if (sensitivity) {
+                        sensitivity->write_report(std::cout, critical_edges);
+                    }
+                    memory.write_report(std::cout);
+                    if (perf_counters) {
+                        ggg::perf::PerfCounters::instance().write_report(std::cout);
+                    }
+                }
+                if (simulator) {
+                    simulator->write_report(std::cout);
+                }
+                output_solution(solution, verbose, query_vertex);
+            }
+        }
+        
+        if (!stats_json_file.empty() || !capture_file.empty()) {
+            if (components) {
+                run_stats_.add_component_statistics(components->get_statistics());
+            }
+            if (speculated) {
+                run_stats_.add_speculation_statistics(speculation->get_statistics(), time_bound);
+            }
+            if (codegen) {
+                run_stats_.add_codegen_report(codegen->get_report(), constraint_evaluations(*codegen, solve_stats));
+            }
+            if (lazy_constraints) {
+                run_stats_.add_lazy_constraint_statistics(manager_->lazy_constraint_statistics());
+            }
+            if (simulator) {
+                run_stats_.add_simulation_report(simulator->get_report());
+            }
+            if (sensitivity) {
+                run_stats_.add_sensitivity_statistics(sensitivity->get_statistics(), critical_edges.size());
+            }
+            std::string solver_name = components ? ggg::solvers::ComponentSolver::get_name(solver->get_name())
+                                                 : solver->get_name();
+            record_run_statistics(solver_name, solve_stats, solution, memory, time_bound);
+            if (!stats_json_file.empty() && !run_stats_.write_json(stats_json_file)) {
+                log_error("Cannot write statistics file ", stats_json_file);
+                return 1;
+            }
+            if (!capture_file.empty()) {
+                auto bundle = ggg::stats::WorkloadBundle::capture(capture_file);
+                bundle.source = using_stdin ? "stdin" : filename;
+                bundle.time_bound = time_bound;
+                bundle.arguments = std::move(run_arguments);
+                std::ostringstream statistics;
+                run_stats_.write_json(statistics);
+                bundle.statistics = statistics.str();
+                bundle.input = std::move(game_content);
+                if (!bundle.save(capture_file)) {
+                    log_error("Cannot write capture bundle ", capture_file);
+                    return 1;
+                }
+                log_debug("Captured run to ", capture_file);
             }
-            output_solution(solution, verbose);
         }
         
         return 0;
     }
     
 private:
+    void start_tracing(const std::string& trace_file) {
+#ifdef TEMPORIS_DISABLE_TRACING
+        log_error("Tracing was disabled at build time, ignoring --trace ", trace_file);
+#else
+        ggg::trace::Tracer::instance().start(trace_file);
+#endif
+    }
+    
+    /**
+     * @brief Solve every weakly connected component on its own, merging the statistics into totals
+     */
+    ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph> solve_components(
+        ggg::solvers::ComponentSolver& components, int time_bound, bool fast_path, bool activity_index,
+        size_t layer_dense_ratio, ggg::solvers::SolverStatistics& totals) {
+        std::mutex totals_mutex;
+        return components.solve([&](const ggg::solvers::SubGame& sub, std::string& engine) {
+            // Each component picks the fast path on its own when Player 1 has no choices there
+            ggg::solvers::GGGTemporalReachabilitySolver part(sub.manager, sub.objective, time_bound, false);
+            part.set_single_player_fast_path(fast_path);
+            part.set_activity_index(activity_index);
+            if (layer_dense_ratio > 0) {
+                part.set_layer_dense_ratio(layer_dense_ratio);
+            }
+            auto result = part.solve(*sub.manager->graph());
+            engine = part.get_statistics().single_player_fast_path ? "single_player" : "backwards";
+            std::lock_guard<std::mutex> lock(totals_mutex);
+            totals.accumulate(part.get_statistics());
+            return result;
+        });
+    }
+    
+    /**
+     * @brief Calibrate this host and write the profile to profile_file or the default path
+     */
+    int run_autotune(std::string profile_file, int max_threads) {
+        if (profile_file.empty()) {
+            profile_file = ggg::solvers::TuningProfile::default_path();
+        }
+        if (profile_file.empty()) {
+            log_error("No profile path: set HOME, XDG_CONFIG_HOME or TEMPORIS_PROFILE, or pass --profile");
+            return 1;
+        }
+        ggg::solvers::Autotuner tuner(max_threads > 0 ? max_threads : 0);
+        ggg::solvers::TuningProfile profile = tuner.tune(std::cout);
+        if (!profile.save(profile_file)) {
+            log_error("Cannot write profile ", profile_file);
+            return 1;
+        }
+        std::cout << "Profile written to " << profile_file << "\n";
+        return 0;
+    }
+    
+    /**
+     * @brief Load the tuning profile if there is one for this host; otherwise leave the defaults
+     */
+    void load_profile(std::string profile_file, ggg::solvers::TuningProfile& profile) const {
+        bool explicit_file = !profile_file.empty();
+        if (!explicit_file) {
+            profile_file = ggg::solvers::TuningProfile::default_path();
+            if (profile_file.empty() || !std::filesystem::exists(profile_file)) {
+                return;
+            }
+        }
+        std::string error;
+        auto loaded = ggg::solvers::TuningProfile::load(profile_file, error);
+        if (!loaded) {
+            if (explicit_file) {
+                log_error("Ignoring profile: ", error);
+            } else {
+                log_debug("Ignoring profile: ", error);
+            }
+            return;
+        }
+        std::string reason;
+        if (!loaded->matches_this_host(reason)) {
+            log_debug("Ignoring profile ", profile_file, ": ", reason);
+            return;
+        }
+        profile = *loaded;
+        log_debug("Profile ", profile_file, ": ", profile.summary());
+    }
+    
+    std::optional<ggg::graphs::GGGTemporalVertex> find_vertex(const std::string& name) const {
+        auto [vertex_begin, vertex_end] = boost::vertices(*manager_->graph());
+        for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+            if ((*manager_->graph())[*vertex_it].name == name) {
+                return *vertex_it;
+            }
+        }
+        return std::nullopt;
+    }
+    
+    /**
+     * @brief Constraint evaluations of the solve; the fast path only checks constrained edges
+     */
+    static double constraint_evaluations(const ggg::codegen::ConstraintCompiler& codegen,
+                                         const ggg::solvers::SolverStatistics& stats) {
+        return stats.single_player_fast_path
+            ? static_cast<double>(stats.edge_constraint_checks)
+            : codegen.get_report().estimated_evaluations(stats.edge_constraint_checks);
+    }
+    
+    void record_run_statistics(const std::string& solver_name, const ggg::solvers::SolverStatistics& stats,
+                               const ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph>& solution,
+                               const ggg::memory::MemoryReport& memory, int time_bound) {
+        const auto& graph = *manager_->graph();
+        run_stats_.set_solver(solver_name);
+        run_stats_.set_status("solved");
+        
+        run_stats_.add_solve_phase("backwards_attractor", stats.graph_traversal_time);
+        run_stats_.add_solve_phase("constraint_eval", stats.constraint_eval_time);
+        run_stats_.add_solve_phase("build_solution", stats.solution_time);
+        if (stats.activity_index) {
+            run_stats_.add_solve_phase("activity_index", stats.activity.build_time);
+        }
+        
+        size_t player0_winning = 0;
+        auto [vertex_begin, vertex_end] = boost::vertices(graph);
+        for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+            if (solution.is_won_by_player0(*vertex_it)) {
+                ++player0_winning;
+            }
+        }
+        run_stats_.set_size("vertices", boost::num_vertices(graph));
+        run_stats_.set_size("edges", boost::num_edges(graph));
+        run_stats_.set_size("targets", objective_->get_targets().size());
+        run_stats_.set_size("time_bound", time_bound);
+        run_stats_.set_size("player0_winning", player0_winning);
+        
+        run_stats_.set_counter("layers", stats.states_explored);
+        run_stats_.set_counter("constraint_evaluations", stats.constraint_evaluations);
+        run_stats_.set_counter("constraint_passes", stats.constraint_passes);
+        run_stats_.set_counter("constraint_failures", stats.constraint_failures);
+        run_stats_.set_counter("edge_constraint_checks", stats.edge_constraint_checks);
+        if (stats.single_player_fast_path) {
+            run_stats_.set_counter("single_player_windows", stats.single_player.constant_windows);
+            run_stats_.set_counter("single_player_matrix_power_windows", stats.single_player.matrix_power_windows);
+            run_stats_.set_counter("single_player_matrix_products", stats.single_player.matrix_products);
+            run_stats_.set_counter("single_player_frontier_steps", stats.single_player.frontier_steps);
+            run_stats_.set_counter("single_player_skipped_layers", stats.single_player.skipped_layers);
+        } else if (stats.sparse_layers + stats.dense_layers > 0) {
+            run_stats_.set_counter("sparse_layers", stats.sparse_layers);
+            run_stats_.set_counter("dense_layers", stats.dense_layers);
+            run_stats_.set_counter("layer_conversions", stats.layer_conversions);
+        }
+        if (stats.activity_index) {
+            run_stats_.set_counter("activity_windows", stats.activity.windows);
+            run_stats_.set_counter("activity_inexact_constraints", stats.activity.inexact_constraints);
+            run_stats_.set_counter("idle_vertex_layers", stats.idle_vertex_layers);
+        }
+        
+        run_stats_.set_memory(memory);
+    }
+    
     void print_usage() const {
         std::cout << "Temporis - GGG-Compatible Presburger Temporal Reachability Solver\n";
         std::cout << "==================================================================\n\n";
@@ -259,6 +859,34 @@ private:
         std::cout << "  --validate             Validate file format only\n";
         std::cout << "  --csv                  Output results in CSV format\n";
         std::cout << "  --time-only            Output only timing information\n";
+        std::cout << "  --trace FILE           Write a Chrome trace (Perfetto JSON) of the run to FILE\n";
+        std::cout << "  --perf-counters        Sample hardware counters per solve phase (Linux perf_event_open)\n";
+        std::cout << "  --stats-json FILE      Write load, solve and output statistics as JSON to FILE\n";
+        std::cout << "  --capture FILE         Save input bytes, options and statistics as a bundle for temporis_replay\n";
+        std::cout << "  --layer-series FILE    Write per-layer attractor size and cost (CSV, binary if FILE ends in .bin)\n";
+        std::cout << "  --layer-sample N       Aggregate the layer series over blocks of N time steps (default: 1)\n";
+        std::cout << "  --sensitivity FILE     Write the edges whose removal at some times changes the time-0 region (CSV)\n";
+        std::cout << "  --simulate N           Simulate N plays over the game and report win rate, lengths and plays/s\n";
+        std::cout << "  --simulate-player0 P   Player 0 policy: strategy (default), solution or random\n";
+        std::cout << "  --simulate-player1 P   Player 1 policy: random (default) or adversarial\n";
+        std::cout << "  --simulate-from S      Start plays in the winning region (winning, default) or anywhere (all)\n";
+        std::cout << "  --simulate-seed N      Seed of the simulated plays (default: 1)\n";
+        std::cout << "  --no-fast-path         Always run the layered sweep, even without Player 1 choices\n";
+        std::cout << "  --no-activity-index    Visit every vertex in every layer, also outside its edges' windows\n";
+        std::cout << "  --decompose            Solve weakly connected components independently in parallel\n";
+        std::cout << "  --threads N            Worker threads for --decompose, --simulate and --speculate, and the largest\n";
+        std::cout << "                         count --autotune tries (default: profile, else all hardware threads)\n";
+        std::cout << "  --autotune             Calibrate this host on generated games and write its tuning profile\n";
+        std::cout << "  --profile FILE         Tuning profile to write or load (default: ~/.config/temporis/<host>.profile)\n";
+        std::cout << "  --no-profile           Ignore the tuning profile and use the built-in defaults\n";
+        std::cout << "  --speculate P          Solve time chunks in parallel from predicted layers: periodic or warmup\n";
+        std::cout << "  --speculate-chunks N   Chunks of the horizon for --speculate (default: twice the threads)\n";
+        std::cout << "  --speculate-warmup N   Warm-up layers per chunk with --speculate warmup (default: 32)\n";
+        std::cout << "  --speculate-table FILE Predict from and update the exact chunk boundaries of previous solves\n";
+        std::cout << "  --lazy-constraints     Keep constraint text at load and parse each constraint on first use\n";
+        std::cout << "  --query NAME           Solve only the part of the game reachable from vertex NAME\n";
+        std::cout << "  --compile-constraints  Compile the constraints to native code (cached shared object)\n";
+        std::cout << "  --codegen-cache DIR    Cache directory for --compile-constraints (default: ~/.cache/temporis)\n";
         std::cout << "  -h, --help             Show this help\n\n";
         std::cout << "EXAMPLES:\n";
         std::cout << "  temporis game.dot                 # Solve reachability game\n";
@@ -267,7 +895,8 @@ private:
         std::cout << "  cat game.dot | temporis --time-only # Read from stdin\n";
     }
     
-    void output_solution(const ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph>& solution, bool verbose) {
+    void output_solution(const ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph>& solution, bool verbose,
+                         std::optional<ggg::graphs::GGGTemporalVertex> only = std::nullopt) {
         std::cout << "\n=== Solution ===\n";
         std::cout << "Status: Solved" << std::endl;
         std::cout << "Valid: Yes" << std::endl;
@@ -278,6 +907,9 @@ private:
         auto [vertex_begin, vertex_end] = boost::vertices(*manager_->graph());
             for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
                 auto vertex = *vertex_it;
+                if (only && vertex != *only) {
+                    continue;
+                }
                 const auto& props = (*manager_->graph())[vertex];
                 
                 std::cout << "  " << props.name << ": ";
@@ -305,6 +937,31 @@ private:
         std::cout << "  States pruned: " << stats.states_pruned << "\n";
         std::cout << "  Max time reached: " << stats.max_time_reached << "\n";
         
+        if (stats.single_player_fast_path) {
+            std::cout << "\nSingle-player fast path:\n";
+            std::cout << "  Constant windows: " << stats.single_player.constant_windows << "\n";
+            std::cout << "  Windows by repeated squaring: " << stats.single_player.matrix_power_windows << "\n";
+            std::cout << "  Matrix products: " << stats.single_player.matrix_products << "\n";
+            std::cout << "  Frontier steps: " << stats.single_player.frontier_steps << "\n";
+            std::cout << "  Layers skipped: " << stats.single_player.skipped_layers << "\n";
+        } else if (stats.sparse_layers + stats.dense_layers > 0) {
+            std::cout << "\nLayer representation:\n";
+            std::cout << "  Sparse layers: " << stats.sparse_layers << "\n";
+            std::cout << "  Dense layers: " << stats.dense_layers << "\n";
+            std::cout << "  Sparse/dense switches: " << stats.layer_conversions << "\n";
+        }
+        
+        if (stats.activity_index) {
+            std::cout << "\nVertex activity index:\n";
+            std::cout << "  Windows: " << stats.activity.windows << " (" << stats.activity.inexact_constraints
+                      << " constraints over-approximated)\n";
+            std::cout << "  Active vertex layers: " << std::fixed << std::setprecision(2)
+                      << stats.activity.coverage() * 100.0 << "%\n";
+            std::cout << "  Idle vertex layers skipped: " << stats.idle_vertex_layers << "\n";
+            std::cout << "  Build time: " << std::fixed << std::setprecision(4) << stats.activity.build_time.count()
+                      << "s\n";
+        }
+        
         std::cout << "\nConstraint evaluation:\n";
         std::cout << "  Total evaluations: " << stats.constraint_evaluations << "\n";
         std::cout << "  Successful: " << stats.constraint_passes << "\n";
@@ -328,8 +985,18 @@ private:
         std::cout << std::endl;
     }
 
+    ggg::memory::MemoryReport memory_report(const ggg::solvers::SolverStatistics& stats) const {
+        ggg::memory::MemoryReport report;
+        report.add("graph", manager_->graph_memory_bytes());
+        report.add("constraints", manager_->constraint_memory_bytes());
+        report.add("solver_layers", stats.peak_layer_bytes);
+        report.add("solution", stats.solution_bytes);
+        return report;
+    }
+
     void output_csv(const ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph>& solution, 
                     const ggg::solvers::SolverStatistics& stats, 
+                    const ggg::memory::MemoryReport& memory,
                     const std::string& filename) {
         // Extract filename without path and extension for solver identification
         std::string base_filename = filename;
@@ -344,13 +1011,20 @@ private:
 
         // Output CSV format compatible with GGG benchmark tools
         // Format: solver,game,status,solve_time,constraint_eval_time,graph_traversal_time,vertices_explored
+        // followed by graph_bytes,constraint_bytes,layer_bytes,solution_bytes,peak_rss_bytes
+        // and cycles,instructions,l1d_misses,llc_misses,branch_misses with --perf-counters
         std::cout << "Backwards Temporal Attractor Solver,"
                   << base_filename << ","
                   << "solved" << ","
                   << std::fixed << std::setprecision(6) << stats.total_solve_time.count() << ","
                   << std::fixed << std::setprecision(6) << stats.constraint_eval_time.count() << ","
                   << std::fixed << std::setprecision(6) << stats.graph_traversal_time.count() << ","
-                  << stats.states_explored << std::endl;
+                  << stats.states_explored
+                  << memory.csv_fields();
+        if (ggg::perf::PerfCounters::instance().enabled()) {
+            std::cout << ggg::perf::PerfCounters::instance().csv_fields("solve");
+        }
+        std::cout << std::endl;
     }
 
     void output_time_only(const ggg::solvers::SolverStatistics& stats) {
@@ -362,5 +1036,15 @@ private:
 
 int main(int argc, char* argv[]) {
     TemporalReachabilityExecutor executor;
-    return executor.run(argc, argv);
+    int result = 1;
+    try {
+        result = executor.run(argc, argv);
+    } catch (const std::exception& e) {
+        // Invalid constraints surface here: at load, or at first use with --lazy-constraints
+        log_error(e.what());
+    }
+    if (!ggg::trace::Tracer::instance().write()) {
+        return 1;
+    }
+    return result;
 }
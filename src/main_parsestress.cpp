@@ -0,0 +1,463 @@
+#include "ggg_temporal_graph.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parser stress harness: pathological inputs must load in time linear in their size
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    template<typename... Args>
+    void log_error(Args... args) {
+        std::cerr << "[ERROR] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+
+    enum class Parser { DOT, CONSTRAINT };
+
+    /**
+     * @brief Family of pathological inputs; generate(n) returns about n bytes
+     */
+    struct StressFamily {
+        const char* name;
+        Parser parser;
+        const char* description;
+        std::function<std::string(size_t)> generate;
+    };
+
+    std::string repeat(const std::string& unit, size_t bytes) {
+        std::string text;
+        text.reserve(bytes + unit.size());
+        while (text.size() < bytes) {
+            text += unit;
+        }
+        return text;
+    }
+
+    std::string dot_game(const std::string& body) {
+        return "digraph G {\n    // time_bound: 10\n" + body + "}\n";
+    }
+
+    const std::vector<StressFamily>& all_families() {
+        static const std::vector<StressFamily> families = {
+            {"and_chain", Parser::CONSTRAINT, "time >= 1 && time >= 1 && ...",
+             [](size_t n) { return repeat("time >= 1 && ", n) + "time <= 9"; }},
+            {"mixed_chain", Parser::CONSTRAINT, "time % 3 == 1 && time > 2 || ...",
+             [](size_t n) { return repeat("time % 3 == 1 && time > 2 || ", n) + "time < 7"; }},
+            {"deep_parens", Parser::CONSTRAINT, "((((time >= 3))))",
+             [](size_t n) { return std::string(n / 2, '(') + "time >= 3" + std::string(n / 2, ')'); }},
+            {"deep_negation", Parser::CONSTRAINT, "!(!(!(time >= 3)))",
+             [](size_t n) {
+                 std::string open = repeat("!(", n / 2);
+                 return open + "time >= 3" + std::string(open.size() / 2, ')');
+             }},
+            {"alternating_nesting", Parser::CONSTRAINT, "time >= 0 && (time <= 9 || (time >= 0 && (...)))",
+             [](size_t n) {
+                 std::string open = repeat("time>=0&&(time<=9||(", n);
+                 size_t depth = open.size() / 20 * 2;
+                 return open + "time==3" + std::string(depth, ')');
+             }},
+            {"exists_prefix", Parser::CONSTRAINT, "exists k: exists k: ... time >= k",
+             [](size_t n) { return repeat("exists k: ", n) + "time >= k"; }},
+            {"giant_identifier", Parser::CONSTRAINT, "xxxx...x >= 3 && time <= 5",
+             [](size_t n) { return std::string(n, 'x') + " >= 3 && time <= 5"; }},
+            {"whitespace", Parser::CONSTRAINT, "time <n spaces> >= 3",
+             [](size_t n) { return "time" + std::string(n, ' ') + ">= 3"; }},
+            {"regular_game", Parser::DOT, "vertex and constraint edge lines of an ordinary game",
+             [](size_t n) {
+                 std::ostringstream body;
+                 size_t vertices = std::max<size_t>(2, n / 100);
+                 for (size_t v = 0; v < vertices; ++v) {
+                     body << "    v" << v << " [name=\"v" << v << "\", player=" << v % 2 << (v % 7 == 0 ? ", target=1" : "")
+                          << "];\n";
+                 }
+                 for (size_t v = 0; v < vertices; ++v) {
+                     body << "    v" << v << " -> v" << (v * 7 + 1) % vertices << " [constraint=\"time % 3 == "
+                          << v % 3 << "\"];\n";
+                 }
+                 return dot_game(body.str());
+             }},
+            {"long_name", Parser::DOT, "one vertex line with an n-byte name",
+             [](size_t n) {
+                 return dot_game("    v0 [name=\"" + std::string(n, 'a') + "\", player=0, target=1];\n    v0 -> v0;\n");
+             }},
+            {"long_label", Parser::DOT, "one edge line with an n-byte label",
+             [](size_t n) {
+                 return dot_game("    v0 [name=\"v0\", player=0, target=1];\n    v0 -> v0 [label=\"" +
+                                 std::string(n, 'l') + "\"];\n");
+             }},
+            {"giant_identifiers", Parser::DOT, "vertex ids of 4 KiB each",
+             [](size_t n) {
+                 std::string body;
+                 size_t vertices = std::max<size_t>(2, n / 8192);
+                 for (size_t v = 0; v < vertices; ++v) {
+                     std::string id = std::string(4096, 'v') + std::to_string(v);
+                     body += "    " + id + " [name=\"" + id.substr(4090) + "\", player=0, target=1];\n";
+                     if (v > 0) {
+                         body += "    " + id + " -> " + std::string(4096, 'v') + std::to_string(v - 1) + ";\n";
+                     }
+                 }
+                 return dot_game(body);
+             }},
+            {"constraint_line", Parser::DOT, "one edge whose constraint is an n-byte && chain",
+             [](size_t n) {
+                 return dot_game("    v0 [name=\"v0\", player=0, target=1];\n    v0 -> v0 [constraint=\"" +
+                                 repeat("time >= 1 && ", n) + "time <= 9\"];\n");
+             }},
+            {"arrow_soup", Parser::DOT, "a -> a -> a -> ... (a match attempt at every word)",
+             [](size_t n) { return dot_game("    v0 [name=\"v0\", player=0];\n    " + repeat("a -> ", n) + "\n"); }},
+            {"quote_soup", Parser::DOT, "v [name=\"v [name=\"v ... (unterminated attributes)",
+             [](size_t n) { return dot_game("    " + repeat("v [name=\"v , player=0 ", n) + "\n"); }},
+        };
+        return families;
+    }
+
+    // Mutation seeds for the fuzzer
+    const std::vector<std::string> kDotSeeds = {
+        "    v0 [name=\"v0\", player=0, target=1];",
+        "    v1 [name=\"v1\", player=1, target=0, target_constraint=\"time % 2 == 0\"];",
+        "    v2 [name=\"v2\", player=1];",
+        "    v0 -> v1;",
+        "    v1 -> v2 [label=\"x\"];",
+        "    v2 -> v0 [constraint=\"time >= 3 && (time <= 8 || !(time == 5))\"];",
+        "    v1 -> v0 [constraint=\"exists k: 2*k == time\"];",
+        "    // time_bound: 10",
+    };
+
+    const std::vector<std::string> kConstraintSeeds = {
+        "time >= 3", "time % 4 == 1", "time mod 5 == 2", "!(time == 4)", "(time < 2 || time > 7) && time != 5",
+        "exists k: 2*k == time", "true", "false", "2*time <= 9",
+    };
+
+    std::string mutate(std::string text, std::mt19937_64& rng, size_t max_bytes) {
+        static const std::string alphabet = "()!&|<>=%:. \"[],;-_*vtimekxod0123456789";
+        size_t mutations = std::uniform_int_distribution<size_t>(1, 4)(rng);
+        for (size_t i = 0; i < mutations; ++i) {
+            size_t pos = std::uniform_int_distribution<size_t>(0, text.size())(rng);
+            switch (rng() % 4) {
+                case 0:
+                    text.insert(pos, 1, alphabet[rng() % alphabet.size()]);
+                    break;
+                case 1:
+                    if (pos < text.size()) {
+                        text.erase(pos, 1);
+                    }
+                    break;
+                case 2: {
+                    // Duplicate a slice many times: long chains, deep nesting, long lines
+                    size_t length = std::uniform_int_distribution<size_t>(1, 16)(rng);
+                    std::string slice = text.substr(pos, length);
+                    size_t copies = std::uniform_int_distribution<size_t>(1, 4096)(rng);
+                    std::string amplified;
+                    for (size_t copy = 0; copy < copies && text.size() + amplified.size() < max_bytes; ++copy) {
+                        amplified += slice;
+                    }
+                    text.insert(pos, amplified);
+                    break;
+                }
+                default:
+                    if (text.size() * 2 <= max_bytes) {
+                        text += text;
+                    }
+                    break;
+            }
+        }
+        return text;
+    }
+}
+
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
+/**
+ * @brief Loads generated pathological inputs at doubling sizes and checks that parse time grows linearly
+ */
+class ParserStressTest {
+private:
+    size_t min_bytes_ = 32 * 1024;
+    size_t max_bytes_ = 2 * 1024 * 1024;
+    int repeat_ = 3;
+    double max_exponent_ = 1.5;
+    int fuzz_inputs_ = 2000;
+    double fuzz_budget_ns_ = 2000.0;   // per byte, on top of kFuzzFixedBudget
+    uint64_t seed_ = 1;
+    std::vector<std::string> families_;
+    bool verbose_ = false;
+
+    // Shortest timed sample, so that the fit does not see timer resolution
+    static constexpr double kMinSampleSeconds = 0.002;
+    static constexpr double kFuzzFixedBudgetSeconds = 0.005;
+
+    ggg::graphs::GGGTemporalGameManager manager_;
+
+    void parse(Parser parser, const std::string& input) {
+        if (parser == Parser::DOT) {
+            manager_.load_from_dot_string(input);
+        } else {
+            manager_.parse_constraint(input);
+        }
+    }
+
+    // Fastest of repeat_ samples; fast inputs are parsed several times per sample
+    double parse_seconds(Parser parser, const std::string& input) {
+        auto start = Clock::now();
+        parse(parser, input);
+        double single = std::chrono::duration<double>(Clock::now() - start).count();
+        int iterations = single >= kMinSampleSeconds ? 1 : static_cast<int>(std::ceil(kMinSampleSeconds / std::max(single, 1e-7)));
+
+        double best = single;
+        for (int run = 0; run < repeat_; ++run) {
+            start = Clock::now();
+            for (int iteration = 0; iteration < iterations; ++iteration) {
+                parse(parser, input);
+            }
+            best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count() / iterations);
+        }
+        return best;
+    }
+
+    // Least-squares slope of log(time) over log(bytes): 1 for linear, 2 for quadratic parsing
+    static double fit_exponent(const std::vector<std::pair<size_t, double>>& points) {
+        double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (const auto& [bytes, seconds] : points) {
+            double x = std::log(static_cast<double>(bytes));
+            double y = std::log(seconds);
+            n += 1;
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+        return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    }
+
+    bool check_family(const StressFamily& family) {
+        std::vector<std::pair<size_t, double>> points;
+        size_t largest = 0;
+        double largest_seconds = 0.0;
+        for (size_t size = min_bytes_; size <= max_bytes_; size *= 2) {
+            std::string input = family.generate(size);
+            double seconds = 0.0;
+            try {
+                seconds = parse_seconds(family.parser, input);
+            } catch (const std::exception& e) {
+                log_error(family.name, ": parse failed at ", input.size(), " bytes: ", e.what());
+                return false;
+            }
+            if (verbose_) {
+                std::cout << "  " << std::left << std::setw(20) << family.name << std::right << std::setw(10)
+                          << input.size() << " bytes " << std::fixed << std::setprecision(6) << seconds << "s\n";
+            }
+            points.emplace_back(input.size(), seconds);
+            largest = input.size();
+            largest_seconds = seconds;
+        }
+
+        bool measured = points.size() >= 2;
+        double exponent = measured ? fit_exponent(points) : 0.0;
+        bool passed = !measured || exponent <= max_exponent_;
+        std::cout << std::left << std::setw(20) << family.name << std::setw(12)
+                  << (family.parser == Parser::DOT ? "dot" : "constraint") << std::right << std::setw(10) << largest
+                  << std::fixed << std::setprecision(6) << std::setw(12) << largest_seconds << std::setprecision(1)
+                  << std::setw(10) << (largest_seconds > 0.0 ? largest / largest_seconds / 1e6 : 0.0);
+        if (measured) {
+            std::cout << std::setprecision(2) << std::setw(10) << exponent;
+        } else {
+            std::cout << std::setw(10) << "n/a";
+        }
+        std::cout << "  " << (passed ? "ok" : "FAIL") << "\n";
+        return passed;
+    }
+
+    bool run_fuzz() {
+        std::mt19937_64 rng(seed_);
+        size_t fuzz_bytes = std::min<size_t>(max_bytes_, 256 * 1024);
+        size_t rejected = 0;
+        size_t over_budget = 0;
+        size_t total_bytes = 0;
+        double worst_ns_per_byte = 0.0;
+        auto fuzz_start = Clock::now();
+
+        for (int index = 0; index < fuzz_inputs_; ++index) {
+            bool dot = index % 2 == 0;
+            std::string input;
+            if (dot) {
+                std::string body;
+                for (int line = 0; line < 6; ++line) {
+                    body += mutate(kDotSeeds[rng() % kDotSeeds.size()], rng, fuzz_bytes / 6) + "\n";
+                }
+                input = dot_game(body);
+            } else {
+                input = mutate(kConstraintSeeds[rng() % kConstraintSeeds.size()], rng, fuzz_bytes);
+            }
+
+            auto start = Clock::now();
+            try {
+                parse(dot ? Parser::DOT : Parser::CONSTRAINT, input);
+            } catch (const std::exception&) {
+                rejected++;   // e.g. an out-of-range number
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            total_bytes += input.size();
+            worst_ns_per_byte = std::max(worst_ns_per_byte, seconds * 1e9 / static_cast<double>(input.size()));
+            if (seconds > kFuzzFixedBudgetSeconds + fuzz_budget_ns_ * 1e-9 * static_cast<double>(input.size())) {
+                over_budget++;
+                log_error("Fuzz input ", index, " (", dot ? "dot" : "constraint", ", ", input.size(),
+                          " bytes) took ", seconds, "s");
+            }
+        }
+
+        double seconds = std::chrono::duration<double>(Clock::now() - fuzz_start).count();
+        std::cout << "\nFuzz: " << fuzz_inputs_ << " mutated inputs (" << total_bytes << " bytes, seed " << seed_
+                  << ") in " << std::fixed << std::setprecision(3) << seconds << "s, " << rejected
+                  << " rejected with an exception, " << over_budget << " over budget, worst "
+                  << std::setprecision(1) << worst_ns_per_byte << " ns/byte\n";
+        return over_budget == 0;
+    }
+
+public:
+    ParseResult parse_arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            std::string value;
+            auto next_value = [&]() {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+
+            try {
+                if (arg == "--help" || arg == "-h") {
+                    print_usage();
+                    return ParseResult::HELP;
+                } else if (arg == "--verbose" || arg == "-v") {
+                    verbose_ = true;
+                } else if (arg == "--min-bytes") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    min_bytes_ = std::max<size_t>(64, std::stoul(value));
+                } else if (arg == "--max-bytes") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    max_bytes_ = std::stoul(value);
+                } else if (arg == "--repeat" || arg == "-r") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    repeat_ = std::max(1, std::stoi(value));
+                } else if (arg == "--max-exponent") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    max_exponent_ = std::stod(value);
+                } else if (arg == "--fuzz") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    fuzz_inputs_ = std::max(0, std::stoi(value));
+                } else if (arg == "--fuzz-budget") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    fuzz_budget_ns_ = std::stod(value);
+                } else if (arg == "--seed" || arg == "-s") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    seed_ = std::stoull(value);
+                } else if (arg == "--families") {
+                    if (!next_value()) return ParseResult::INVALID;
+                    std::stringstream list(value);
+                    std::string name;
+                    while (std::getline(list, name, ',')) {
+                        families_.push_back(name);
+                    }
+                } else {
+                    log_error("Unknown option: ", arg);
+                    return ParseResult::INVALID;
+                }
+            } catch (const std::exception&) {
+                log_error("Invalid value for ", arg, ": ", value);
+                return ParseResult::INVALID;
+            }
+        }
+        if (min_bytes_ > max_bytes_) {
+            log_error("--min-bytes must not exceed --max-bytes");
+            return ParseResult::INVALID;
+        }
+        for (const auto& name : families_) {
+            const auto& families = all_families();
+            if (std::none_of(families.begin(), families.end(), [&](const auto& f) { return name == f.name; })) {
+                log_error("Unknown family: ", name);
+                return ParseResult::INVALID;
+            }
+        }
+        return ParseResult::RUN;
+    }
+
+    /**
+     * @brief Run the selected families and the fuzzer
+     * @return true if every family stays under the exponent bound and no fuzz input exceeds its budget
+     */
+    bool run() {
+        std::cout << std::left << std::setw(20) << "family" << std::setw(12) << "parser" << std::right
+                  << std::setw(10) << "bytes" << std::setw(12) << "seconds" << std::setw(10) << "MB/s"
+                  << std::setw(10) << "exponent" << "\n";
+        int failures = 0;
+        for (const auto& family : all_families()) {
+            if (!families_.empty() && std::find(families_.begin(), families_.end(), family.name) == families_.end()) {
+                continue;
+            }
+            if (!check_family(family)) {
+                failures++;
+            }
+        }
+        if (fuzz_inputs_ > 0 && !run_fuzz()) {
+            failures++;
+        }
+        std::cout << "\n" << (failures == 0 ? "PASS" : "FAIL") << ": parse time exponent bound "
+                  << std::setprecision(2) << max_exponent_ << ", " << failures << " failure(s)\n";
+        return failures == 0;
+    }
+
+    void print_usage() const {
+        std::cout << "Temporis Parser Stress Test\n\n";
+        std::cout << "USAGE:\n";
+        std::cout << "  temporis_parsestress [OPTIONS]\n\n";
+        std::cout << "Loads pathological DOT files and constraints (long lines, long operator chains,\n";
+        std::cout << "deep nesting, giant identifiers) at doubling sizes and fails if parse time grows\n";
+        std::cout << "faster than bytes^max-exponent. Mutated inputs are then fuzzed against a per-byte\n";
+        std::cout << "time budget.\n\n";
+        std::cout << "OPTIONS:\n";
+        std::cout << "  --min-bytes N          Smallest input size (default: 32768)\n";
+        std::cout << "  --max-bytes N          Largest input size (default: 2097152)\n";
+        std::cout << "  -r, --repeat N         Parses per size; the fastest counts (default: 3)\n";
+        std::cout << "  --max-exponent X       Largest accepted growth exponent (default: 1.5)\n";
+        std::cout << "  --families LIST        Comma-separated families to run (default: all)\n";
+        std::cout << "  --fuzz N               Mutated inputs to fuzz, 0 to skip (default: 2000)\n";
+        std::cout << "  --fuzz-budget NS       Time budget per fuzzed byte in ns, plus 5 ms (default: 2000)\n";
+        std::cout << "  -s, --seed N           Fuzzer seed (default: 1)\n";
+        std::cout << "  -v, --verbose          Print every measured size\n";
+        std::cout << "  -h, --help             Show this help\n\n";
+        std::cout << "FAMILIES:\n";
+        for (const auto& family : all_families()) {
+            std::cout << "  " << std::left << std::setw(21) << family.name << std::setw(11)
+                      << (family.parser == Parser::DOT ? "dot" : "constraint") << family.description << "\n";
+        }
+    }
+};
+
+int main(int argc, char* argv[]) {
+    ParserStressTest test;
+
+    ParseResult parsed = test.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 1;
+    }
+
+    try {
+        return test.run() ? 0 : 1;
+    } catch (const std::exception& e) {
+        log_error(e.what());
+        return 1;
+    }
+}
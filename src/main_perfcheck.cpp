@@ -0,0 +1,455 @@
+#include "game_generator.hpp"
+#include "ggg_temporal_graph.hpp"
+#include "ggg_temporal_solver.hpp"
+#include "static_expansion_solver.hpp"
+#include "workload_bundle.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef TEMPORIS_PERF_BASELINE
+#define TEMPORIS_PERF_BASELINE "perf/baseline.json"
+#endif
+
+// Performance regression gate: fixed corpus, both solvers, medians vs a stored baseline
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    template<typename... Args>
+    void log_error(Args... args) {
+        std::cerr << "[ERROR] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+
+    /**
+     * @brief One game of the fixed corpus; parameters are passed to the game generator
+     */
+    struct CorpusGame {
+        const char* name;
+        uint64_t vertices;
+        uint64_t degree;
+        int time_bound;
+        const char* mix;
+        double unconstrained_weight;
+        int nesting_depth;
+        double player1_ratio;
+        double target_density;
+        unsigned seed;
+    };
+
+    // Chosen so that both players win somewhere; changing this list invalidates the baseline
+    const std::vector<CorpusGame> kCorpus = {
+        {"small_mixed", 200, 4, 20, "mixed", 0.0, 1, 0.5, 0.3, 3},
+        {"medium_mixed", 1000, 4, 30, "mixed", 0.0, 1, 0.2, 0.3, 3},
+        {"wide_threshold", 2000, 4, 50, "threshold", 0.0, 1, 0.3, 0.2, 4},
+        {"long_modulus", 300, 4, 500, "modulus", 2.0, 1, 0.2, 0.3, 4},
+        {"nested_mixed", 400, 4, 30, "mixed", 0.0, 3, 0.2, 0.3, 4},
+    };
+
+    enum class MetricKind {
+        TIME,   // seconds, lower is better
+        WORK,   // counter, lower is better
+        RESULT  // must match the baseline exactly
+    };
+
+    struct Metric {
+        std::string key;  // game/solver/metric
+        MetricKind kind;
+        double value;
+    };
+
+    const std::map<std::string, double> kDefaultTolerances = {
+        {"load_time", 0.50},
+        {"solve_time", 0.50},
+        {"constraint_checks", 0.0},
+        {"expanded_edges", 0.0},
+        {"player0_winning", 0.0},
+    };
+
+    // Absolute slack added to time limits so sub-millisecond jitter is not a regression
+    constexpr double kDefaultTimeFloorSeconds = 0.0005;
+
+    std::string metric_name(const std::string& key) {
+        return key.substr(key.find_last_of('/') + 1);
+    }
+
+    double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+}
+
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
+/**
+ * @brief Runs the corpus, compares against the baseline and reports regressions
+ */
+class PerformanceCheck {
+private:
+    std::string baseline_file_ = TEMPORIS_PERF_BASELINE;
+    int repeats_ = 5;
+    std::string filter_;
+    bool update_baseline_ = false;
+    bool quiet_ = false;
+    std::vector<std::string> bundles_;
+    std::vector<Metric> metrics_;
+
+public:
+    bool update_baseline() const { return update_baseline_; }
+
+    ParseResult parse_arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next_value = [&](std::string& value) {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+
+            std::string value;
+            try {
+                if (arg == "--help" || arg == "-h") {
+                    print_usage();
+                    return ParseResult::HELP;
+                } else if (arg == "--baseline") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    baseline_file_ = value;
+                } else if (arg == "--repeat") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    repeats_ = std::max(1, std::stoi(value));
+                } else if (arg == "--filter") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    filter_ = value;
+                } else if (arg == "--update-baseline") {
+                    update_baseline_ = true;
+                } else if (arg == "--corpus") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    bundles_.push_back(value);
+                } else if (arg == "--quiet" || arg == "-q") {
+                    quiet_ = true;
+                } else {
+                    log_error("Unknown option: ", arg);
+                    return ParseResult::INVALID;
+                }
+            } catch (const std::exception&) {
+                log_error("Invalid value for ", arg, ": ", value);
+                return ParseResult::INVALID;
+            }
+        }
+        if (update_baseline_ && !filter_.empty()) {
+            log_error("--update-baseline measures the whole corpus and cannot be combined with --filter");
+            return ParseResult::INVALID;
+        }
+        return ParseResult::RUN;
+    }
+
+    bool run() {
+        // Captured workloads extend the corpus as bundle:<name>; all are loaded before anything runs
+        std::vector<ggg::stats::WorkloadBundle> bundles;
+        auto files = ggg::stats::WorkloadBundle::collect(bundles_);
+        if (!bundles_.empty() && files.empty()) {
+            log_error("No bundles found");
+            return false;
+        }
+        for (const auto& file : files) {
+            std::string error;
+            auto bundle = ggg::stats::WorkloadBundle::load(file, error);
+            if (!bundle) {
+                log_error(error);
+                return false;
+            }
+            bundles.push_back(std::move(*bundle));
+        }
+
+        for (const auto& game : kCorpus) {
+            if (!filter_.empty() && std::string(game.name).find(filter_) == std::string::npos) {
+                continue;
+            }
+            if (!quiet_) {
+                std::cerr << "Running " << game.name << " (" << repeats_ << " repeats)" << std::endl;
+            }
+            run_game(game.name, generate(game), game.time_bound);
+        }
+        for (const auto& bundle : bundles) {
+            std::string name = "bundle:" + bundle.name;
+            if (!filter_.empty() && name.find(filter_) == std::string::npos) {
+                continue;
+            }
+            if (!quiet_) {
+                std::cerr << "Running " << name << " (" << repeats_ << " repeats)" << std::endl;
+            }
+            run_game(name, bundle.input, bundle.time_bound);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Compare the measured metrics with the baseline
+     * @return 0 if nothing regressed, 1 on regressions, 2 if the baseline cannot be read
+     */
+    int compare() const {
+        std::ifstream file(baseline_file_);
+        if (!file.is_open()) {
+            log_error("Cannot open baseline ", baseline_file_, " (create it with --update-baseline)");
+            return 2;
+        }
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::map<std::string, double> baseline;
+        try {
+            baseline = ggg::stats::flatten_json_numbers(text);
+        } catch (const std::exception& e) {
+            log_error("Invalid baseline ", baseline_file_, ": ", e.what());
+            return 2;
+        }
+
+        auto tolerance = [&](const std::string& name) {
+            auto it = baseline.find("tolerances/" + name);
+            if (it != baseline.end()) return it->second;
+            auto fallback = kDefaultTolerances.find(name);
+            return fallback != kDefaultTolerances.end() ? fallback->second : 0.0;
+        };
+        auto floor_it = baseline.find("tolerances/time_floor_seconds");
+        double time_floor = floor_it != baseline.end() ? floor_it->second : kDefaultTimeFloorSeconds;
+
+        std::cout << std::left << std::setw(44) << "metric" << std::right << std::setw(14) << "baseline"
+                  << std::setw(14) << "current" << std::setw(10) << "change" << std::setw(10) << "allowed"
+                  << "  status\n";
+
+        size_t regressions = 0;
+        for (const auto& metric : metrics_) {
+            std::string name = metric_name(metric.key);
+            auto it = baseline.find("metrics/" + metric.key);
+            std::string status;
+            double allowed = tolerance(name);
+            double change = 0.0;
+
+            if (it == baseline.end()) {
+                status = "new";
+            } else {
+                double base = it->second;
+                change = base != 0.0 ? (metric.value - base) / base : (metric.value != 0.0 ? 1.0 : 0.0);
+                bool regressed;
+                if (metric.kind == MetricKind::RESULT) {
+                    regressed = metric.value != base;
+                } else {
+                    double slack = metric.kind == MetricKind::TIME ? time_floor : 0.0;
+                    regressed = metric.value > base * (1.0 + allowed) + slack;
+                }
+                status = regressed ? (metric.kind == MetricKind::RESULT ? "CHANGED" : "REGRESSION") : "ok";
+                if (regressed) {
+                    ++regressions;
+                }
+            }
+
+            if (quiet_ && status == "ok") {
+                continue;
+            }
+            std::cout << std::left << std::setw(44) << metric.key << std::right
+                      << std::setw(14) << (it != baseline.end() ? format_value(metric.kind, it->second) : "-")
+                      << std::setw(14) << format_value(metric.kind, metric.value)
+                      << std::setw(10) << format_percent(change)
+                      << std::setw(10) << (metric.kind == MetricKind::RESULT ? "exact" : format_percent(allowed))
+                      << "  " << status << "\n";
+        }
+
+        std::cout << "\n" << regressions << " regression(s) in " << metrics_.size() << " metrics against "
+                  << baseline_file_ << "\n";
+        return regressions == 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Write the measured metrics as the new baseline, keeping its tolerances
+     */
+    bool write_baseline() const {
+        std::map<std::string, double> tolerances(kDefaultTolerances.begin(), kDefaultTolerances.end());
+        double time_floor = kDefaultTimeFloorSeconds;
+
+        std::ifstream existing(baseline_file_);
+        if (existing.is_open()) {
+            std::string text((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+            try {
+                for (const auto& [key, value] : ggg::stats::flatten_json_numbers(text)) {
+                    if (key == "tolerances/time_floor_seconds") {
+                        time_floor = value;
+                    } else if (key.rfind("tolerances/", 0) == 0) {
+                        tolerances[key.substr(11)] = value;
+                    }
+                }
+            } catch (const std::exception&) {
+                // An unreadable baseline is replaced with default tolerances
+            }
+        }
+
+        std::ofstream out(baseline_file_);
+        if (!out.is_open()) {
+            log_error("Cannot write baseline ", baseline_file_);
+            return false;
+        }
+        out << "{\n";
+        out << "  \"schema_version\": 1,\n";
+        out << "  \"repeats\": " << repeats_ << ",\n";
+        out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "  \"tolerances\": {\n";
+        out << "    \"time_floor_seconds\": " << time_floor;
+        for (const auto& [name, value] : tolerances) {
+            out << ",\n    \"" << name << "\": " << value;
+        }
+        out << "\n  },\n";
+        out << "  \"metrics\": {\n";
+        for (size_t i = 0; i < metrics_.size(); ++i) {
+            out << "    \"" << metrics_[i].key << "\": ";
+            if (metrics_[i].kind == MetricKind::TIME) {
+                out << std::scientific << std::setprecision(6) << metrics_[i].value << std::defaultfloat;
+            } else {
+                out << std::fixed << std::setprecision(0) << metrics_[i].value << std::defaultfloat;
+            }
+            out << (i + 1 < metrics_.size() ? ",\n" : "\n");
+        }
+        out << "  }\n}\n";
+        std::cout << "Wrote " << metrics_.size() << " metrics to " << baseline_file_ << "\n";
+        return static_cast<bool>(out);
+    }
+
+private:
+    void add_metric(const std::string& game, const std::string& solver, const std::string& name,
+                    MetricKind kind, double value) {
+        metrics_.push_back({game + "/" + solver + "/" + name, kind, value});
+    }
+
+    static std::string generate(const CorpusGame& game) {
+        ggg::graphs::GameGeneratorOptions options;
+        options.vertices = game.vertices;
+        options.edges = game.vertices * game.degree;
+        options.time_bound = game.time_bound;
+        options.nesting_depth = game.nesting_depth;
+        options.player1_ratio = game.player1_ratio;
+        options.target_density = game.target_density;
+        options.seed = game.seed;
+        options.set_constraint_mix(game.mix);
+        options.unconstrained_weight = game.unconstrained_weight;
+        return ggg::graphs::GameGenerator(options).generate_dot();
+    }
+
+    void run_game(const std::string& game, const std::string& dot, int time_bound) {
+        // DOT load, including constraint parsing
+        std::vector<double> load_times;
+        auto manager = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+        for (int r = 0; r < repeats_; ++r) {
+            manager = std::make_shared<ggg::graphs::GGGTemporalGameManager>();
+            auto start = Clock::now();
+            manager->load_from_dot_string(dot);
+            load_times.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+        }
+        add_metric(game, "load", "load_time", MetricKind::TIME, median(load_times));
+
+        auto objective = std::make_shared<ggg::graphs::GGGReachabilityObjective>(
+            ggg::graphs::GGGReachabilityObjective::Type::REACHABILITY, manager->get_target_vertices());
+        const auto& graph = *manager->graph();
+
+        // Backwards temporal attractor
+        {
+            std::vector<double> times;
+            size_t checks = 0;
+            size_t winning = 0;
+            for (int r = 0; r < repeats_; ++r) {
+                ggg::solvers::GGGTemporalReachabilitySolver solver(manager, objective, time_bound, false);
+                auto start = Clock::now();
+                auto solution = solver.solve(graph);
+                times.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+                checks = solver.get_statistics().edge_constraint_checks;
+                winning = 0;
+                auto [vertex_begin, vertex_end] = boost::vertices(graph);
+                for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+                    if (solution.is_won_by_player0(*vertex_it)) {
+                        ++winning;
+                    }
+                }
+            }
+            add_metric(game, "backwards", "solve_time", MetricKind::TIME, median(times));
+            add_metric(game, "backwards", "constraint_checks", MetricKind::WORK, static_cast<double>(checks));
+            add_metric(game, "backwards", "player0_winning", MetricKind::RESULT, static_cast<double>(winning));
+        }
+
+        // Static expansion
+        {
+            std::vector<double> times;
+            ggg::solvers::StaticExpansionStatistics stats;
+            for (int r = 0; r < repeats_; ++r) {
+                ggg::solvers::StaticExpansionSolver solver(manager, objective, time_bound, false);
+                auto start = Clock::now();
+                solver.solve(graph);
+                times.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+                stats = solver.get_statistics();
+            }
+            add_metric(game, "static_expansion", "solve_time", MetricKind::TIME, median(times));
+            add_metric(game, "static_expansion", "expanded_edges", MetricKind::WORK,
+                       static_cast<double>(stats.expanded_edges));
+            add_metric(game, "static_expansion", "player0_winning", MetricKind::RESULT,
+                       static_cast<double>(stats.vertices_winning_at_time_0));
+        }
+    }
+
+    static std::string format_value(MetricKind kind, double value) {
+        std::ostringstream out;
+        if (kind == MetricKind::TIME) {
+            out << std::fixed << std::setprecision(3) << value * 1000.0 << " ms";
+        } else {
+            out << std::fixed << std::setprecision(0) << value;
+        }
+        return out.str();
+    }
+
+    static std::string format_percent(double fraction) {
+        std::ostringstream out;
+        out << std::showpos << std::fixed << std::setprecision(1) << fraction * 100.0 << "%";
+        return out.str();
+    }
+
+    void print_usage() const {
+        std::cout << "Temporis Performance Regression Check\n\n";
+        std::cout << "USAGE:\n";
+        std::cout << "  temporis_perfcheck [OPTIONS]\n\n";
+        std::cout << "OPTIONS:\n";
+        std::cout << "  --baseline FILE        Baseline JSON (default: " << TEMPORIS_PERF_BASELINE << ")\n";
+        std::cout << "  --repeat N             Runs per game and solver; medians are compared (default: 5)\n";
+        std::cout << "  --filter NAME          Only run corpus games whose name contains NAME\n";
+        std::cout << "  --corpus PATH          Add a bundle from temporis --capture, or every *.tbundle in a\n";
+        std::cout << "                         directory, to the corpus as bundle:<name> (repeatable)\n";
+        std::cout << "  --update-baseline      Measure and overwrite the baseline, keeping its tolerances\n";
+        std::cout << "  -q, --quiet            Only print metrics that are not ok\n";
+        std::cout << "  -h, --help             Show this help\n\n";
+        std::cout << "EXIT STATUS:\n";
+        std::cout << "  0 no regression, 1 regression or changed result, 2 missing or invalid baseline\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    PerformanceCheck check;
+
+    ParseResult parsed = check.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 2;
+    }
+
+    if (!check.run()) {
+        return 2;
+    }
+    if (check.update_baseline()) {
+        return check.write_baseline() ? 0 : 2;
+    }
+    return check.compare();
+}
@@ -0,0 +1,339 @@
+#include "workload_bundle.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#ifndef TEMPORIS_SOLVER
+#define TEMPORIS_SOLVER "temporis"
+#endif
+
+// Re-executes captured workload bundles and compares their timings with the capture
+namespace {
+    template<typename... Args>
+    void log_error(Args... args) {
+        std::cerr << "[ERROR] ";
+        ((std::cerr << args), ...);
+        std::cerr << std::endl;
+    }
+
+    // Absolute slack so that sub-millisecond phases are not reported as slower
+    constexpr double kTimeFloorSeconds = 0.0005;
+
+    double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    std::string format_ms(double seconds) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms";
+        return out.str();
+    }
+
+    std::string format_percent(double fraction) {
+        std::ostringstream out;
+        out << std::showpos << std::fixed << std::setprecision(1) << fraction * 100.0 << "%";
+        return out.str();
+    }
+
+    std::string read_file(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+}
+
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
+/**
+ * @brief Replays bundles through the solver binary, with the captured options and input on stdin
+ *
+ * Every repeat is a fresh process in a scratch directory, so relative output
+ * files of the captured options (--layer-series, --trace, ...) land there.
+ * The replay's own --stats-json document is compared with the captured one:
+ * phase medians against the captured durations, and the sizes (including the
+ * number of Player 0 winning vertices) must match exactly.
+ */
+class WorkloadReplay {
+private:
+    std::string solver_ = TEMPORIS_SOLVER;
+    int repeats_ = 5;
+    double tolerance_ = 0.5;
+    bool quiet_ = false;
+    std::vector<std::string> inputs_;
+
+    size_t failed_ = 0;
+    size_t changed_ = 0;
+    size_t slower_ = 0;
+
+public:
+    ParseResult parse_arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next_value = [&](std::string& value) {
+                if (i + 1 >= argc) {
+                    log_error(arg, " requires a value");
+                    return false;
+                }
+                value = argv[++i];
+                return true;
+            };
+
+            std::string value;
+            try {
+                if (arg == "--help" || arg == "-h") {
+                    print_usage();
+                    return ParseResult::HELP;
+                } else if (arg == "--solver") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    solver_ = value;
+                } else if (arg == "--repeat" || arg == "-r") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    repeats_ = std::max(1, std::stoi(value));
+                } else if (arg == "--tolerance") {
+                    if (!next_value(value)) return ParseResult::INVALID;
+                    tolerance_ = std::stod(value);
+                } else if (arg == "--quiet" || arg == "-q") {
+                    quiet_ = true;
+                } else if (!arg.empty() && arg[0] == '-') {
+                    log_error("Unknown option: ", arg);
+                    return ParseResult::INVALID;
+                } else {
+                    inputs_.push_back(arg);
+                }
+            } catch (const std::exception&) {
+                log_error("Invalid value for ", arg, ": ", value);
+                return ParseResult::INVALID;
+            }
+        }
+        if (inputs_.empty()) {
+            log_error("No bundles given");
+            print_usage();
+            return ParseResult::INVALID;
+        }
+        return ParseResult::RUN;
+    }
+
+    /**
+     * @return 0 if every bundle replayed with unchanged results, 1 otherwise, 2 if there is nothing to replay
+     */
+    int run() {
+        auto files = ggg::stats::WorkloadBundle::collect(inputs_);
+        if (files.empty()) {
+            log_error("No ", ggg::stats::WorkloadBundle::kExtension, " files found");
+            return 2;
+        }
+
+        std::error_code error;
+        std::string pattern = (std::filesystem::temp_directory_path(error) / "temporis-replay-XXXXXX").string();
+        if (!mkdtemp(pattern.data())) {
+            log_error("Cannot create a scratch directory");
+            return 2;
+        }
+        std::filesystem::path scratch = pattern;
+
+        for (const auto& file : files) {
+            std::string load_error;
+            auto bundle = ggg::stats::WorkloadBundle::load(file, load_error);
+            if (!bundle) {
+                log_error(load_error);
+                ++failed_;
+                continue;
+            }
+            replay(*bundle, scratch);
+        }
+        std::filesystem::remove_all(scratch, error);
+
+        std::cout << "\nReplayed " << files.size() << " bundle(s) x " << repeats_ << ": " << failed_
+                  << " failed, " << changed_ << " with changed results, " << slower_
+                  << " phase(s) slower than captured by more than " << format_percent(tolerance_) << "\n";
+        return failed_ == 0 && changed_ == 0 ? 0 : 1;
+    }
+
+private:
+    /**
+     * @brief Run the solver once on the bundle; the flattened statistics, or nullopt with error set
+     */
+    std::optional<std::map<std::string, double>> execute(const ggg::stats::WorkloadBundle& bundle,
+                                                         const std::filesystem::path& scratch,
+                                                         std::string& error) {
+        std::string input_file = (scratch / "input").string();
+        std::string stats_file = (scratch / "stats.json").string();
+        std::string stderr_file = (scratch / "stderr").string();
+        std::filesystem::remove(stats_file);
+
+        std::vector<std::string> args = {solver_};
+        args.insert(args.end(), bundle.arguments.begin(), bundle.arguments.end());
+        args.push_back("--stats-json");
+        args.push_back(stats_file);
+        std::vector<char*> argv;
+        for (auto& arg : args) {
+            argv.push_back(arg.data());
+        }
+        argv.push_back(nullptr);
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            int in = open(input_file.c_str(), O_RDONLY);
+            int out = open("/dev/null", O_WRONLY);
+            int err = open(stderr_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (in < 0 || out < 0 || err < 0 || chdir(scratch.c_str()) != 0) {
+                _exit(127);
+            }
+            dup2(in, STDIN_FILENO);
+            dup2(out, STDOUT_FILENO);
+            dup2(err, STDERR_FILENO);
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        if (pid < 0) {
+            error = "cannot start " + solver_;
+            return std::nullopt;
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::string message = read_file(stderr_file);
+            message = message.substr(0, message.find('\n'));
+            error = solver_ + " exited with status " +
+                    std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status)) +
+                    (message.empty() ? "" : ": " + message);
+            return std::nullopt;
+        }
+        try {
+            return ggg::stats::flatten_json_numbers(read_file(stats_file));
+        } catch (const std::exception& e) {
+            error = std::string("unreadable statistics: ") + e.what();
+            return std::nullopt;
+        }
+    }
+
+    void replay(const ggg::stats::WorkloadBundle& bundle, const std::filesystem::path& scratch) {
+        std::cout << "\n=== " << bundle.name << " ===\n";
+        std::cout << "Captured " << bundle.captured_at << " on " << bundle.host << " from " << bundle.source
+                  << ", " << bundle.input.size() << " bytes, options:";
+        for (const auto& argument : bundle.arguments) {
+            std::cout << " " << argument;
+        }
+        std::cout << "\n";
+
+        std::map<std::string, double> captured;
+        try {
+            captured = ggg::stats::flatten_json_numbers(bundle.statistics);
+        } catch (const std::exception& e) {
+            log_error(bundle.name, ": unreadable captured statistics: ", e.what());
+            ++failed_;
+            return;
+        }
+        std::ofstream(scratch / "input", std::ios::binary) << bundle.input;
+
+        std::map<std::string, std::vector<double>> samples;
+        bool results_changed = false;
+        for (int r = 0; r < repeats_; ++r) {
+            std::string error;
+            auto values = execute(bundle, scratch, error);
+            if (!values) {
+                log_error(bundle.name, ": ", error);
+                ++failed_;
+                return;
+            }
+            for (const auto& [key, value] : *values) {
+                if (key.starts_with("phases/") || key.starts_with("solve_phases/")) {
+                    samples[key].push_back(value);
+                } else if (key.starts_with("sizes/") && r == 0) {
+                    auto it = captured.find(key);
+                    if (it != captured.end() && it->second != value) {
+                        std::cout << "CHANGED " << key.substr(6) << ": captured " << it->second << ", replay "
+                                  << value << "\n";
+                        results_changed = true;
+                    }
+                }
+            }
+        }
+        if (results_changed) {
+            ++changed_;
+        }
+
+        std::cout << std::left << std::setw(34) << "phase" << std::right << std::setw(14) << "captured"
+                  << std::setw(14) << "median" << std::setw(14) << "min" << std::setw(14) << "max"
+                  << std::setw(10) << "change" << "  status\n";
+        // Top-level phases first, total last
+        std::vector<std::string> keys;
+        for (const auto& [key, values] : samples) {
+            if (key != "phases/total") {
+                keys.push_back(key);
+            }
+        }
+        std::stable_partition(keys.begin(), keys.end(), [](const std::string& key) { return key.starts_with("phases/"); });
+        if (samples.count("phases/total")) {
+            keys.push_back("phases/total");
+        }
+        for (const auto& key : keys) {
+            const auto& values = samples[key];
+            double current = median(values);
+            auto it = captured.find(key);
+            std::string status = "new";
+            double change = 0.0;
+            if (it != captured.end()) {
+                change = it->second > 0.0 ? (current - it->second) / it->second : 0.0;
+                if (current > it->second * (1.0 + tolerance_) + kTimeFloorSeconds) {
+                    status = "SLOWER";
+                    ++slower_;
+                } else if (current * (1.0 + tolerance_) + kTimeFloorSeconds < it->second) {
+                    status = "faster";
+                } else {
+                    status = "ok";
+                }
+            }
+            if (quiet_ && status == "ok") {
+                continue;
+            }
+            std::string name = key.starts_with("phases/") ? key.substr(7) : "solve/" + key.substr(13);
+            std::cout << std::left << std::setw(34) << name << std::right
+                      << std::setw(14) << (it != captured.end() ? format_ms(it->second) : "-")
+                      << std::setw(14) << format_ms(current)
+                      << std::setw(14) << format_ms(*std::min_element(values.begin(), values.end()))
+                      << std::setw(14) << format_ms(*std::max_element(values.begin(), values.end()))
+                      << std::setw(10) << format_percent(change) << "  " << status << "\n";
+        }
+    }
+
+    void print_usage() const {
+        std::cout << "Temporis Workload Replay\n\n";
+        std::cout << "USAGE:\n";
+        std::cout << "  temporis_replay [OPTIONS] BUNDLE|DIR...\n\n";
+        std::cout << "Re-executes bundles written by temporis --capture (directories: every *.tbundle file)\n";
+        std::cout << "with their captured options and input, and compares the timings with the capture.\n\n";
+        std::cout << "OPTIONS:\n";
+        std::cout << "  --solver PATH          Solver binary (default: " << TEMPORIS_SOLVER << ")\n";
+        std::cout << "  -r, --repeat N         Runs per bundle; medians are compared (default: 5)\n";
+        std::cout << "  --tolerance F          Relative slowdown reported as SLOWER (default: 0.5)\n";
+        std::cout << "  -q, --quiet            Only print phases that are not ok\n";
+        std::cout << "  -h, --help             Show this help\n\n";
+        std::cout << "EXIT STATUS:\n";
+        std::cout << "  0 all replays succeeded with the captured results, 1 a replay failed or its\n";
+        std::cout << "  results changed, 2 no bundles\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    WorkloadReplay replay;
+
+    ParseResult parsed = replay.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 2;
+    }
+
+    return replay.run();
+}
@@ -1,9 +1,17 @@
+#include "component_solver.hpp"
+#include "constraint_codegen.hpp"
 #include "static_expansion_solver.hpp"
 #include "ggg_temporal_graph.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "run_statistics.hpp"
+#include "trace.hpp"
 #include "libggg/utils/solver_wrapper.hpp"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <mutex>
+#include <optional>
 #include <sstream>
 
 // Simple logging helpers for temporis
@@ -35,6 +43,9 @@ namespace {
     }
 }
 
+// Outcome of parse_arguments; --help is not an error
+enum class ParseResult { RUN, HELP, INVALID };
+
 /**
  * @brief Multi-algorithm temporal solver executable with both backwards and static expansion
  */
@@ -48,13 +59,23 @@ private:
     bool csv_output_;
     bool time_only_;
     bool validate_;
+    bool decompose_ = false;
+    int threads_ = 0;
+    int attractor_threads_ = 1;
+    bool compile_constraints_ = false;
+    bool lazy_constraints_ = false;
+    std::string codegen_cache_;
+    std::optional<ggg::codegen::ConstraintCompiler> codegen_;
+    std::string stats_json_file_;
+    ggg::stats::RunStatistics run_stats_;
 
 public:
     StaticExpansionTemporalExecutor() 
         : time_bound_(50), verbose_(false), debug_(false), 
-          csv_output_(false), time_only_(false), validate_(false) {}
+          csv_output_(false), time_only_(false), validate_(false),
+          run_stats_("temporis_static_expansion") {}
 
-    bool parse_arguments(int argc, char* argv[]) {
+    ParseResult parse_arguments(int argc, char* argv[]) {
         std::vector<std::string> files;
         
         for (int i = 1; i < argc; ++i) {
@@ -62,7 +83,7 @@ public:
             
             if (arg == "--help" || arg == "-h") {
                 print_usage();
-                return false;
+                return ParseResult::HELP;
             } else if (arg == "--verbose" || arg == "-v") {
                 verbose_ = true;
                 g_verbose = true;
@@ -80,21 +101,78 @@ public:
                 csv_output_ = true;
             } else if (arg == "--time-only") {
                 time_only_ = true;
+            } else if (arg == "--trace") {
+                if (i + 1 >= argc) {
+                    log_error("--trace requires a file name");
+                    return ParseResult::INVALID;
+                }
+                start_tracing(argv[++i]);
+            } else if (arg == "--perf-counters") {
+                if (!ggg::perf::PerfCounters::instance().enable()) {
+                    log_debug("Hardware counters unavailable: ", ggg::perf::PerfCounters::instance().unavailable_reason());
+                }
+            } else if (arg == "--decompose") {
+                decompose_ = true;
+            } else if (arg == "--threads") {
+                if (i + 1 >= argc) {
+                    log_error("--threads requires a value");
+                    return ParseResult::INVALID;
+                }
+                try {
+                    threads_ = std::stoi(argv[++i]);
+                } catch (const std::exception&) {
+                    threads_ = -1;
+                }
+                if (threads_ < 0) {
+                    log_error("Invalid thread count: ", argv[i]);
+                    return ParseResult::INVALID;
+                }
+            } else if (arg == "--attractor-threads") {
+                if (i + 1 >= argc) {
+                    log_error("--attractor-threads requires a value");
+                    return ParseResult::INVALID;
+                }
+                try {
+                    attractor_threads_ = std::stoi(argv[++i]);
+                } catch (const std::exception&) {
+                    attractor_threads_ = -1;
+                }
+                if (attractor_threads_ < 0) {
+                    log_error("Invalid thread count: ", argv[i]);
+                    return ParseResult::INVALID;
+                }
+            } else if (arg == "--lazy-constraints") {
+                lazy_constraints_ = true;
+            } else if (arg == "--compile-constraints") {
+                compile_constraints_ = true;
+            } else if (arg == "--codegen-cache") {
+                if (i + 1 >= argc) {
+                    log_error("--codegen-cache requires a directory");
+                    return ParseResult::INVALID;
+                }
+                codegen_cache_ = argv[++i];
+                compile_constraints_ = true;
+            } else if (arg == "--stats-json") {
+                if (i + 1 >= argc) {
+                    log_error("--stats-json requires a file name");
+                    return ParseResult::INVALID;
+                }
+                stats_json_file_ = argv[++i];
             } else if (arg == "--time-bound") {
                 if (i + 1 < argc) {
                     try {
                         time_bound_ = std::stoi(argv[++i]);
                     } catch (const std::exception&) {
                         log_error("Invalid time bound value: ", argv[i]);
-                        return false;
+                        return ParseResult::INVALID;
                     }
                 } else {
                     log_error("--time-bound requires a value");
-                    return false;
+                    return ParseResult::INVALID;
                 }
             } else if (arg.empty() || arg[0] == '-') {
                 log_error("Unknown option: ", arg);
-                return false;
+                return ParseResult::INVALID;
             } else {
                 files.push_back(arg);
             }
@@ -102,20 +180,24 @@ public:
         
         // Handle input - either from file or stdin
         if (files.empty()) {
-            return parse_from_stdin();
+            return parse_from_stdin() ? ParseResult::RUN : ParseResult::INVALID;
         } else if (files.size() == 1) {
-            return parse_from_file(files[0]);
+            return parse_from_file(files[0]) ? ParseResult::RUN : ParseResult::INVALID;
         } else {
             log_error("Only one input file allowed");
-            return false;
+            return ParseResult::INVALID;
         }
     }
 
     bool parse_from_stdin() {
         std::string content;
-        std::string line;
-        while (std::getline(std::cin, line)) {
-            content += line + "\n";
+        {
+            TEMPORIS_TRACE_SCOPE("read_input");
+            ggg::stats::ScopedPhase read_phase(run_stats_, "read");
+            std::string line;
+            while (std::getline(std::cin, line)) {
+                content += line + "\n";
+            }
         }
         
         int extracted_time_bound = extract_time_bound_from_content(content);
@@ -138,8 +220,13 @@ public:
         }
         
         // Extract time bound from file content
-        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-        file.close();
+        std::string content;
+        {
+            TEMPORIS_TRACE_SCOPE("read_input");
+            ggg::stats::ScopedPhase read_phase(run_stats_, "read");
+            content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            file.close();
+        }
         
         int extracted_time_bound = extract_time_bound_from_content(content);
         if (extracted_time_bound > 0) {
@@ -190,7 +277,11 @@ public:
             // Read entire input into string
             std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
             
-            if (!manager_->load_from_dot_string(content)) {
+            manager_->set_lazy_constraints(lazy_constraints_);
+            bool load_success = manager_->load_from_dot_string(content);
+            run_stats_.set_input(source_name);
+            run_stats_.add_load_statistics(manager_->load_statistics());
+            if (!load_success) {
                 log_error("Failed to parse temporal graph from ", source_name);
                 return false;
             }
@@ -198,7 +289,19 @@ public:
             log_debug("Successfully parsed graph with ", 
                       boost::num_vertices(*manager_->graph()), " vertices");
             
+            if (compile_constraints_) {
+                codegen_.emplace(codegen_cache_);
+                if (codegen_->compile(*manager_)) {
+                    log_debug("Constraints compiled to ", codegen_->get_report().object_path,
+                              codegen_->get_report().cache_hit ? " (cache hit)" : "");
+                } else if (!csv_output_ && !time_only_) {
+                    log_info("Constraint codegen unavailable (", codegen_->get_report().fallback_reason,
+                             "), interpreting constraints");
+                }
+            }
+            
             // Create objective
+            ggg::stats::ScopedPhase preprocess_phase(run_stats_, "preprocess");
             std::set<ggg::graphs::GGGTemporalGraph::vertex_descriptor> targets;
             targets = manager_->get_target_vertices();
             
@@ -227,11 +330,49 @@ public:
         // Create static expansion solver
         auto solver = std::make_unique<ggg::solvers::StaticExpansionSolver>(
             manager_, objective_, time_bound_, verbose_);
+        solver->set_attractor_threads(attractor_threads_);
         
         // Solve the game
         auto start_time = std::chrono::high_resolution_clock::now();
-        auto solution = solver->solve(*manager_->graph());
+        ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph> solution;
+        std::optional<ggg::solvers::ComponentSolver> components;
+        ggg::solvers::StaticExpansionStatistics component_totals;
+        if (decompose_) {
+            components.emplace(manager_, objective_, threads_);
+            solution = solve_components(*components, component_totals);
+        } else {
+            solution = solver->solve(*manager_->graph());
+        }
         auto end_time = std::chrono::high_resolution_clock::now();
+        run_stats_.add_phase("solve", end_time - start_time);
+        if (decompose_) {
+            component_totals.total_solve_time = end_time - start_time;
+            run_stats_.add_component_statistics(components->get_statistics());
+        }
+        
+        const auto& solve_stats = decompose_ ? component_totals : solver->get_statistics();
+        ggg::memory::MemoryReport memory;
+        memory.add("graph", manager_->graph_memory_bytes());
+        memory.add("constraints", manager_->constraint_memory_bytes());
+        memory.add("expanded_graph", solve_stats.expanded_graph_bytes);
+        memory.add("expansion_maps", solve_stats.expansion_map_bytes);
+        memory.add("attractor_sets", solve_stats.attractor_bytes);
+        memory.add("solution", solve_stats.solution_bytes);
+        record_run_statistics(components ? ggg::solvers::ComponentSolver::get_name(solver->get_name())
+                                         : solver->get_name(),
+                              solve_stats, memory);
+        // Every edge is checked once per layer
+        double codegen_evaluations = codegen_
+            ? codegen_->get_report().estimated_evaluations(solve_stats.constraint_evaluations) : 0.0;
+        if (codegen_) {
+            run_stats_.add_codegen_report(codegen_->get_report(), codegen_evaluations);
+        }
+        if (lazy_constraints_) {
+            run_stats_.add_lazy_constraint_statistics(manager_->lazy_constraint_statistics());
+        }
+        
+        TEMPORIS_TRACE_SCOPE("output");
+        ggg::stats::ScopedPhase output_phase(run_stats_, "output");
         
         auto solve_duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
         double solve_time_seconds = solve_duration.count() / 1000000.0;
@@ -246,8 +387,7 @@ public:
         
         if (csv_output_) {
             // Output CSV format with static expansion statistics
-            auto* static_solver = static_cast<ggg::solvers::StaticExpansionSolver*>(solver.get());
-            const auto& stats = static_solver->get_statistics();
+            const auto& stats = solve_stats;
             std::string extra_stats = std::to_string(stats.expanded_vertices) + "," + 
                                      std::to_string(stats.expanded_edges) + "," +
                                      std::to_string(stats.attractor_vertices);
@@ -256,7 +396,12 @@ public:
                       << "game" << ","
                       << "solved" << ","
                       << std::fixed << std::setprecision(6) << solve_time_seconds << ","
-                      << extra_stats << std::endl;
+                      << extra_stats
+                      << memory.csv_fields();
+            if (ggg::perf::PerfCounters::instance().enabled()) {
+                std::cout << ggg::perf::PerfCounters::instance().csv_fields("solve");
+            }
+            std::cout << std::endl;
             return;
         }
         
@@ -266,8 +411,7 @@ public:
         
         // Print static expansion statistics
         if (verbose_) {
-            auto* static_solver = static_cast<ggg::solvers::StaticExpansionSolver*>(solver.get());
-            const auto& stats = static_solver->get_statistics();
+            const auto& stats = solve_stats;
             
             std::cout << "\n=== Static Expansion Statistics ===" << std::endl;
             std::cout << "Original graph: " << stats.original_vertices << " vertices, " << stats.original_edges << " edges" << std::endl;
@@ -275,7 +419,25 @@ public:
             std::cout << "Time layers: " << stats.time_layers << std::endl;
             std::cout << "Expansion time: " << stats.expansion_time.count() << "s" << std::endl;
             std::cout << "Attractor time: " << stats.attractor_time.count() << "s" << std::endl;
+            if (stats.attractor_threads > 0) {
+                std::cout << "Parallel attractor: " << stats.attractor_threads << " threads, "
+                          << stats.attractor_levels << " frontiers" << std::endl;
+            }
             std::cout << "Constraint evaluations: " << stats.constraint_evaluations << std::endl;
+            if (components) {
+                components->write_report(std::cout);
+            }
+            if (codegen_) {
+                codegen_->write_report(std::cout, codegen_evaluations);
+            }
+            if (lazy_constraints_) {
+                manager_->lazy_constraint_statistics().write_report(std::cout);
+            }
+            memory.write_report(std::cout);
+            
+            if (ggg::perf::PerfCounters::instance().enabled()) {
+                ggg::perf::PerfCounters::instance().write_report(std::cout);
+            }
         }
         
         std::cout << "\n=== Solution ===" << std::endl;
@@ -299,6 +461,79 @@ public:
         }
     }
 
+    /**
+     * @brief Write --stats-json output if requested
+     * @return false if the statistics file could not be written
+     */
+    bool write_statistics() const {
+        if (stats_json_file_.empty()) {
+            return true;
+        }
+        if (!run_stats_.write_json(stats_json_file_)) {
+            log_error("Cannot write statistics file ", stats_json_file_);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Solve every weakly connected component on its own, merging the statistics into totals
+     */
+    ggg::solutions::RSSolution<ggg::graphs::GGGTemporalGraph> solve_components(
+        ggg::solvers::ComponentSolver& components, ggg::solvers::StaticExpansionStatistics& totals) {
+        std::mutex totals_mutex;
+        return components.solve([&](const ggg::solvers::SubGame& sub, std::string& engine) {
+            ggg::solvers::StaticExpansionSolver part(sub.manager, sub.objective, time_bound_, false);
+            part.set_attractor_threads(attractor_threads_);
+            auto result = part.solve(*sub.manager->graph());
+            engine = "static_expansion";
+            std::lock_guard<std::mutex> lock(totals_mutex);
+            totals.accumulate(part.get_statistics());
+            return result;
+        });
+    }
+
+    void record_run_statistics(const std::string& solver_name,
+                               const ggg::solvers::StaticExpansionStatistics& stats,
+                               const ggg::memory::MemoryReport& memory) {
+        run_stats_.set_solver(solver_name);
+        run_stats_.set_status("solved");
+        
+        run_stats_.add_solve_phase("expansion", stats.expansion_time);
+        run_stats_.add_solve_phase("create_target_set", stats.target_set_time);
+        run_stats_.add_solve_phase("attractor", stats.attractor_time);
+        run_stats_.add_solve_phase("build_solution", stats.solution_time);
+        
+        run_stats_.set_size("vertices", stats.original_vertices);
+        run_stats_.set_size("edges", stats.original_edges);
+        run_stats_.set_size("targets", objective_->get_targets().size());
+        run_stats_.set_size("time_bound", time_bound_);
+        run_stats_.set_size("player0_winning", stats.vertices_winning_at_time_0);
+        run_stats_.set_size("expanded_vertices", stats.expanded_vertices);
+        run_stats_.set_size("expanded_edges", stats.expanded_edges);
+        run_stats_.set_size("attractor_vertices", stats.attractor_vertices);
+        
+        run_stats_.set_counter("layers", stats.time_layers);
+        run_stats_.set_counter("constraint_evaluations", stats.constraint_evaluations);
+        run_stats_.set_counter("constraint_passes", stats.constraint_passes);
+        run_stats_.set_counter("constraint_failures", stats.constraint_failures);
+        if (stats.attractor_threads > 0) {
+            run_stats_.set_counter("attractor_threads", stats.attractor_threads);
+            run_stats_.set_counter("attractor_frontiers", stats.attractor_levels);
+        }
+        
+        run_stats_.set_memory(memory);
+    }
+
+    void start_tracing(const std::string& trace_file) {
+#ifdef TEMPORIS_DISABLE_TRACING
+        log_error("Tracing was disabled at build time, ignoring --trace ", trace_file);
+#else
+        ggg::trace::Tracer::instance().start(trace_file);
+        ggg::trace::Tracer::instance().set_thread_name("main");
+#endif
+    }
+
     void print_usage() {
         std::cout << "Static Expansion Temporal Reachability Solver\n\n";
         std::cout << "USAGE:\n";
@@ -311,7 +546,17 @@ public:
         std::cout << "  --validate              Enable solution validation\n";
         std::cout << "  --csv                   Output in CSV format for benchmarking\n";
         std::cout << "  --time-only             Output only solve time in seconds\n";
-        std::cout << "  --time-bound TIME       Set time bound (default: 50)\n\n";
+        std::cout << "  --time-bound TIME       Set time bound (default: 50)\n";
+        std::cout << "  --trace FILE            Write a Chrome trace (Perfetto JSON) of the run to FILE\n";
+        std::cout << "  --perf-counters         Sample hardware counters per solve phase (Linux perf_event_open)\n";
+        std::cout << "  --stats-json FILE       Write load, solve and output statistics as JSON to FILE\n";
+        std::cout << "  --decompose             Solve weakly connected components independently in parallel\n";
+        std::cout << "  --threads N             Worker threads for --decompose (default: all hardware threads)\n";
+        std::cout << "  --attractor-threads N   Threads for the expanded-graph attractor; 1 is GGG's sequential\n";
+        std::cout << "                          attractor (default), 0 uses all hardware threads\n";
+        std::cout << "  --lazy-constraints      Keep constraint text at load and parse each constraint on first use\n";
+        std::cout << "  --compile-constraints   Compile the constraints to native code (cached shared object)\n";
+        std::cout << "  --codegen-cache DIR     Cache directory for --compile-constraints (default: ~/.cache/temporis)\n\n";
         std::cout << "ALGORITHM:\n";
         std::cout << "  This solver uses static expansion: creates (vertex,time) pairs for all time layers,\n";
         std::cout << "  then uses GGG's attractor computation on the expanded graph.\n\n";
@@ -325,10 +570,20 @@ public:
 int main(int argc, char* argv[]) {
     StaticExpansionTemporalExecutor executor;
     
-    if (!executor.parse_arguments(argc, argv)) {
-        return 1;
+    ParseResult parsed = executor.parse_arguments(argc, argv);
+    if (parsed != ParseResult::RUN) {
+        return parsed == ParseResult::HELP ? 0 : 1;
     }
     
-    executor.solve_and_output();
-    return 0;
+    try {
+        executor.solve_and_output();
+    } catch (const std::exception& e) {
+        // Deferred constraints are parsed during the solve with --lazy-constraints
+        log_error(e.what());
+        ggg::trace::Tracer::instance().write();
+        return 1;
+    }
+    bool stats_written = executor.write_statistics();
+    bool trace_written = ggg::trace::Tracer::instance().write();
+    return stats_written && trace_written ? 0 : 1;
 }
@@ -0,0 +1,81 @@
+#include "memory_usage.hpp"
+#include <iomanip>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace ggg {
+namespace memory {
+
+size_t peak_rss_bytes() {
+#ifdef __linux__
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return static_cast<size_t>(usage.ru_maxrss) * 1024; // ru_maxrss is in kilobytes
+    }
+#endif
+    return 0;
+}
+
+void MemoryReport::add(const std::string& name, size_t bytes) {
+    for (auto& entry : entries_) {
+        if (entry.first == name) {
+            entry.second += bytes;
+            return;
+        }
+    }
+    entries_.emplace_back(name, bytes);
+}
+
+size_t MemoryReport::get(const std::string& name) const {
+    for (const auto& entry : entries_) {
+        if (entry.first == name) {
+            return entry.second;
+        }
+    }
+    return 0;
+}
+
+size_t MemoryReport::total() const {
+    size_t total = 0;
+    for (const auto& entry : entries_) {
+        total += entry.second;
+    }
+    return total;
+}
+
+void MemoryReport::write_report(std::ostream& out) const {
+    auto megabytes = [](size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+
+    // Restored below, so later output on the caller's stream keeps its format
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "\n=== Memory Usage (estimated) ===\n";
+    out << std::fixed << std::setprecision(3);
+    for (const auto& [name, bytes] : entries_) {
+        out << "  " << std::left << std::setw(24) << name << std::right << std::setw(12)
+            << megabytes(bytes) << " MB\n";
+    }
+    out << "  " << std::left << std::setw(24) << "total" << std::right << std::setw(12)
+        << megabytes(total()) << " MB\n";
+    out << "  " << std::left << std::setw(24) << "peak RSS" << std::right << std::setw(12)
+        << megabytes(peak_rss_bytes()) << " MB\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+std::string MemoryReport::csv_fields() const {
+    std::string fields;
+    for (const auto& entry : entries_) {
+        fields += ',';
+        fields += std::to_string(entry.second);
+    }
+    fields += ',';
+    fields += std::to_string(peak_rss_bytes());
+    return fields;
+}
+
+} // namespace memory
+} // namespace ggg
@@ -0,0 +1,241 @@
+#include "parallel_attractor.hpp"
+#include "perf_counters.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+void fetch_min(std::atomic<uint64_t>& value, uint64_t candidate) {
+    uint64_t current = value.load(std::memory_order_relaxed);
+    while (candidate < current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+    }
+}
+
+void fetch_max(std::atomic<uint64_t>& value, uint64_t candidate) {
+    uint64_t current = value.load(std::memory_order_relaxed);
+    while (candidate > current && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+    }
+}
+
+// claimed[v] holds 0 outside the attractor, otherwise the level that attracted v plus one
+constexpr uint32_t kTargetLevel = 1;
+
+} // namespace
+
+ParallelAttractor::ParallelAttractor(int threads) : threads_(threads) {
+    if (threads_ <= 0) {
+        threads_ = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+std::pair<std::set<ParallelAttractor::Vertex>, std::map<ParallelAttractor::Vertex, ParallelAttractor::Vertex>>
+ParallelAttractor::compute(const Graph& graph, const std::set<Vertex>& targets, int player) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "parallel_attractor");
+    stats_ = ParallelAttractorStatistics{};
+    const size_t vertex_count = boost::num_vertices(graph);
+    size_t worker_count = static_cast<size_t>(threads_);
+    stats_.threads = worker_count;
+
+    std::vector<std::atomic<uint32_t>> claimed(vertex_count);
+    std::vector<std::atomic<uint32_t>> remaining(vertex_count);   // opponent: out-edges not yet into the attractor
+    std::vector<std::atomic<uint64_t>> rank(vertex_count);        // rank of the attracting edge
+    std::vector<Vertex> strategy(vertex_count, vertex_count);
+
+    // Current frontier with the rank of each vertex's first in-edge, and the previous one for strategies
+    std::vector<Vertex> frontier;
+    std::vector<uint64_t> offsets;
+    std::vector<Vertex> previous_frontier;
+    std::vector<uint64_t> previous_offsets;
+    std::vector<Vertex> next;
+    std::atomic<size_t> next_size{0};
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<size_t> edges_scanned{0};
+    uint64_t next_rank = 0;
+    uint32_t level_tag = kTargetLevel;
+    bool initialized = false;
+    bool done = false;
+
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+    auto record_failure = [&]() {
+        std::lock_guard<std::mutex> lock(failure_mutex);
+        if (!failure) {
+            failure = std::current_exception();
+        }
+    };
+
+    auto init_start = std::chrono::steady_clock::now();
+    auto frontier_start = init_start;
+
+    // Rank the in-edges of a new frontier and size the buffer for the claims it can make
+    auto start_frontier = [&]() {
+        offsets.resize(frontier.size());
+        uint64_t first_rank = next_rank;
+        for (size_t i = 0; i < frontier.size(); ++i) {
+            offsets[i] = next_rank;
+            next_rank += boost::in_degree(frontier[i], graph);
+        }
+        next.resize(std::min<uint64_t>(vertex_count, next_rank - first_rank));
+        next_size = 0;
+        next_chunk = 0;
+        stats_.levels++;
+        stats_.peak_frontier = std::max(stats_.peak_frontier, frontier.size());
+        done = frontier.empty();
+    };
+
+    // Runs on one thread while the others wait at the barrier
+    auto advance = [&]() noexcept {
+        try {
+            if (failure) {
+                done = true;
+                return;
+            }
+            if (!initialized) {
+                initialized = true;
+                frontier.assign(targets.begin(), targets.end());
+                for (Vertex target : targets) {
+                    claimed[target].store(kTargetLevel, std::memory_order_relaxed);
+                }
+                stats_.init_time = std::chrono::steady_clock::now() - init_start;
+                frontier_start = std::chrono::steady_clock::now();
+                start_frontier();
+                return;
+            }
+            previous_frontier.swap(frontier);
+            previous_offsets.swap(offsets);
+            frontier.assign(next.begin(), next.begin() + static_cast<std::ptrdiff_t>(next_size.load()));
+            std::sort(frontier.begin(), frontier.end(), [&](Vertex a, Vertex b) {
+                return rank[a].load(std::memory_order_relaxed) < rank[b].load(std::memory_order_relaxed);
+            });
+            level_tag++;
+            start_frontier();
+        } catch (...) {
+            record_failure();
+            done = true;
+        }
+    };
+    std::barrier sync(static_cast<std::ptrdiff_t>(worker_count), advance);
+
+    auto work = [&](int worker) {
+        if (worker_count > 1 && trace::Tracer::instance().enabled()) {
+            trace::Tracer::instance().set_thread_name("attractor worker " + std::to_string(worker));
+        }
+        try {
+            for (size_t first = next_chunk.fetch_add(kChunkVertices); first < vertex_count;
+                 first = next_chunk.fetch_add(kChunkVertices)) {
+                size_t last = std::min(vertex_count, first + kChunkVertices);
+                for (size_t v = first; v < last; ++v) {
+                    bool attracting = graph[v].player == player;
+                    remaining[v].store(attracting ? 0 : static_cast<uint32_t>(boost::out_degree(v, graph)),
+                                       std::memory_order_relaxed);
+                    rank[v].store(attracting ? UINT64_MAX : 0, std::memory_order_relaxed);
+                }
+            }
+        } catch (...) {
+            record_failure();
+        }
+        sync.arrive_and_wait();
+
+        std::vector<Vertex> claims;
+        while (!done) {
+            try {
+                const uint32_t tag = level_tag + 1;
+                size_t scanned = 0;
+                for (size_t first = next_chunk.fetch_add(kChunkVertices); first < frontier.size();
+                     first = next_chunk.fetch_add(kChunkVertices)) {
+                    size_t last = std::min(frontier.size(), first + kChunkVertices);
+                    for (size_t i = first; i < last; ++i) {
+                        Vertex v = frontier[i];
+
+                        // The attracting edge was ranked while scanning the previous frontier
+                        if (graph[v].player == player && claimed[v].load(std::memory_order_relaxed) != kTargetLevel) {
+                            auto owner = std::upper_bound(previous_offsets.begin(), previous_offsets.end(),
+                                                          rank[v].load(std::memory_order_relaxed));
+                            strategy[v] = previous_frontier[static_cast<size_t>(owner - previous_offsets.begin()) - 1];
+                        }
+
+                        uint64_t edge_rank = offsets[i];
+                        auto [edge_begin, edge_end] = boost::in_edges(v, graph);
+                        for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it, ++edge_rank) {
+                            Vertex u = boost::source(*edge_it, graph);
+                            uint32_t state = claimed[u].load(std::memory_order_relaxed);
+                            if (state != 0 && state != tag) {
+                                continue;
+                            }
+                            if (graph[u].player == player) {
+                                fetch_min(rank[u], edge_rank);
+                                uint32_t unclaimed = 0;
+                                if (claimed[u].compare_exchange_strong(unclaimed, tag, std::memory_order_relaxed)) {
+                                    claims.push_back(u);
+                                }
+                            } else {
+                                fetch_max(rank[u], edge_rank);
+                                if (remaining[u].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                                    claimed[u].store(tag, std::memory_order_relaxed);
+                                    claims.push_back(u);
+                                }
+                            }
+                        }
+                        scanned += static_cast<size_t>(edge_rank - offsets[i]);
+                    }
+
+                    // Append this chunk's claims to the next frontier
+                    if (!claims.empty()) {
+                        size_t at = next_size.fetch_add(claims.size());
+                        std::copy(claims.begin(), claims.end(), next.begin() + static_cast<std::ptrdiff_t>(at));
+                        claims.clear();
+                    }
+                }
+                edges_scanned += scanned;
+            } catch (...) {
+                record_failure();
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    if (worker_count <= 1) {
+        // A one-thread barrier completes on every arrival, so the same loop runs inline
+        work(0);
+    } else {
+        perf::ScopedWorkerPool running_pool;
+        std::vector<std::thread> workers;
+        for (size_t worker = 0; worker < worker_count; ++worker) {
+            workers.emplace_back(work, static_cast<int>(worker));
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+    stats_.frontier_time = std::chrono::steady_clock::now() - frontier_start;
+    stats_.edges_scanned = edges_scanned;
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    TEMPORIS_TRACE_ARG(trace_scope, "threads", worker_count);
+    TEMPORIS_TRACE_ARG(trace_scope, "levels", stats_.levels);
+
+    std::set<Vertex> attractor;
+    std::map<Vertex, Vertex> attractor_strategy;
+    for (Vertex v = 0; v < vertex_count; ++v) {
+        if (claimed[v].load(std::memory_order_relaxed) != 0) {
+            attractor.insert(attractor.end(), v);
+        }
+        if (strategy[v] != vertex_count) {
+            attractor_strategy.emplace_hint(attractor_strategy.end(), v, strategy[v]);
+        }
+    }
+    return {std::move(attractor), std::move(attractor_strategy)};
+}
+
+} // namespace solvers
+} // namespace ggg
@@ -0,0 +1,229 @@
+#include "perf_counters.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ggg {
+namespace perf {
+
+CounterSample CounterSample::operator-(const CounterSample& other) const {
+    CounterSample result;
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        result.available[i] = available[i] && other.available[i];
+        result.values[i] = values[i] >= other.values[i] ? values[i] - other.values[i] : 0;
+    }
+    return result;
+}
+
+CounterSample& CounterSample::operator+=(const CounterSample& other) {
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        available[i] = available[i] || other.available[i];
+        values[i] += other.values[i];
+    }
+    return *this;
+}
+
+double CounterSample::ipc() const {
+    if (!available[CYCLES] || !available[INSTRUCTIONS] || values[CYCLES] == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(values[INSTRUCTIONS]) / values[CYCLES];
+}
+
+PerfCounters::PerfCounters() {
+    fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+const char* PerfCounters::counter_name(CounterId id) {
+    switch (id) {
+        case CYCLES: return "cycles";
+        case INSTRUCTIONS: return "instructions";
+        case L1D_MISSES: return "l1d_misses";
+        case LLC_MISSES: return "llc_misses";
+        case BRANCH_MISSES: return "branch_misses";
+        default: return "unknown";
+    }
+}
+
+bool PerfCounters::enable() {
+    if (enabled_) {
+        return any_available();
+    }
+    enabled_ = true;
+
+#ifdef __linux__
+    struct EventConfig {
+        uint32_t type;
+        uint64_t config;
+    };
+    const std::array<EventConfig, NUM_COUNTERS> events = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+
+    int last_errno = 0;
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[i].type;
+        attr.config = events[i].config;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0) {
+            last_errno = errno;
+            continue;
+        }
+        fds_[i] = static_cast<int>(fd);
+        ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    if (!any_available()) {
+        unavailable_reason_ = std::string("perf_event_open failed: ") + std::strerror(last_errno);
+        std::ifstream paranoid("/proc/sys/kernel/perf_event_paranoid");
+        int level = 0;
+        if (paranoid >> level) {
+            unavailable_reason_ += " (perf_event_paranoid=" + std::to_string(level) + ")";
+        }
+    }
+#else
+    unavailable_reason_ = "perf_event_open is only available on Linux";
+#endif
+
+    return any_available();
+}
+
+bool PerfCounters::any_available() const {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CounterSample PerfCounters::read() const {
+    CounterSample sample;
+#ifdef __linux__
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        if (fds_[i] < 0) {
+            continue;
+        }
+        // value, time_enabled, time_running
+        uint64_t data[3] = {0, 0, 0};
+        if (::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        // Scale for multiplexing when more events are open than hardware counters
+        uint64_t value = data[0];
+        if (data[2] > 0 && data[2] < data[1]) {
+            value = static_cast<uint64_t>(static_cast<double>(value) * data[1] / data[2]);
+        }
+        sample.values[i] = value;
+        sample.available[i] = true;
+    }
+#endif
+    return sample;
+}
+
+void PerfCounters::add_phase(const std::string& name, const CounterSample& delta, bool partial) {
+    std::lock_guard<std::mutex> lock(phases_mutex_);
+    for (auto& phase : phases_) {
+        if (phase.name == name) {
+            phase.sample += delta;
+            phase.partial = phase.partial || partial;
+            return;
+        }
+    }
+    phases_.push_back({name, delta, partial});
+}
+
+const PhaseCounters* PerfCounters::find_phase(const std::string& name) const {
+    for (const auto& phase : phases_) {
+        if (phase.name == name) {
+            return &phase;
+        }
+    }
+    return nullptr;
+}
+
+void PerfCounters::write_report(std::ostream& out) const {
+    out << "\n=== Hardware Counters ===\n";
+    if (!any_available()) {
+        out << "  Unavailable: " << unavailable_reason_ << "\n";
+        return;
+    }
+
+    // Restored below, so later output on the caller's stream keeps its format
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "  " << std::left << std::setw(20) << "phase";
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        out << std::right << std::setw(16) << counter_name(static_cast<CounterId>(i));
+    }
+    out << std::right << std::setw(8) << "ipc" << "\n";
+
+    bool any_partial = false;
+    for (const auto& phase : phases_) {
+        any_partial = any_partial || phase.partial;
+        out << "  " << std::left << std::setw(20) << (phase.partial ? phase.name + " *" : phase.name) << std::right;
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            if (phase.sample.available[i]) {
+                out << std::setw(16) << phase.sample.values[i];
+            } else {
+                out << std::setw(16) << "n/a";
+            }
+        }
+        out << std::setw(8) << std::fixed << std::setprecision(2) << phase.sample.ipc() << "\n";
+    }
+    if (any_partial) {
+        out << "  * partial: measured while worker threads were running, whose counts are only added when they exit\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+std::string PerfCounters::csv_fields(const std::string& phase) const {
+    const PhaseCounters* counters = find_phase(phase);
+    std::string fields;
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        fields += ",";
+        if (counters && counters->sample.available[i]) {
+            fields += std::to_string(counters->sample.values[i]);
+        }
+    }
+    return fields;
+}
+
+} // namespace perf
+} // namespace ggg
@@ -0,0 +1,414 @@
+#include "play_simulator.hpp"
+#include "perf_counters.hpp"
+#include "trace.hpp"
+#include <boost/graph/graph_traits.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+inline bool test_bit(const uint64_t* bits, size_t index) {
+    return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+inline void set_bit(uint64_t* bits, size_t index) {
+    bits[index >> 6] |= uint64_t{1} << (index & 63);
+}
+
+// splitmix64: one 64-bit state per play, cheap enough to keep in a lane array
+inline uint64_t next_random(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Which enabled moves a policy prefers; it falls back to any enabled move
+enum class Preference : uint8_t { ANY, INTO_NEXT_LAYER, OUT_OF_NEXT_LAYER, STRATEGY_MOVE };
+
+} // namespace
+
+const char* SimulationOptions::name(Player0Policy policy) {
+    switch (policy) {
+        case Player0Policy::STRATEGY: return "strategy";
+        case Player0Policy::SOLUTION: return "solution";
+        case Player0Policy::RANDOM: return "random";
+    }
+    return "unknown";
+}
+
+const char* SimulationOptions::name(Player1Policy policy) {
+    return policy == Player1Policy::ADVERSARIAL ? "adversarial" : "random";
+}
+
+bool SimulationOptions::parse(const std::string& text, Player0Policy& policy) {
+    for (auto candidate : {Player0Policy::STRATEGY, Player0Policy::SOLUTION, Player0Policy::RANDOM}) {
+        if (text == name(candidate)) {
+            policy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SimulationOptions::parse(const std::string& text, Player1Policy& policy) {
+    for (auto candidate : {Player1Policy::RANDOM, Player1Policy::ADVERSARIAL}) {
+        if (text == name(candidate)) {
+            policy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+double SimulationReport::plays_per_second() const {
+    return play_time.count() > 0 ? static_cast<double>(plays) / play_time.count() : 0.0;
+}
+
+double SimulationReport::mean_length() const {
+    double total = 0;
+    for (size_t length = 0; length < length_histogram.size(); ++length) {
+        total += static_cast<double>(length) * static_cast<double>(length_histogram[length]);
+    }
+    return plays > 0 ? total / static_cast<double>(plays) : 0.0;
+}
+
+int SimulationReport::length_percentile(double q) const {
+    uint64_t needed = static_cast<uint64_t>(q * static_cast<double>(plays));
+    uint64_t seen = 0;
+    for (size_t length = 0; length < length_histogram.size(); ++length) {
+        seen += length_histogram[length];
+        if (seen >= needed && seen > 0) {
+            return static_cast<int>(length);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Lanes of one batch, one entry per play, plus the batch's tallies
+ */
+struct PlaySimulator::Batch {
+    std::vector<uint32_t> vertex;
+    std::vector<uint8_t> alive;
+    std::vector<uint64_t> random;
+    uint64_t wins = 0;
+    uint64_t stuck = 0;
+    std::vector<uint64_t> lengths;
+
+    Batch(size_t lanes, int max_time)
+        : vertex(lanes), alive(lanes), random(lanes), lengths(static_cast<size_t>(max_time) + 1, 0) {}
+};
+
+PlaySimulator::PlaySimulator(std::shared_ptr<graphs::GGGTemporalGameManager> manager,
+                             std::shared_ptr<graphs::GGGReachabilityObjective> objective, int max_time)
+    : manager_(manager), objective_(objective), max_time_(std::max(0, max_time)) {
+}
+
+void PlaySimulator::set_solution(const SolutionType& solution) {
+    const auto& graph = *manager_->graph();
+    auto index = boost::get(boost::vertex_index, graph);
+    strategy_.assign(boost::num_vertices(graph), kNoMove);
+    auto [vertex_begin, vertex_end] = boost::vertices(graph);
+    for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+        if (solution.has_strategy(*vertex_it)) {
+            strategy_[index[*vertex_it]] = static_cast<uint32_t>(index[solution.get_strategy(*vertex_it)]);
+        }
+    }
+}
+
+void PlaySimulator::prepare() {
+    TEMPORIS_TRACE_SCOPE("simulation_prepare");
+    const auto& graph = *manager_->graph();
+    auto index = boost::get(boost::vertex_index, graph);
+
+    vertex_count_ = boost::num_vertices(graph);
+    edge_count_ = boost::num_edges(graph);
+    players_.assign(vertex_count_, 0);
+    is_target_.assign(vertex_count_, 0);
+    offsets_.assign(vertex_count_ + 1, 0);
+    targets_.clear();
+    std::vector<graphs::GGGTemporalEdge> edges;
+    edges.reserve(edge_count_);
+    for (size_t v = 0; v < vertex_count_; ++v) {
+        auto vertex = boost::vertex(v, graph);
+        players_[v] = static_cast<uint8_t>(graph[vertex].player);
+        is_target_[v] = objective_->is_target(vertex) && manager_->is_target_constraint_satisfied(vertex, max_time_);
+        auto [edge_begin, edge_end] = boost::out_edges(vertex, graph);
+        for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+            targets_.push_back(static_cast<uint32_t>(index[boost::target(*edge_it, graph)]));
+            edges.push_back(*edge_it);
+        }
+        offsets_[v + 1] = static_cast<uint32_t>(targets_.size());
+    }
+    if (strategy_.size() != vertex_count_) {
+        strategy_.assign(vertex_count_, kNoMove);
+    }
+
+    // Availability bitmap: the only place constraints are evaluated
+    auto availability_start = std::chrono::steady_clock::now();
+    edge_words_ = (edges.size() + 63) / 64;
+    availability_.assign(static_cast<size_t>(max_time_) * edge_words_, 0);
+    for (int time = 0; time < max_time_; ++time) {
+        uint64_t* row = availability_.data() + static_cast<size_t>(time) * edge_words_;
+        for (size_t e = 0; e < edges.size(); ++e) {
+            if (manager_->is_edge_constraint_satisfied(edges[e], time)) {
+                set_bit(row, e);
+            }
+        }
+    }
+    report_.availability_checks = static_cast<uint64_t>(max_time_) * edges.size();
+    report_.availability_time = std::chrono::steady_clock::now() - availability_start;
+
+    // Winning layers from the bitmap, for the strategy and adversarial policies
+    auto layers_start = std::chrono::steady_clock::now();
+    vertex_words_ = (vertex_count_ + 63) / 64;
+    layers_.assign((static_cast<size_t>(max_time_) + 1) * vertex_words_, 0);
+    uint64_t* final_layer = layers_.data() + static_cast<size_t>(max_time_) * vertex_words_;
+    for (size_t v = 0; v < vertex_count_; ++v) {
+        if (is_target_[v]) {
+            set_bit(final_layer, v);
+        }
+    }
+    for (int time = max_time_ - 1; time >= 0; --time) {
+        const uint64_t* row = availability_.data() + static_cast<size_t>(time) * edge_words_;
+        const uint64_t* next = layers_.data() + (static_cast<size_t>(time) + 1) * vertex_words_;
+        uint64_t* layer = layers_.data() + static_cast<size_t>(time) * vertex_words_;
+        for (size_t v = 0; v < vertex_count_; ++v) {
+            size_t enabled = 0;
+            size_t winning = 0;
+            for (uint32_t e = offsets_[v]; e < offsets_[v + 1]; ++e) {
+                if (test_bit(row, e)) {
+                    enabled++;
+                    winning += test_bit(next, targets_[e]);
+                }
+            }
+            if (players_[v] == 0 ? winning > 0 : enabled > 0 && winning == enabled) {
+                set_bit(layer, v);
+            }
+        }
+    }
+    report_.layers_time = std::chrono::steady_clock::now() - layers_start;
+    prepared_ = true;
+}
+
+void PlaySimulator::run_batch(Batch& batch, const std::vector<uint32_t>& starts, uint64_t first_play,
+                              size_t lanes) const {
+    const auto& options = report_.options;
+    Preference preference[2];
+    switch (options.player0) {
+        case SimulationOptions::Player0Policy::STRATEGY: preference[0] = Preference::INTO_NEXT_LAYER; break;
+        case SimulationOptions::Player0Policy::SOLUTION: preference[0] = Preference::STRATEGY_MOVE; break;
+        default: preference[0] = Preference::ANY; break;
+    }
+    preference[1] = options.player1 == SimulationOptions::Player1Policy::ADVERSARIAL
+        ? Preference::OUT_OF_NEXT_LAYER : Preference::ANY;
+
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        uint64_t play = first_play + lane;
+        batch.vertex[lane] = starts[play % starts.size()];
+        batch.alive[lane] = 1;
+        batch.random[lane] = options.seed ^ (play * 0xD1B54A32D192ED03ULL);
+    }
+
+    // All lanes advance one time step before the next one
+    for (int time = 0; time < max_time_; ++time) {
+        const uint64_t* row = availability_.data() + static_cast<size_t>(time) * edge_words_;
+        const uint64_t* next = layers_.data() + (static_cast<size_t>(time) + 1) * vertex_words_;
+        size_t live = 0;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (!batch.alive[lane]) {
+                continue;
+            }
+            uint32_t vertex = batch.vertex[lane];
+            Preference prefer = preference[players_[vertex]];
+            auto preferred = [&](uint32_t e) {
+                switch (prefer) {
+                    case Preference::INTO_NEXT_LAYER: return test_bit(next, targets_[e]);
+                    case Preference::OUT_OF_NEXT_LAYER: return !test_bit(next, targets_[e]);
+                    case Preference::STRATEGY_MOVE: return targets_[e] == strategy_[vertex];
+                    default: return false;
+                }
+            };
+
+            uint32_t enabled = 0;
+            uint32_t preferred_count = 0;
+            for (uint32_t e = offsets_[vertex]; e < offsets_[vertex + 1]; ++e) {
+                if (test_bit(row, e)) {
+                    enabled++;
+                    preferred_count += preferred(e);
+                }
+            }
+            if (enabled == 0) {
+                batch.alive[lane] = 0;
+                batch.stuck++;
+                batch.lengths[static_cast<size_t>(time)]++;
+                continue;
+            }
+
+            // The k-th enabled (preferred, if any) move, uniformly
+            bool use_preferred = preferred_count > 0;
+            uint32_t k = static_cast<uint32_t>(next_random(batch.random[lane]) %
+                                               (use_preferred ? preferred_count : enabled));
+            for (uint32_t e = offsets_[vertex]; e < offsets_[vertex + 1]; ++e) {
+                if (test_bit(row, e) && (!use_preferred || preferred(e)) && k-- == 0) {
+                    batch.vertex[lane] = targets_[e];
+                    break;
+                }
+            }
+            live++;
+        }
+        if (live == 0) {
+            break;
+        }
+    }
+
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        if (batch.alive[lane]) {
+            batch.lengths[static_cast<size_t>(max_time_)]++;
+            batch.wins += is_target_[batch.vertex[lane]];
+        }
+    }
+}
+
+const SimulationReport& PlaySimulator::simulate(const SimulationOptions& options) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "simulate");
+    if (!prepared_) {
+        prepare();
+    }
+    report_.options = options;
+    report_.plays = report_.wins = report_.stuck = report_.batches = 0;
+    report_.winning_starts = false;
+    report_.length_histogram.assign(static_cast<size_t>(max_time_) + 1, 0);
+
+    std::vector<uint32_t> starts;
+    if (options.start_vertex) {
+        starts.push_back(static_cast<uint32_t>(*options.start_vertex));
+    } else {
+        for (size_t v = 0; v < vertex_count_ && options.from_winning; ++v) {
+            if (test_bit(layers_.data(), v)) {
+                starts.push_back(static_cast<uint32_t>(v));
+            }
+        }
+        report_.winning_starts = !starts.empty();
+        if (starts.empty()) {
+            for (size_t v = 0; v < vertex_count_; ++v) {
+                starts.push_back(static_cast<uint32_t>(v));
+            }
+        }
+    }
+    report_.start_vertices = starts.size();
+    if (starts.empty() || options.plays == 0) {
+        return report_;
+    }
+
+    size_t batch_size = std::max<size_t>(1, options.batch_size);
+    // Not rounded up by adding batch_size - 1, which wraps for play counts near 2^64
+    uint64_t batches = options.plays / batch_size + (options.plays % batch_size != 0);
+    size_t worker_count = options.threads > 0 ? static_cast<size_t>(options.threads)
+                                              : std::max(1u, std::thread::hardware_concurrency());
+    worker_count = static_cast<size_t>(std::min<uint64_t>(worker_count, batches));
+    report_.batches = batches;
+    report_.threads = worker_count;
+
+    std::atomic<uint64_t> next_batch{0};
+    std::mutex totals_mutex;
+    std::exception_ptr failure;
+    auto work = [&](int worker) {
+        if (worker_count > 1 && trace::Tracer::instance().enabled()) {
+            trace::Tracer::instance().set_thread_name("simulation worker " + std::to_string(worker));
+        }
+        try {
+            Batch batch(batch_size, max_time_);
+            for (uint64_t b = next_batch++; b < batches; b = next_batch++) {
+                uint64_t first_play = b * batch_size;
+                size_t lanes = static_cast<size_t>(std::min<uint64_t>(batch_size, options.plays - first_play));
+                run_batch(batch, starts, first_play, lanes);
+            }
+            std::lock_guard<std::mutex> lock(totals_mutex);
+            report_.wins += batch.wins;
+            report_.stuck += batch.stuck;
+            for (size_t length = 0; length < batch.lengths.size(); ++length) {
+                report_.length_histogram[length] += batch.lengths[length];
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(totals_mutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            next_batch = batches;
+        }
+    };
+
+    auto play_start = std::chrono::steady_clock::now();
+    if (worker_count <= 1) {
+        work(0);
+    } else {
+        perf::ScopedWorkerPool running_pool;
+        std::vector<std::thread> workers;
+        for (size_t worker = 0; worker < worker_count; ++worker) {
+            workers.emplace_back(work, static_cast<int>(worker));
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+    report_.play_time = std::chrono::steady_clock::now() - play_start;
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    report_.plays = options.plays;
+    TEMPORIS_TRACE_ARG(trace_scope, "plays", report_.plays);
+    TEMPORIS_TRACE_ARG(trace_scope, "threads", worker_count);
+    return report_;
+}
+
+void PlaySimulator::write_report(std::ostream& out) const {
+    const auto& report = report_;
+    out << "\n=== Simulation ===\n";
+    out << "Plays: " << report.plays << " from " << report.start_vertices
+        << (report.options.start_vertex ? " queried" : report.winning_starts ? " winning-region" : "")
+        << " start vertices, Player 0: " << SimulationOptions::name(report.options.player0)
+        << ", Player 1: " << SimulationOptions::name(report.options.player1) << "\n";
+    out << std::fixed << std::setprecision(4);
+    out << "Wins: " << report.wins << " (" << 100.0 * report.win_rate() << "%), ended without a move: "
+        << report.stuck << "\n";
+    out << std::setprecision(2);
+    out << "Play length: min " << report.length_percentile(0.0) << ", p50 " << report.length_percentile(0.5)
+        << ", p90 " << report.length_percentile(0.9) << ", p99 " << report.length_percentile(0.99)
+        << ", max " << report.length_percentile(1.0) << ", mean " << report.mean_length() << "\n";
+
+    // At most ten equal-width buckets over 0 .. time bound
+    size_t lengths = report.length_histogram.size();
+    size_t width = std::max<size_t>(1, (lengths + 9) / 10);
+    out << "Length histogram:\n";
+    for (size_t first = 0; first < lengths; first += width) {
+        size_t last = std::min(lengths, first + width) - 1;
+        uint64_t count = 0;
+        for (size_t length = first; length <= last; ++length) {
+            count += report.length_histogram[length];
+        }
+        if (count == 0) {
+            continue;
+        }
+        out << "  " << std::setw(6) << first << " - " << std::setw(6) << last << "  " << std::setw(12) << count
+            << "  " << std::setw(6) << (report.plays > 0 ? 100.0 * static_cast<double>(count) /
+                                                           static_cast<double>(report.plays) : 0.0) << "%\n";
+    }
+    out << std::setprecision(6);
+    out << "Availability: " << report.availability_checks << " (edge, time) checks in "
+        << report.availability_time.count() << "s, layers: " << report.layers_time.count() << "s\n";
+    out << "Plays: " << report.play_time.count() << "s on " << report.threads << " threads in " << report.batches
+        << " batches of " << report.options.batch_size << ", " << std::setprecision(0)
+        << report.plays_per_second() << " plays/s\n";
+}
+
+} // namespace solvers
+} // namespace ggg
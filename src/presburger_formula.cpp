@@ -1,4 +1,5 @@
 #include "presburger_formula.hpp"
+#include "memory_usage.hpp"
 #include <iostream>
 
 namespace ggg {
@@ -7,6 +8,19 @@ namespace graphs {
 PresburgerFormula::PresburgerFormula(Type t, const PresburgerTerm& l, const PresburgerTerm& r) 
     : type_(t), left_(l), right_(r), modulus_(0), remainder_(0) {}
 
+PresburgerFormula::~PresburgerFormula() {
+    // Release subformulas from a worklist, so that destroying a deeply nested formula needs no deep recursion
+    std::vector<std::unique_ptr<PresburgerFormula>> pending = std::move(children_);
+    while (!pending.empty()) {
+        std::unique_ptr<PresburgerFormula> formula = std::move(pending.back());
+        pending.pop_back();
+        for (auto& child : formula->children_) {
+            pending.push_back(std::move(child));
+        }
+        formula->children_.clear();
+    }
+}
+
 std::unique_ptr<PresburgerFormula> PresburgerFormula::equal(const PresburgerTerm& left, const PresburgerTerm& right) {
     return std::make_unique<PresburgerFormula>(EQUAL, left, right);
 }
@@ -143,6 +157,15 @@ bool PresburgerFormula::evaluate(const std::map<std::string, int>& values) const
     }
 }
 
+size_t PresburgerFormula::memory_bytes() const {
+    size_t bytes = sizeof(*this) + left_.memory_bytes() + right_.memory_bytes() +
+                   memory::container_bytes(children_) + memory::string_heap_bytes(existential_var_);
+    for (const auto& child : children_) {
+        bytes += child->memory_bytes();
+    }
+    return bytes;
+}
+
 int PresburgerFormula::evaluate_term(const PresburgerTerm& term, const std::map<std::string, int>& values) const {
     int result = term.constant_;
     
@@ -1,4 +1,5 @@
 #include "presburger_term.hpp"
+#include "memory_usage.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -75,5 +76,13 @@ std::string PresburgerTerm::to_string() const {
     return result.empty() ? "0" : result;
 }
 
+size_t PresburgerTerm::memory_bytes() const {
+    size_t bytes = memory::container_bytes(coefficients_);
+    for (const auto& [var, coeff] : coefficients_) {
+        bytes += memory::string_heap_bytes(var);
+    }
+    return bytes;
+}
+
 } // namespace graphs
 } // namespace ggg
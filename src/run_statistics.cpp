@@ -0,0 +1,323 @@
+#include "run_statistics.hpp"
+#include "component_solver.hpp"
+#include "constraint_codegen.hpp"
+#include "ggg_temporal_graph.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "play_simulator.hpp"
+#include "sensitivity_analysis.hpp"
+#include "speculative_sweep.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+#include <unistd.h>
+
+// Build information is normally provided by CMake
+#ifndef TEMPORIS_VERSION
+#define TEMPORIS_VERSION "unknown"
+#endif
+#ifndef TEMPORIS_BUILD_TYPE
+#define TEMPORIS_BUILD_TYPE "unknown"
+#endif
+#ifndef TEMPORIS_CXX_FLAGS
+#define TEMPORIS_CXX_FLAGS ""
+#endif
+
+namespace ggg {
+namespace stats {
+
+namespace {
+
+std::string json_string(const std::string& value) {
+    std::string escaped = "\"";
+    for (char c : value) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped + "\"";
+}
+
+std::string compiler_version() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+template<typename Entries, typename Writer>
+void write_object(std::ostream& out, const char* name, const Entries& entries, Writer write_value) {
+    out << "  \"" << name << "\": {";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        out << (i > 0 ? ", " : "") << json_string(entries[i].first) << ": ";
+        write_value(entries[i].second);
+    }
+    out << "}";
+}
+
+} // namespace
+
+RunStatistics::RunStatistics(std::string tool)
+    : start_(std::chrono::steady_clock::now()), tool_(std::move(tool)) {
+}
+
+RunStatistics::~RunStatistics() = default;
+
+void RunStatistics::add_duration(Phases& phases, const std::string& name, Duration duration) {
+    for (auto& phase : phases) {
+        if (phase.first == name) {
+            phase.second += duration;
+            return;
+        }
+    }
+    phases.emplace_back(name, duration);
+}
+
+void RunStatistics::set_entry(Entries& entries, const std::string& name, uint64_t value) {
+    for (auto& entry : entries) {
+        if (entry.first == name) {
+            entry.second = value;
+            return;
+        }
+    }
+    entries.emplace_back(name, value);
+}
+
+void RunStatistics::add_phase(const std::string& name, Duration duration) {
+    add_duration(phases_, name, duration);
+}
+
+void RunStatistics::add_solve_phase(const std::string& name, Duration duration) {
+    add_duration(solve_phases_, name, duration);
+}
+
+void RunStatistics::set_size(const std::string& name, uint64_t value) {
+    set_entry(sizes_, name, value);
+}
+
+void RunStatistics::set_counter(const std::string& name, uint64_t value) {
+    set_entry(counters_, name, value);
+}
+
+void RunStatistics::add_load_statistics(const graphs::LoadStatistics& load) {
+    add_phase("parse", load.load_time - load.constraint_parse_time);
+    add_phase("constraint_compile", load.constraint_parse_time);
+    set_size("input_bytes", load.bytes_read);
+    set_size("input_lines", load.lines);
+    set_size("constraints", load.constraints_parsed + load.constraints_deferred);
+}
+
+void RunStatistics::add_lazy_constraint_statistics(const graphs::LazyConstraintStatistics& lazy) {
+    add_solve_phase("lazy_constraint_parse", lazy.parse_time);
+    set_size("constraint_arena_bytes", lazy.arena_bytes);
+    set_counter("constraints_materialized", lazy.materialized);
+    set_counter("constraints_never_materialized", lazy.never_materialized());
+}
+
+void RunStatistics::add_simulation_report(const solvers::SimulationReport& simulation) {
+    set_counter("simulate_plays", simulation.plays);
+    set_counter("simulate_wins", simulation.wins);
+    set_counter("simulate_stuck", simulation.stuck);
+    set_counter("simulate_plays_per_second", static_cast<uint64_t>(simulation.plays_per_second()));
+    set_counter("simulate_length_p50", static_cast<uint64_t>(simulation.length_percentile(0.5)));
+    set_counter("simulate_length_p99", static_cast<uint64_t>(simulation.length_percentile(0.99)));
+}
+
+void RunStatistics::add_sensitivity_statistics(const solvers::SensitivityStatistics& sensitivity,
+                                               size_t critical_edges) {
+    add_phase("sensitivity", sensitivity.backward_time + sensitivity.forward_time);
+    set_counter("sensitivity_critical_edges", critical_edges);
+    set_counter("sensitivity_critical_edge_times", sensitivity.critical_edge_times);
+    set_counter("sensitivity_pivotal_states", sensitivity.pivotal_states);
+    set_counter("sensitivity_constraint_checks", sensitivity.constraint_checks);
+}
+
+void RunStatistics::add_speculation_statistics(const solvers::SpeculationStatistics& speculation, int horizon) {
+    add_solve_phase("speculation_probe", speculation.probe_time);
+    add_solve_phase("speculation_speculate", speculation.speculate_time);
+    add_solve_phase("speculation_validate", speculation.validate_time);
+    set_counter("speculation_chunks", speculation.chunks);
+    set_counter("speculation_predictions", speculation.predictions);
+    set_counter("speculation_hits", speculation.hits);
+    set_counter("speculation_table_predictions", speculation.table_predictions);
+    set_counter("speculation_converged", speculation.converged);
+    set_counter("speculation_recomputed_layers", speculation.recomputed_layers);
+    set_counter("speculation_warmup_layers", speculation.warmup_layers);
+    set_counter("speculation_hit_rate_percent", static_cast<uint64_t>(speculation.hit_rate() * 100.0 + 0.5));
+    set_counter("speculation_estimated_speedup_percent",
+                static_cast<uint64_t>(speculation.estimated_speedup(horizon) * 100.0 + 0.5));
+}
+
+void RunStatistics::set_memory(const memory::MemoryReport& report) {
+    memory_.clear();
+    for (const auto& [name, bytes] : report.entries()) {
+        memory_.emplace_back(name, bytes);
+    }
+    memory_.emplace_back("total", report.total());
+    memory_.emplace_back("peak_rss", memory::peak_rss_bytes());
+}
+
+void RunStatistics::add_component_statistics(const solvers::ComponentStatistics& components) {
+    add_solve_phase("decomposition", components.decomposition_time);
+    add_solve_phase("component_solve", components.solve_time);
+    add_solve_phase("merge", components.merge_time);
+    set_counter("components", components.components);
+    set_counter("batched_components", components.batched_components);
+    set_counter("component_work_items", components.work_items.size());
+    solver_threads_ = static_cast<int>(components.threads);
+    components_ = components.work_items;
+}
+
+void RunStatistics::add_codegen_report(const codegen::CodegenReport& report, double evaluations) {
+    add_phase("codegen", report.total_time());
+    set_size("codegen_distinct_constraints", report.distinct_constraints);
+    set_size("codegen_source_bytes", report.source_bytes);
+    set_counter("codegen_compiled", report.compiled ? 1 : 0);
+    set_counter("codegen_cache_hit", report.cache_hit ? 1 : 0);
+    if (report.compiled) {
+        set_counter("codegen_interpreted_eval_ps", static_cast<uint64_t>(report.interpreted_ns * 1000));
+        set_counter("codegen_compiled_eval_ps", static_cast<uint64_t>(report.compiled_ns * 1000));
+        set_counter("codegen_estimated_evaluations", static_cast<uint64_t>(evaluations));
+        set_counter("codegen_saved_ns", static_cast<uint64_t>(std::max(0.0, report.saved_seconds(evaluations) * 1e9)));
+    }
+}
+
+void RunStatistics::write_json(std::ostream& out) const {
+    Phases phases = phases_;
+    phases.emplace_back("total", std::chrono::steady_clock::now() - start_);
+
+    auto write_seconds = [&](Duration duration) {
+        out << std::fixed << std::setprecision(9) << duration.count();
+    };
+    auto write_integer = [&](uint64_t value) { out << value; };
+
+    out << "{\n";
+    out << "  \"schema_version\": " << kSchemaVersion << ",\n";
+    out << "  \"tool\": " << json_string(tool_) << ",\n";
+    out << "  \"solver\": " << json_string(solver_) << ",\n";
+    out << "  \"input\": " << json_string(input_) << ",\n";
+    out << "  \"status\": " << json_string(status_) << ",\n";
+    write_object(out, "phases", phases, write_seconds);
+    out << ",\n";
+    write_object(out, "solve_phases", solve_phases_, write_seconds);
+    out << ",\n";
+    write_object(out, "sizes", sizes_, write_integer);
+    out << ",\n";
+    write_object(out, "counters", counters_, write_integer);
+    out << ",\n";
+    write_object(out, "memory_bytes", memory_, write_integer);
+    out << ",\n";
+
+    if (!components_.empty()) {
+        out << "  \"components\": [";
+        for (size_t i = 0; i < components_.size(); ++i) {
+            const auto& item = components_[i];
+            out << (i > 0 ? ",\n    " : "\n    ") << "{\"components\": " << item.components
+                << ", \"vertices\": " << item.vertices << ", \"edges\": " << item.edges
+                << ", \"engine\": " << json_string(item.engine) << ", \"worker\": " << item.worker
+                << ", \"solve_time\": ";
+            write_seconds(item.solve_time);
+            out << "}";
+        }
+        out << "\n  ],\n";
+    }
+
+    const auto& perf_counters = perf::PerfCounters::instance();
+    if (perf_counters.any_available()) {
+        out << "  \"hardware_counters\": {";
+        const auto& perf_phases = perf_counters.phases();
+        for (size_t p = 0; p < perf_phases.size(); ++p) {
+            out << (p > 0 ? ", " : "") << json_string(perf_phases[p].name) << ": {";
+            bool first = true;
+            for (int i = 0; i < perf::NUM_COUNTERS; ++i) {
+                if (!perf_phases[p].sample.available[i]) {
+                    continue;
+                }
+                out << (first ? "" : ", ") << "\""
+                    << perf::PerfCounters::counter_name(static_cast<perf::CounterId>(i))
+                    << "\": " << perf_phases[p].sample.values[i];
+                first = false;
+            }
+            if (perf_phases[p].partial) {
+                out << (first ? "" : ", ") << "\"partial\": true";
+            }
+            out << "}";
+        }
+        out << "},\n";
+    }
+
+#ifdef TEMPORIS_DISABLE_TRACING
+    const bool tracing = false;
+#else
+    const bool tracing = true;
+#endif
+#ifdef TEMPORIS_HAVE_USDT
+    const bool usdt_probes = true;
+#else
+    const bool usdt_probes = false;
+#endif
+#ifdef NDEBUG
+    const bool assertions = false;
+#else
+    const bool assertions = true;
+#endif
+    out << "  \"environment\": {"
+        << "\"version\": " << json_string(TEMPORIS_VERSION)
+        << ", \"hardware_threads\": " << std::thread::hardware_concurrency()
+        << ", \"solver_threads\": " << solver_threads_
+        << ", \"compiler\": " << json_string(compiler_version())
+        << ", \"build_type\": " << json_string(TEMPORIS_BUILD_TYPE)
+        << ", \"cxx_flags\": " << json_string(TEMPORIS_CXX_FLAGS)
+        << ", \"assertions\": " << (assertions ? "true" : "false")
+        << ", \"tracing\": " << (tracing ? "true" : "false")
+        << ", \"usdt_probes\": " << (usdt_probes ? "true" : "false")
+        << ", \"perf_counters\": " << (perf_counters.any_available() ? "true" : "false")
+        << "}\n";
+    out << "}\n";
+}
+
+bool RunStatistics::write_json(const std::string& file) const {
+    std::ofstream out(file);
+    if (!out.is_open()) {
+        return false;
+    }
+    write_json(out);
+    return static_cast<bool>(out);
+}
+
+std::string host_name() {
+    char buffer[256] = {};
+    if (gethostname(buffer, sizeof(buffer) - 1) != 0 || buffer[0] == '\0') {
+        return "localhost";
+    }
+    return buffer;
+}
+
+std::string utc_timestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return stamp;
+}
+
+} // namespace stats
+} // namespace ggg
@@ -0,0 +1,287 @@
+#include "sensitivity_analysis.hpp"
+#include "trace.hpp"
+#include <boost/graph/graph_traits.hpp>
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <numeric>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+inline bool test_bit(const SensitivityAnalysis::Bits& bits, size_t index) {
+    return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+inline void set_bit(SensitivityAnalysis::Bits& bits, size_t index) {
+    bits[index >> 6] |= uint64_t{1} << (index & 63);
+}
+
+inline size_t count_bits(const SensitivityAnalysis::Bits& bits) {
+    size_t count = 0;
+    for (uint64_t word : bits) {
+        count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+// Times arrive in increasing order, so a window either extends or a new one starts
+void add_time(std::vector<std::pair<int, int>>& windows, int time) {
+    if (!windows.empty() && windows.back().second == time - 1) {
+        windows.back().second = time;
+    } else {
+        windows.emplace_back(time, time);
+    }
+}
+
+} // namespace
+
+size_t CriticalEdge::times() const {
+    size_t total = 0;
+    for (const auto& [first, last] : windows) {
+        total += static_cast<size_t>(last - first + 1);
+    }
+    return total;
+}
+
+SensitivityAnalysis::SensitivityAnalysis(std::shared_ptr<graphs::GGGTemporalGameManager> manager,
+                                         std::shared_ptr<graphs::GGGReachabilityObjective> objective,
+                                         int max_time)
+    : manager_(manager), objective_(objective), max_time_(max_time) {
+}
+
+void SensitivityAnalysis::index_graph() {
+    const auto& graph = *manager_->graph();
+    auto index = boost::get(boost::vertex_index, graph);
+
+    vertex_count_ = boost::num_vertices(graph);
+    words_ = (vertex_count_ + 63) / 64;
+    players_.assign(vertex_count_, 0);
+    auto [vertex_begin, vertex_end] = boost::vertices(graph);
+    for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+        players_[index[*vertex_it]] = graph[*vertex_it].player;
+    }
+
+    edges_.clear();
+    std::vector<std::pair<size_t, OutEdge>> by_source;
+    auto [edge_begin, edge_end] = boost::edges(graph);
+    for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+        by_source.push_back({index[boost::source(*edge_it, graph)],
+                             OutEdge{index[boost::target(*edge_it, graph)], edges_.size()}});
+        edges_.push_back(*edge_it);
+    }
+    std::stable_sort(by_source.begin(), by_source.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : a.second.target < b.second.target;
+    });
+
+    offsets_.assign(vertex_count_ + 1, 0);
+    out_edges_.clear();
+    for (const auto& [source, out_edge] : by_source) {
+        offsets_[source + 1]++;
+        out_edges_.push_back(out_edge);
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+}
+
+void SensitivityAnalysis::enabled_out_edges(size_t vertex, int time, std::vector<OutEdge>& enabled) {
+    enabled.clear();
+    for (size_t i = offsets_[vertex]; i < offsets_[vertex + 1]; ++i) {
+        if (manager_->is_edge_constraint_satisfied(edges_[out_edges_[i].edge], time)) {
+            enabled.push_back(out_edges_[i]);
+        }
+    }
+    stats_.constraint_checks += offsets_[vertex + 1] - offsets_[vertex];
+}
+
+bool SensitivityAnalysis::in_layer(int time, size_t vertex) const {
+    return test_bit(layers_[static_cast<size_t>(time)], vertex);
+}
+
+std::vector<CriticalEdge> SensitivityAnalysis::analyze() {
+    TEMPORIS_TRACE_SCOPE("sensitivity_analysis");
+    stats_ = SensitivityStatistics{};
+    index_graph();
+    std::vector<CriticalEdge> critical;
+    if (max_time_ <= 0) {
+        return critical;
+    }
+
+    const auto& graph = *manager_->graph();
+    auto index = boost::get(boost::vertex_index, graph);
+    std::vector<OutEdge> enabled;
+
+    // Backward pass: the layers themselves
+    auto backward_start = std::chrono::steady_clock::now();
+    layers_.assign(static_cast<size_t>(max_time_) + 1, Bits(words_, 0));
+    for (auto target : manager_->targets_at(objective_->get_targets(), max_time_)) {
+        set_bit(layers_[static_cast<size_t>(max_time_)], index[target]);
+    }
+    for (int time = max_time_ - 1; time >= 0; --time) {
+        const Bits& next = layers_[static_cast<size_t>(time) + 1];
+        Bits& layer = layers_[static_cast<size_t>(time)];
+        for (size_t vertex = 0; vertex < vertex_count_; ++vertex) {
+            enabled_out_edges(vertex, time, enabled);
+            size_t winning = static_cast<size_t>(std::count_if(enabled.begin(), enabled.end(),
+                [&](const OutEdge& move) { return test_bit(next, move.target); }));
+            bool wins = players_[vertex] == 0 ? winning > 0 : !enabled.empty() && winning == enabled.size();
+            if (wins) {
+                set_bit(layer, vertex);
+            }
+        }
+        stats_.winning_states += count_bits(layer);
+    }
+    stats_.backward_time = std::chrono::steady_clock::now() - backward_start;
+
+    // Forward pass: pivotal states, split by the direction of the flip that matters
+    auto forward_start = std::chrono::steady_clock::now();
+    std::vector<std::vector<std::pair<int, int>>> loses(edges_.size());
+    std::vector<std::vector<std::pair<int, int>>> gains(edges_.size());
+    Bits drop = layers_[0];   // in W_t, and dropping it alone changes W_0
+    Bits gain(words_, 0);     // outside W_t, and adding it alone changes W_0
+    for (size_t vertex = 0; vertex < vertex_count_; ++vertex) {
+        if (!test_bit(drop, vertex)) {
+            set_bit(gain, vertex);
+        }
+    }
+
+    for (int time = 0; time < max_time_; ++time) {
+        const Bits& next = layers_[static_cast<size_t>(time) + 1];
+        // Targets at max_time are fixed, so pivotal states stop at the last layer
+        bool propagate = time + 1 < max_time_;
+        Bits next_drop(words_, 0);
+        Bits next_gain(words_, 0);
+        stats_.pivotal_states += count_bits(drop) + count_bits(gain);
+
+        for (size_t word = 0; word < words_; ++word) {
+            for (uint64_t bits = drop[word] | gain[word]; bits != 0; bits &= bits - 1) {
+                size_t vertex = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+                enabled_out_edges(vertex, time, enabled);
+
+                // Edge counts decide edge removal, distinct targets decide a successor's flip
+                size_t winning_edges = 0;
+                size_t winning_targets = 0;
+                size_t losing_targets = 0;
+                const OutEdge* winning_edge = nullptr;
+                const OutEdge* losing_edge = nullptr;
+                for (size_t i = 0; i < enabled.size(); ++i) {
+                    bool distinct = i == 0 || enabled[i].target != enabled[i - 1].target;
+                    if (test_bit(next, enabled[i].target)) {
+                        winning_edges++;
+                        winning_targets += distinct;
+                        winning_edge = &enabled[i];
+                    } else {
+                        losing_targets += distinct;
+                        losing_edge = &enabled[i];
+                    }
+                }
+                size_t losing_edges = enabled.size() - winning_edges;
+
+                if (test_bit(drop, vertex)) {
+                    if (players_[vertex] == 0) {
+                        if (winning_edges == 1) {
+                            add_time(loses[winning_edge->edge], time);
+                        }
+                        if (propagate && winning_targets == 1) {
+                            set_bit(next_drop, winning_edge->target);
+                        }
+                    } else {
+                        if (enabled.size() == 1) {
+                            add_time(loses[enabled[0].edge], time);
+                        }
+                        for (const auto& move : enabled) {
+                            if (propagate) set_bit(next_drop, move.target);
+                        }
+                    }
+                } else {
+                    if (players_[vertex] == 0) {
+                        for (const auto& move : enabled) {
+                            if (propagate) set_bit(next_gain, move.target);
+                        }
+                    } else if (losing_edges > 0) {
+                        if (losing_edges == 1 && enabled.size() >= 2) {
+                            add_time(gains[losing_edge->edge], time);
+                        }
+                        if (propagate && losing_targets == 1) {
+                            set_bit(next_gain, losing_edge->target);
+                        }
+                    }
+                }
+            }
+        }
+        drop = std::move(next_drop);
+        gain = std::move(next_gain);
+    }
+    stats_.forward_time = std::chrono::steady_clock::now() - forward_start;
+
+    for (size_t e = 0; e < edges_.size(); ++e) {
+        for (bool player0_loses : {true, false}) {
+            auto& windows = player0_loses ? loses[e] : gains[e];
+            if (!windows.empty()) {
+                critical.push_back({edges_[e], e, player0_loses, std::move(windows)});
+                stats_.critical_edge_times += critical.back().times();
+            }
+        }
+    }
+    return critical;
+}
+
+void SensitivityAnalysis::write_csv(std::ostream& out, const std::vector<CriticalEdge>& critical) const {
+    const auto& graph = *manager_->graph();
+    out << "source,target,constraint,impact,windows\n";
+    for (const auto& entry : critical) {
+        auto constraint = manager_->edge_constraint(entry.edge);
+        out << graph[boost::source(entry.edge, graph)].name << ","
+            << graph[boost::target(entry.edge, graph)].name << ",\""
+            << (constraint ? constraint->to_string() : "") << "\","
+            << (entry.player0_loses ? "player0_loses" : "player0_gains") << ",";
+        for (size_t i = 0; i < entry.windows.size(); ++i) {
+            out << (i > 0 ? ";" : "") << entry.windows[i].first << "-" << entry.windows[i].second;
+        }
+        out << "\n";
+    }
+}
+
+void SensitivityAnalysis::write_report(std::ostream& out, const std::vector<CriticalEdge>& critical,
+                                       size_t max_edges) const {
+    const auto& graph = *manager_->graph();
+    size_t loses = static_cast<size_t>(std::count_if(critical.begin(), critical.end(),
+                                                     [](const CriticalEdge& entry) { return entry.player0_loses; }));
+    out << "\n=== Sensitivity ===\n";
+    out << "Critical edges: " << critical.size() << " (" << loses << " shrink, " << critical.size() - loses
+        << " grow Player 0's time-0 region), " << stats_.critical_edge_times << " (edge, time) pairs\n";
+    out << "Pivotal states: " << stats_.pivotal_states << " of " << vertex_count_ * static_cast<size_t>(max_time_)
+        << ", winning states: " << stats_.winning_states << "\n";
+    out << std::fixed << std::setprecision(6);
+    out << "Backward pass: " << stats_.backward_time.count() << "s, forward pass: " << stats_.forward_time.count()
+        << "s, " << stats_.constraint_checks << " constraint checks\n";
+
+    std::vector<const CriticalEdge*> widest;
+    for (const auto& entry : critical) {
+        widest.push_back(&entry);
+    }
+    std::stable_sort(widest.begin(), widest.end(),
+                     [](const auto* a, const auto* b) { return a->times() > b->times(); });
+    if (widest.size() > max_edges) {
+        widest.resize(max_edges);
+    }
+    if (!widest.empty()) {
+        out << "Widest windows:\n";
+    }
+    for (const auto* entry : widest) {
+        out << "  " << graph[boost::source(entry->edge, graph)].name << " -> "
+            << graph[boost::target(entry->edge, graph)].name
+            << (entry->player0_loses ? "  Player 0 loses at " : "  Player 0 gains at ");
+        for (size_t i = 0; i < entry->windows.size(); ++i) {
+            out << (i > 0 ? ", " : "") << entry->windows[i].first;
+            if (entry->windows[i].second != entry->windows[i].first) {
+                out << "-" << entry->windows[i].second;
+            }
+        }
+        out << "\n";
+    }
+}
+
+} // namespace solvers
+} // namespace ggg
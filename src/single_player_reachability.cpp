@@ -0,0 +1,252 @@
+#include "single_player_reachability.hpp"
+#include "probes.hpp"
+#include <boost/graph/graph_traits.hpp>
+#include <algorithm>
+#include <bit>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+// Bit-matrices use vertex_count^2 bits; larger graphs always step
+constexpr size_t kMaxMatrixVertices = 8192;
+
+inline bool test_bit(const SinglePlayerReachability::Bits& bits, size_t index) {
+    return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+inline void set_bit(SinglePlayerReachability::Bits& bits, size_t index) {
+    bits[index >> 6] |= uint64_t{1} << (index & 63);
+}
+
+inline bool is_empty(const SinglePlayerReachability::Bits& bits) {
+    return std::all_of(bits.begin(), bits.end(), [](uint64_t word) { return word == 0; });
+}
+
+inline size_t ceil_log2(size_t value) {
+    return value <= 1 ? 0 : static_cast<size_t>(std::bit_width(value - 1));
+}
+
+} // namespace
+
+SinglePlayerReachability::SinglePlayerReachability(
+    std::shared_ptr<graphs::GGGTemporalGameManager> manager, int max_time)
+    : manager_(manager), max_time_(max_time) {
+}
+
+bool SinglePlayerReachability::applies(const GraphType& graph) {
+    auto [vertex_begin, vertex_end] = boost::vertices(graph);
+    for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+        if (graph[*vertex_it].player == 0) {
+            continue;
+        }
+        // Player 1 has a choice only between distinct successors
+        auto [edge_begin, edge_end] = boost::out_edges(*vertex_it, graph);
+        for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+            if (boost::target(*edge_it, graph) != boost::target(*edge_begin, graph)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void SinglePlayerReachability::index_graph() {
+    const auto& graph = *manager_->graph();
+    auto index = boost::get(boost::vertex_index, graph);
+
+    vertex_count_ = boost::num_vertices(graph);
+    words_ = (vertex_count_ + 63) / 64;
+    vertices_.assign(vertex_count_, Vertex{});
+    always_edges_.clear();
+    constrained_edges_.clear();
+
+    auto [vertex_begin, vertex_end] = boost::vertices(graph);
+    for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+        vertices_[index[*vertex_it]] = *vertex_it;
+    }
+    auto [edge_begin, edge_end] = boost::edges(graph);
+    for (auto edge_it = edge_begin; edge_it != edge_end; ++edge_it) {
+        IndexedEdge indexed{index[boost::source(*edge_it, graph)], index[boost::target(*edge_it, graph)], *edge_it};
+        if (manager_->has_edge_constraint(*edge_it)) {
+            constrained_edges_.push_back(indexed);
+        } else {
+            always_edges_.push_back(indexed);
+        }
+    }
+}
+
+void SinglePlayerReachability::evaluate_availability(int time, Bits& available) {
+    available.assign((constrained_edges_.size() + 63) / 64, 0);
+    for (size_t e = 0; e < constrained_edges_.size(); ++e) {
+        if (manager_->is_edge_constraint_satisfied(constrained_edges_[e].edge, time)) {
+            set_bit(available, e);
+        }
+    }
+}
+
+std::set<SinglePlayerReachability::Vertex> SinglePlayerReachability::solve(
+    const std::set<Vertex>& targets, size_t& constraint_checks) {
+    stats_ = SinglePlayerStatistics{};
+    index_graph();
+
+    std::set<Vertex> winning;
+    if (max_time_ <= 0) {
+        return winning;
+    }
+
+    const auto& graph = *manager_->graph();
+    auto index = boost::get(boost::vertex_index, graph);
+    Bits frontier(words_, 0);
+    for (auto target : targets) {
+        set_bit(frontier, index[target]);
+    }
+
+    // Sweep backwards, closing a window whenever edge availability changes
+    Bits window_available;
+    Bits available;
+    evaluate_availability(max_time_ - 1, window_available);
+    constraint_checks += constrained_edges_.size();
+    int window_end = max_time_ - 1;
+
+    for (int time = max_time_ - 2; time >= 0; --time) {
+        evaluate_availability(time, available);
+        constraint_checks += constrained_edges_.size();
+        if (available == window_available) {
+            continue;
+        }
+        [[maybe_unused]] size_t enabled = apply_window(window_available, window_end - time, frontier);
+        TEMPORIS_PROBE3(window__done, time + 1, window_end - time, enabled);
+        window_end = time;
+        std::swap(window_available, available);
+
+        // Nothing can move into an empty layer, so every earlier layer is empty too
+        if (is_empty(frontier)) {
+            stats_.skipped_layers += static_cast<size_t>(time + 1);
+            return winning;
+        }
+    }
+    [[maybe_unused]] size_t enabled = apply_window(window_available, window_end + 1, frontier);
+    TEMPORIS_PROBE3(window__done, 0, window_end + 1, enabled);
+
+    for (size_t v = 0; v < vertex_count_; ++v) {
+        if (test_bit(frontier, v)) {
+            winning.insert(vertices_[v]);
+        }
+    }
+    return winning;
+}
+
+size_t SinglePlayerReachability::apply_window(const Bits& available, int layers, Bits& frontier) {
+    stats_.constant_windows++;
+
+    std::vector<const IndexedEdge*> edges;
+    edges.reserve(always_edges_.size() + constrained_edges_.size());
+    for (const auto& edge : always_edges_) {
+        edges.push_back(&edge);
+    }
+    for (size_t e = 0; e < constrained_edges_.size(); ++e) {
+        if (test_bit(available, e)) {
+            edges.push_back(&constrained_edges_[e]);
+        }
+    }
+
+    // k sparse steps cost k * (m + n/64); squaring costs about 2 log k dense products
+    bool square = false;
+    size_t steps = static_cast<size_t>(layers);
+    if (vertex_count_ <= kMaxMatrixVertices && steps >= 2) {
+        if (mode_ == WindowMode::ALWAYS_SQUARE) {
+            square = true;
+        } else if (mode_ == WindowMode::COST_MODEL && steps >= 4) {
+            size_t step_cost = steps * (edges.size() + words_);
+            size_t square_cost = 2 * ceil_log2(steps) * vertex_count_ * vertex_count_ * words_;
+            square = square_cost < step_cost;
+        }
+    }
+
+    if (!square) {
+        Bits next(words_);
+        for (size_t i = 0; i < steps; ++i) {
+            step(edges, frontier, next);
+            stats_.frontier_steps++;
+            if (next == frontier) {
+                // Fixpoint: the remaining layers of the window are identical
+                stats_.skipped_layers += steps - i - 1;
+                break;
+            }
+            std::swap(frontier, next);
+            if (is_empty(frontier)) {
+                stats_.skipped_layers += steps - i - 1;
+                break;
+            }
+        }
+        return edges.size();
+    }
+
+    stats_.matrix_power_windows++;
+    stats_.skipped_layers += steps - 1;
+    std::vector<Bits> power(vertex_count_, Bits(words_, 0));
+    for (const auto* edge : edges) {
+        set_bit(power[edge->source], edge->target);
+    }
+
+    // Binary exponentiation applied to the frontier: powers of A commute
+    std::vector<Bits> squared(vertex_count_, Bits(words_, 0));
+    Bits next(words_);
+    for (size_t remaining = steps; remaining > 0; remaining >>= 1) {
+        if (remaining & 1) {
+            apply_matrix(power, frontier, next);
+            std::swap(frontier, next);
+        }
+        if (remaining > 1) {
+            multiply(power, power, squared);
+            std::swap(power, squared);
+            stats_.matrix_products++;
+        }
+    }
+    return edges.size();
+}
+
+void SinglePlayerReachability::step(const std::vector<const IndexedEdge*>& edges,
+                                    const Bits& frontier, Bits& result) const {
+    std::fill(result.begin(), result.end(), 0);
+    for (const auto* edge : edges) {
+        if (test_bit(frontier, edge->target)) {
+            set_bit(result, edge->source);
+        }
+    }
+}
+
+void SinglePlayerReachability::multiply(const std::vector<Bits>& left, const std::vector<Bits>& right,
+                                        std::vector<Bits>& result) const {
+    // Row i of the product is the union of the rows of right selected by row i of left
+    for (size_t row = 0; row < vertex_count_; ++row) {
+        Bits& out = result[row];
+        std::fill(out.begin(), out.end(), 0);
+        for (size_t word = 0; word < words_; ++word) {
+            for (uint64_t bits = left[row][word]; bits != 0; bits &= bits - 1) {
+                const Bits& selected = right[word * 64 + static_cast<size_t>(std::countr_zero(bits))];
+                for (size_t w = 0; w < words_; ++w) {
+                    out[w] |= selected[w];
+                }
+            }
+        }
+    }
+}
+
+void SinglePlayerReachability::apply_matrix(const std::vector<Bits>& matrix, const Bits& frontier,
+                                            Bits& result) const {
+    std::fill(result.begin(), result.end(), 0);
+    for (size_t row = 0; row < vertex_count_; ++row) {
+        for (size_t word = 0; word < words_; ++word) {
+            if (matrix[row][word] & frontier[word]) {
+                set_bit(result, row);
+                break;
+            }
+        }
+    }
+}
+
+} // namespace solvers
+} // namespace ggg
@@ -0,0 +1,313 @@
+#include "speculative_sweep.hpp"
+#include "perf_counters.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+/**
+ * @brief One chunk [first, last) of the horizon, computed from a predicted layer at time last
+ */
+struct Chunk {
+    int first = 0;
+    int last = 0;
+    LayerSet input;
+    bool warm_up = false;               // input still to be predicted by a warm-up window
+    std::vector<LayerSet> checkpoints;  // layer at first + i * stride; checkpoints[0] is the output
+};
+
+} // namespace
+
+double SpeculationStatistics::estimated_speedup(int horizon) const {
+    size_t layers = probe_layers + warmup_layers + speculative_layers + recomputed_layers;
+    double wall = (probe_time + speculate_time + validate_time).count();
+    if (layers == 0 || wall <= 0.0) {
+        return 1.0;
+    }
+    return layer_time.count() / static_cast<double>(layers) * horizon / wall;
+}
+
+SpeculativeSweep::SpeculativeSweep(int threads, int chunks, Predictor predictor)
+    : threads_(threads), chunks_(chunks), predictor_(predictor) {
+    if (threads_ <= 0) {
+        threads_ = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    if (chunks_ <= 0) {
+        chunks_ = 2 * threads_;
+    }
+}
+
+bool SpeculativeSweep::parse_predictor(const std::string& name, Predictor& out) {
+    if (name == "periodic") {
+        out = Predictor::PERIODIC;
+    } else if (name == "warmup") {
+        out = Predictor::WARMUP;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+LayerSet SpeculativeSweep::run(int horizon, const LayerSet& final_layer, const StepFactory& make_step) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "speculative_sweep");
+    stats_ = SpeculationStatistics{};
+    stats_.threads = static_cast<size_t>(threads_);
+    const size_t universe = final_layer.universe();
+    LayerStep step = make_step();
+    std::map<int, LayerSet> exact_boundaries;
+
+    // Exact layers at the top; they also give the period used for the predictions
+    auto probe_start = std::chrono::steady_clock::now();
+    std::vector<LayerSet> probe;   // probe[i] is the layer at horizon - 1 - i
+    LayerSet exact = final_layer;
+    int probe_length = predictor_ == Predictor::PERIODIC ? std::min(horizon, kProbeLayers) : 0;
+    for (int time = horizon - 1; time >= horizon - probe_length; --time) {
+        exact = step(time, exact);
+        probe.push_back(exact);
+    }
+    int top = horizon - probe_length;
+    int chunk_count = std::min(chunks_, top / kMinChunkLayers);
+    if (chunk_count <= 1) {
+        // Too short to split: finish sequentially
+        for (int time = top - 1; time >= 0; --time) {
+            exact = step(time, exact);
+        }
+        stats_.chunks = 1;
+        stats_.probe_layers = static_cast<size_t>(horizon);
+        stats_.probe_time = std::chrono::steady_clock::now() - probe_start;
+        stats_.layer_time = stats_.probe_time;
+        return horizon > 0 ? exact : LayerSet(universe, final_layer.dense_ratio());
+    }
+    int n = static_cast<int>(probe.size());
+    for (int period = 1; period <= n / 4 && stats_.period == 0; ++period) {
+        bool repeats = true;
+        for (int i = n / 2; i + period < n && repeats; ++i) {
+            repeats = probe[i] == probe[i + period];
+        }
+        if (repeats) {
+            stats_.period = period;
+        }
+    }
+    stats_.probe_layers = static_cast<size_t>(probe_length);
+    stats_.probe_time = std::chrono::steady_clock::now() - probe_start;
+    stats_.chunks = static_cast<size_t>(chunk_count);
+
+    // Speculative layers are kept at every stride-th time, within the memory budget
+    size_t layer_bytes = universe / 8 + sizeof(LayerSet);
+    size_t stride = std::max<size_t>(1, (static_cast<size_t>(top) * layer_bytes + kCheckpointBudgetBytes - 1) /
+                                           kCheckpointBudgetBytes);
+
+    std::vector<Chunk> chunks(static_cast<size_t>(chunk_count));
+    for (int k = 0; k < chunk_count; ++k) {
+        Chunk& chunk = chunks[k];
+        chunk.first = static_cast<int>(static_cast<int64_t>(top) * k / chunk_count);
+        chunk.last = static_cast<int>(static_cast<int64_t>(top) * (k + 1) / chunk_count);
+        if (k == chunk_count - 1) {
+            chunk.input = exact;
+        } else if (auto it = table_.find(chunk.last); it != table_.end() && table_universe_ == universe) {
+            chunk.input = it->second;
+            stats_.table_predictions++;
+        } else if (predictor_ == Predictor::PERIODIC) {
+            int lowest = top;
+            int period = stats_.period > 0 ? stats_.period : 1;
+            int time = stats_.period > 0 ? lowest + ((chunk.last - lowest) % period + period) % period : lowest;
+            chunk.input = probe[static_cast<size_t>(horizon - 1 - time)];
+        } else {
+            chunk.warm_up = true;
+        }
+    }
+
+    // Chunks run concurrently, each from its own input
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<size_t> warmup_layers{0};
+    std::mutex time_mutex;
+    std::exception_ptr failure;
+    auto work = [&](int worker) {
+        if (threads_ > 1 && trace::Tracer::instance().enabled()) {
+            trace::Tracer::instance().set_thread_name("speculation worker " + std::to_string(worker));
+        }
+        LayerStep worker_step = make_step();
+        auto worker_start = std::chrono::steady_clock::now();
+        for (size_t k = next_chunk++; k < chunks.size(); k = next_chunk++) {
+            try {
+                TEMPORIS_TRACE_SCOPE("speculative_chunk");
+                Chunk& chunk = chunks[k];
+                if (chunk.warm_up) {
+                    // Warm-up window above the input, started from the final layer
+                    int start = std::min(horizon, chunk.last + warmup_layers_);
+                    LayerSet layer = final_layer;
+                    for (int time = start - 1; time >= chunk.last; --time) {
+                        layer = worker_step(time, layer);
+                    }
+                    warmup_layers += static_cast<size_t>(start - chunk.last);
+                    chunk.input = std::move(layer);
+                }
+                chunk.checkpoints.resize((static_cast<size_t>(chunk.last - chunk.first) + stride - 1) / stride);
+                LayerSet layer = chunk.input;
+                for (int time = chunk.last - 1; time >= chunk.first; --time) {
+                    layer = worker_step(time, layer);
+                    if (static_cast<size_t>(time - chunk.first) % stride == 0) {
+                        chunk.checkpoints[static_cast<size_t>(time - chunk.first) / stride] = layer;
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(time_mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                next_chunk = chunks.size();
+            }
+        }
+        std::lock_guard<std::mutex> lock(time_mutex);
+        stats_.layer_time += std::chrono::steady_clock::now() - worker_start;
+    };
+
+    auto speculate_start = std::chrono::steady_clock::now();
+    size_t worker_count = std::min(static_cast<size_t>(threads_), chunks.size());
+    if (worker_count <= 1) {
+        work(0);
+    } else {
+        perf::ScopedWorkerPool running_pool;
+        std::vector<std::thread> workers;
+        for (size_t worker = 0; worker < worker_count; ++worker) {
+            workers.emplace_back(work, static_cast<int>(worker));
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+    stats_.speculate_time = std::chrono::steady_clock::now() - speculate_start;
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    stats_.warmup_layers = warmup_layers;
+    stats_.speculative_layers = static_cast<size_t>(top);
+
+    // Validate from the top: a wrong input is recomputed until it meets the speculative layers
+    auto validate_start = std::chrono::steady_clock::now();
+    exact = chunks.back().checkpoints.front();
+    exact_boundaries.emplace(chunks.back().last, chunks.back().input);
+    for (size_t k = chunks.size() - 1; k-- > 0;) {
+        Chunk& chunk = chunks[k];
+        exact_boundaries.emplace(chunk.last, exact);
+        stats_.predictions++;
+        if (chunk.input == exact) {
+            stats_.hits++;
+            exact = chunk.checkpoints.front();
+            continue;
+        }
+        for (int time = chunk.last - 1; time >= chunk.first; --time) {
+            exact = step(time, exact);
+            stats_.recomputed_layers++;
+            size_t offset = static_cast<size_t>(time - chunk.first);
+            if (offset % stride == 0 && exact == chunk.checkpoints[offset / stride]) {
+                if (time > chunk.first) {
+                    stats_.converged++;
+                }
+                exact = chunk.checkpoints.front();
+                break;
+            }
+        }
+    }
+    stats_.validate_time = std::chrono::steady_clock::now() - validate_start;
+    stats_.layer_time += stats_.probe_time + stats_.validate_time;
+    TEMPORIS_TRACE_ARG(trace_scope, "chunks", stats_.chunks);
+    TEMPORIS_TRACE_ARG(trace_scope, "hits", stats_.hits);
+
+    table_ = std::move(exact_boundaries);
+    table_universe_ = universe;
+    return exact;
+}
+
+bool SpeculativeSweep::load_table(const std::string& path, size_t universe, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::map<int, LayerSet> table;
+    size_t table_universe = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "universe") {
+            fields >> table_universe;
+        } else if (key == "layer") {
+            int time = 0;
+            size_t count = 0;
+            fields >> time >> count;
+            std::vector<uint32_t> vertices(count);
+            for (auto& vertex : vertices) {
+                fields >> vertex;
+            }
+            if (!fields || !std::is_sorted(vertices.begin(), vertices.end()) ||
+                (!vertices.empty() && vertices.back() >= table_universe)) {
+                error = path + ": invalid layer at time " + std::to_string(time);
+                return false;
+            }
+            table[time] = LayerSet::from_sorted(table_universe, vertices.begin(), vertices.end());
+        }
+    }
+    if (table_universe != universe) {
+        error = path + ": table is for " + std::to_string(table_universe) + " vertices, the game has " +
+                std::to_string(universe);
+        return false;
+    }
+    table_ = std::move(table);
+    table_universe_ = universe;
+    return true;
+}
+
+bool SpeculativeSweep::save_table(const std::string& path) const {
+    std::ofstream out(path);
+    out << "# temporis speculation table: exact layers at chunk boundaries\n";
+    out << "universe " << table_universe_ << "\n";
+    for (const auto& [time, layer] : table_) {
+        out << "layer " << time << " " << layer.size();
+        layer.for_each([&](uint32_t vertex) { out << " " << vertex; });
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+void SpeculativeSweep::write_report(std::ostream& out, int horizon) const {
+    out << "\n=== Speculative Sweep ===\n";
+    out << "Chunks: " << stats_.chunks << " on " << stats_.threads << " threads, predictor "
+        << (predictor_ == Predictor::PERIODIC ? "periodic" : "warmup");
+    if (predictor_ == Predictor::PERIODIC) {
+        out << " (" << (stats_.period == 0 ? "no period, last probe layer" : "period " + std::to_string(stats_.period))
+            << ")";
+    }
+    out << "\n";
+    out << std::fixed << std::setprecision(1);
+    out << "Predictions: " << stats_.predictions << ", hits: " << stats_.hits << " ("
+        << stats_.hit_rate() * 100.0 << "%), from table: " << stats_.table_predictions
+        << ", misses converged early: " << stats_.converged << "\n";
+    out << "Layers: " << stats_.probe_layers << " probe, " << stats_.warmup_layers << " warm-up, "
+        << stats_.speculative_layers << " speculative, " << stats_.recomputed_layers << " recomputed (horizon "
+        << horizon << ")\n";
+    out << std::setprecision(6);
+    out << "Probe: " << stats_.probe_time.count() << "s, speculate: " << stats_.speculate_time.count()
+        << "s, validate: " << stats_.validate_time.count() << "s\n";
+    out << std::setprecision(2);
+    out << "Estimated speedup over the sequential sweep: " << stats_.estimated_speedup(horizon) << "x\n";
+}
+
+} // namespace solvers
+} // namespace ggg
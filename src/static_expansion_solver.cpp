@@ -1,4 +1,8 @@
 #include "static_expansion_solver.hpp"
+#include "memory_usage.hpp"
+#include "perf_counters.hpp"
+#include "probes.hpp"
+#include "trace.hpp"
 #include "libggg/parity/graph.hpp"
 #include <boost/graph/graph_traits.hpp>
 #include <iostream>
@@ -19,6 +23,9 @@ std::string StaticExpansionSolver::get_name() const {
 }
 
 StaticExpansionSolver::SolutionType StaticExpansionSolver::solve(const GraphType& graph) {
+    TEMPORIS_TRACE_SCOPE("static_expansion_solve");
+    perf::ScopedPerfPhase perf_phase("solve");
+    
     // Reset statistics for this solve
     stats_.reset();
     auto solve_start = std::chrono::high_resolution_clock::now();
@@ -37,12 +44,20 @@ StaticExpansionSolver::SolutionType StaticExpansionSolver::solve(const GraphType
     
     // Step 1: Create expanded graph with static expansion
     auto expansion_start = std::chrono::high_resolution_clock::now();
+    TEMPORIS_PROBE3(expansion__start, stats_.original_vertices, stats_.original_edges, stats_.time_layers);
     ExpandedGraph expanded_graph = create_expanded_graph(graph);
     auto expansion_end = std::chrono::high_resolution_clock::now();
     stats_.expansion_time = expansion_end - expansion_start;
     
     stats_.expanded_vertices = boost::num_vertices(expanded_graph);
     stats_.expanded_edges = boost::num_edges(expanded_graph);
+    TEMPORIS_PROBE3(expansion__done, stats_.expanded_vertices, stats_.expanded_edges,
+                    stats_.constraint_evaluations);
+    stats_.expanded_graph_bytes = memory::estimate_graph_bytes(expanded_graph,
+        [](const auto& vertex) { return memory::string_heap_bytes(vertex.name); },
+        [](const auto& edge) { return memory::string_heap_bytes(edge.label); });
+    stats_.expansion_map_bytes = memory::container_bytes(temporal_to_expanded_) +
+                                 memory::container_bytes(expanded_to_temporal_);
     
     if (verbose_) {
         std::cout << "Expanded graph: " << stats_.expanded_vertices << " vertices, " 
@@ -51,7 +66,9 @@ StaticExpansionSolver::SolutionType StaticExpansionSolver::solve(const GraphType
     }
     
     // Step 2: Create target set (target vertices at max_time)
+    auto target_set_start = std::chrono::high_resolution_clock::now();
     std::set<ExpandedVertex> target_set = create_target_set(expanded_graph);
+    stats_.target_set_time = std::chrono::high_resolution_clock::now() - target_set_start;
     stats_.target_vertices_at_max_time = target_set.size();
     
     if (verbose_) {
@@ -60,19 +77,40 @@ StaticExpansionSolver::SolutionType StaticExpansionSolver::solve(const GraphType
     
     // Step 3: Compute attractor for Player 0 on expanded graph
     auto attractor_start = std::chrono::high_resolution_clock::now();
-    auto [attractor, strategy] = ggg::graphs::player_utilities::compute_attractor(expanded_graph, target_set, 0);
+    TEMPORIS_PROBE2(attractor__start, stats_.expanded_vertices, target_set.size());
+    auto [attractor, strategy] = [&]() {
+        TEMPORIS_TRACE_SCOPE("attractor");
+        perf::ScopedPerfPhase attractor_phase("attractor");
+        if (attractor_threads_ == 1) {
+            return ggg::graphs::player_utilities::compute_attractor(expanded_graph, target_set, 0);
+        }
+        ParallelAttractor parallel(attractor_threads_);
+        auto result = parallel.compute(expanded_graph, target_set, 0);
+        stats_.attractor_threads = parallel.get_statistics().threads;
+        stats_.attractor_levels = parallel.get_statistics().levels;
+        return result;
+    }();
     auto attractor_end = std::chrono::high_resolution_clock::now();
     stats_.attractor_time = attractor_end - attractor_start;
     
     stats_.attractor_vertices = attractor.size();
+    TEMPORIS_PROBE1(attractor__done, stats_.attractor_vertices);
+    stats_.attractor_bytes = memory::container_bytes(target_set) + memory::container_bytes(attractor) +
+                             memory::container_bytes(strategy);
     
     if (verbose_) {
-        std::cout << "Attractor computation time: " << stats_.attractor_time.count() << "s" << std::endl;
+        std::cout << "Attractor computation time: " << stats_.attractor_time.count() << "s";
+        if (stats_.attractor_threads > 0) {
+            std::cout << " (" << stats_.attractor_threads << " threads, " << stats_.attractor_levels << " frontiers)";
+        }
+        std::cout << std::endl;
         std::cout << "Attractor size: " << stats_.attractor_vertices << " vertices" << std::endl;
     }
     
     // Step 4: Convert result back to temporal solution
+    auto solution_start = std::chrono::high_resolution_clock::now();
     SolutionType solution = convert_attractor_to_solution(graph, attractor, strategy);
+    stats_.solution_time = std::chrono::high_resolution_clock::now() - solution_start;
     
     // Record total solve time
     auto solve_end = std::chrono::high_resolution_clock::now();
@@ -90,6 +128,8 @@ StaticExpansionSolver::SolutionType StaticExpansionSolver::solve(const GraphType
 }
 
 StaticExpansionSolver::ExpandedGraph StaticExpansionSolver::create_expanded_graph(const GraphType& temporal_graph) {
+    TEMPORIS_TRACE_SCOPE("expansion");
+    perf::ScopedPerfPhase perf_phase("expansion");
     ExpandedGraph expanded_graph;
     
     // Clear mappings
@@ -106,6 +146,8 @@ StaticExpansionSolver::ExpandedGraph StaticExpansionSolver::create_expanded_grap
 }
 
 void StaticExpansionSolver::create_time_layers(const GraphType& temporal_graph, ExpandedGraph& expanded_graph) {
+    TEMPORIS_TRACE_SCOPE("create_time_layers");
+    
     if (verbose_) {
         std::cout << "Creating time layers..." << std::endl;
     }
@@ -140,6 +182,8 @@ void StaticExpansionSolver::create_time_layers(const GraphType& temporal_graph,
 }
 
 void StaticExpansionSolver::add_temporal_edges(const GraphType& temporal_graph, ExpandedGraph& expanded_graph) {
+    TEMPORIS_TRACE_SCOPE_VAR(trace_scope, "add_temporal_edges");
+    
     if (verbose_) {
         std::cout << "Adding temporal edges..." << std::endl;
     }
@@ -174,6 +218,9 @@ void StaticExpansionSolver::add_temporal_edges(const GraphType& temporal_graph,
         }
     }
     
+    TEMPORIS_TRACE_ARG(trace_scope, "constraint_evaluations", stats_.constraint_evaluations);
+    TEMPORIS_TRACE_ARG(trace_scope, "expanded_edges", boost::num_edges(expanded_graph));
+    
     if (verbose_) {
         std::cout << "Added " << boost::num_edges(expanded_graph) << " temporal edges" << std::endl;
         std::cout << "Constraint evaluations: " << stats_.constraint_evaluations 
@@ -183,10 +230,11 @@ void StaticExpansionSolver::add_temporal_edges(const GraphType& temporal_graph,
 }
 
 std::set<StaticExpansionSolver::ExpandedVertex> StaticExpansionSolver::create_target_set(const ExpandedGraph& expanded_graph) {
+    TEMPORIS_TRACE_SCOPE("create_target_set");
     std::set<ExpandedVertex> target_set;
     
-    // Target vertices are the temporal target vertices at max_time
-    auto temporal_targets = objective_->get_targets();
+    // Target vertices are the temporal target vertices at max_time whose target constraint holds then
+    auto temporal_targets = manager_->targets_at(objective_->get_targets(), max_time_);
     
     for (TemporalVertex temporal_target : temporal_targets) {
         auto key = std::make_pair(temporal_target, max_time_);
@@ -214,8 +262,11 @@ StaticExpansionSolver::SolutionType StaticExpansionSolver::convert_attractor_to_
     const GraphType& temporal_graph,
     const std::set<ExpandedVertex>& attractor,
     const std::map<ExpandedVertex, ExpandedVertex>& strategy) {
+    TEMPORIS_TRACE_SCOPE("build_solution");
+    perf::ScopedPerfPhase perf_phase("build_solution");
     
     SolutionType solution;
+    size_t strategies = 0;
     
     // For each vertex in the original temporal graph
     auto [vertex_begin, vertex_end] = boost::vertices(temporal_graph);
@@ -244,6 +295,7 @@ StaticExpansionSolver::SolutionType StaticExpansionSolver::convert_attractor_to_
                     if (target_it != expanded_to_temporal_.end()) {
                         TemporalVertex temporal_strategy_target = target_it->second.first;
                         solution.set_strategy(temporal_vertex, temporal_strategy_target);
+                        ++strategies;
                     }
                 }
             } else {
@@ -256,6 +308,8 @@ StaticExpansionSolver::SolutionType StaticExpansionSolver::convert_attractor_to_
         }
     }
     
+    stats_.solution_bytes = memory::solution_bytes<TemporalVertex>(boost::num_vertices(temporal_graph), strategies);
+    
     if (verbose_) {
         std::cout << "Solution extracted: " << stats_.vertices_winning_at_time_0 
                   << " vertices winning for Player 0 at time 0" << std::endl;
@@ -0,0 +1,99 @@
+#include "trace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace ggg {
+namespace trace {
+
+Tracer::ThreadBuffer& Tracer::thread_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->thread_id = static_cast<int>(buffers_.size()) + 1;
+        buffer->thread_name = buffer->thread_id == 1 ? "main" : "worker-" + std::to_string(buffer->thread_id - 1);
+        buffers_.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Tracer::start(const std::string& output_file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    output_file_ = output_file;
+    origin_ = std::chrono::steady_clock::now();
+    for (auto& buffer : buffers_) {
+        buffer->events.clear();
+    }
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+int64_t Tracer::now_ns() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin_).count();
+}
+
+void Tracer::set_thread_name(const std::string& name) {
+    if (!enabled()) {
+        return;
+    }
+    thread_buffer().thread_name = name;
+}
+
+void Tracer::record(TraceEvent event) {
+    if (!enabled()) {
+        return;
+    }
+    thread_buffer().events.push_back(std::move(event));
+}
+
+bool Tracer::write() {
+    if (!enabled()) {
+        return true;
+    }
+    enabled_.store(false, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ofstream out(output_file_);
+    if (!out.is_open()) {
+        std::cerr << "[ERROR] Cannot open trace file " << output_file_ << std::endl;
+        return false;
+    }
+
+    // Timestamps are microseconds as required by the Chrome trace format
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        if (!first) out << ",\n";
+        first = false;
+        return out;
+    };
+
+    out << std::fixed << std::setprecision(3);
+    for (const auto& buffer : buffers_) {
+        separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->thread_id
+                    << ", \"args\": {\"name\": \"" << buffer->thread_name << "\"}}";
+        for (const auto& event : buffer->events) {
+            separator() << "{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category
+                        << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->thread_id
+                        << ", \"ts\": " << event.start_ns / 1000.0
+                        << ", \"dur\": " << event.duration_ns / 1000.0;
+            if (!event.args.empty()) {
+                out << ", \"args\": {";
+                for (size_t i = 0; i < event.args.size(); ++i) {
+                    if (i > 0) out << ", ";
+                    out << "\"" << event.args[i].first << "\": " << event.args[i].second;
+                }
+                out << "}";
+            }
+            out << "}";
+        }
+        buffer->events.clear();
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace trace
+} // namespace ggg
@@ -0,0 +1,398 @@
+#include "vertex_activity.hpp"
+#include <algorithm>
+#include <boost/graph/graph_traits.hpp>
+#include <climits>
+#include <cstdlib>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace ggg {
+namespace solvers {
+
+namespace {
+
+using Windows = std::vector<TimeWindow>;
+using graphs::PresburgerFormula;
+
+// Values tried for an existential variable, as in PresburgerFormula::evaluate
+constexpr int kExistsMin = -10;
+constexpr int kExistsMax = 10;
+
+// Nested quantifiers multiply the enumeration; deeper ones are over-approximated
+constexpr int kMaxExistsDepth = 3;
+
+int64_t floor_div(int64_t a, int64_t b) {
+    int64_t quotient = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? quotient - 1 : quotient;
+}
+
+int64_t ceil_div(int64_t a, int64_t b) {
+    return -floor_div(-a, b);
+}
+
+Windows whole(int horizon) {
+    return horizon > 0 ? Windows{{0, horizon}} : Windows{};
+}
+
+// Times first..last (inclusive) that lie in [0, horizon)
+Windows clip(int64_t first, int64_t last, int horizon) {
+    first = std::max<int64_t>(first, 0);
+    last = std::min<int64_t>(last, int64_t{horizon} - 1);
+    return first <= last ? Windows{{static_cast<int>(first), static_cast<int>(last + 1)}} : Windows{};
+}
+
+// Sort by start and merge overlapping or adjacent windows
+void normalize(Windows& windows) {
+    std::sort(windows.begin(), windows.end(),
+              [](const TimeWindow& a, const TimeWindow& b) { return a.begin < b.begin; });
+    size_t kept = 0;
+    for (const auto& window : windows) {
+        if (kept > 0 && window.begin <= windows[kept - 1].end) {
+            windows[kept - 1].end = std::max(windows[kept - 1].end, window.end);
+        } else {
+            windows[kept++] = window;
+        }
+    }
+    windows.resize(kept);
+}
+
+Windows unite(Windows a, const Windows& b) {
+    a.insert(a.end(), b.begin(), b.end());
+    normalize(a);
+    return a;
+}
+
+Windows intersect(const Windows& a, const Windows& b) {
+    Windows result;
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        int begin = std::max(a[i].begin, b[j].begin);
+        int end = std::min(a[i].end, b[j].end);
+        if (begin < end) {
+            result.push_back({begin, end});
+        }
+        (a[i].end < b[j].end ? i : j)++;
+    }
+    return result;
+}
+
+Windows complement(const Windows& windows, int horizon) {
+    Windows result;
+    int start = 0;
+    for (const auto& window : windows) {
+        if (start < window.begin) {
+            result.push_back({start, window.begin});
+        }
+        start = window.end;
+    }
+    if (start < horizon) {
+        result.push_back({start, horizon});
+    }
+    return result;
+}
+
+/**
+ * @brief Satisfying times of a formula over [0, horizon), following PresburgerFormula::evaluate
+ */
+class WindowAnalysis {
+private:
+    int horizon_;
+    bool exact_ = true;
+    int exists_depth_ = 0;
+    // Existential variables and their current value; they shadow time like in evaluate()
+    std::map<std::string, int> bound_;
+
+    /**
+     * @brief Term as a * time + c; false if evaluating it could overflow an int
+     */
+    bool linear(const graphs::PresburgerTerm& term, int64_t& a, int64_t& c) const {
+        a = 0;
+        c = term.constant_;
+        for (const auto& [var, coefficient] : term.coefficients_) {
+            auto it = bound_.find(var);
+            if (it != bound_.end()) {
+                c += int64_t{coefficient} * it->second;
+            } else if (var == "time") {
+                a += coefficient;
+            }
+            // Other variables are unknown to the evaluator and contribute 0
+        }
+        int64_t magnitude = std::abs(c) + std::abs(a) * std::max(horizon_, 1);
+        return magnitude <= INT_MAX;
+    }
+
+    // Times with a * time >= k
+    Windows at_least(int64_t a, int64_t k) const {
+        if (a == 0) {
+            return 0 >= k ? whole(horizon_) : Windows{};
+        }
+        return a > 0 ? clip(ceil_div(k, a), INT64_MAX, horizon_) : clip(INT64_MIN, floor_div(k, a), horizon_);
+    }
+
+    Windows over_approximate() {
+        exact_ = false;
+        return whole(horizon_);
+    }
+
+    Windows comparison(const PresburgerFormula& formula) {
+        int64_t left_a, left_c, right_a, right_c;
+        if (!linear(formula.left(), left_a, left_c) || !linear(formula.right(), right_a, right_c)) {
+            return over_approximate();
+        }
+        // left OP right  <=>  a * time + c OP 0
+        int64_t a = left_a - right_a;
+        int64_t c = left_c - right_c;
+        switch (formula.type()) {
+            case PresburgerFormula::EQUAL:
+                if (a == 0) {
+                    return c == 0 ? whole(horizon_) : Windows{};
+                }
+                return c % a == 0 ? clip(-c / a, -c / a, horizon_) : Windows{};
+            case PresburgerFormula::GREATEREQUAL: return at_least(a, -c);
+            case PresburgerFormula::GREATER: return at_least(a, -c + 1);
+            case PresburgerFormula::LESSEQUAL: return at_least(-a, c);
+            case PresburgerFormula::LESS: return at_least(-a, c + 1);
+            default: return over_approximate();
+        }
+    }
+
+    Windows modulus(const PresburgerFormula& formula) {
+        int64_t a, c;
+        if (!linear(formula.left(), a, c) || formula.modulus_value() == 0) {
+            return over_approximate();
+        }
+        if (a == 0) {
+            return static_cast<int>(c) % formula.modulus_value() == formula.remainder_value() ? whole(horizon_)
+                                                                                                : Windows{};
+        }
+        // Periodic in time: a window per period would grow the index with the horizon
+        return over_approximate();
+    }
+
+public:
+    explicit WindowAnalysis(int horizon) : horizon_(std::max(0, horizon)) {}
+
+    bool exact() const { return exact_; }
+
+    Windows analyze(const PresburgerFormula& formula) {
+        switch (formula.type()) {
+            case PresburgerFormula::EQUAL:
+            case PresburgerFormula::GREATEREQUAL:
+            case PresburgerFormula::LESSEQUAL:
+            case PresburgerFormula::GREATER:
+            case PresburgerFormula::LESS:
+                return comparison(formula);
+            case PresburgerFormula::MODULUS:
+                return modulus(formula);
+            case PresburgerFormula::AND: {
+                Windows result = whole(horizon_);
+                for (const auto& child : formula.children()) {
+                    result = intersect(result, analyze(*child));
+                }
+                return result;
+            }
+            case PresburgerFormula::OR: {
+                Windows result;
+                for (const auto& child : formula.children()) {
+                    result = unite(std::move(result), analyze(*child));
+                }
+                return result;
+            }
+            case PresburgerFormula::NOT: {
+                if (formula.children().empty()) {
+                    return {};
+                }
+                // Only the complement of an exact set is a superset of the negation
+                bool outer_exact = exact_;
+                exact_ = true;
+                Windows inner = analyze(*formula.children()[0]);
+                bool inner_exact = exact_;
+                exact_ = outer_exact;
+                return inner_exact ? complement(inner, horizon_) : over_approximate();
+            }
+            case PresburgerFormula::EXISTS: {
+                if (formula.children().empty() || exists_depth_ >= kMaxExistsDepth) {
+                    return over_approximate();
+                }
+                const std::string& var = formula.existential_var();
+                auto previous = bound_.find(var);
+                std::optional<int> shadowed;
+                if (previous != bound_.end()) {
+                    shadowed = previous->second;
+                }
+                ++exists_depth_;
+                Windows result;
+                for (int value = kExistsMin; value <= kExistsMax; ++value) {
+                    bound_[var] = value;
+                    result = unite(std::move(result), analyze(*formula.children()[0]));
+                }
+                --exists_depth_;
+                if (shadowed) {
+                    bound_[var] = *shadowed;
+                } else {
+                    bound_.erase(var);
+                }
+                return result;
+            }
+            default:
+                return whole(horizon_);
+        }
+    }
+};
+
+} // namespace
+
+std::vector<TimeWindow> formula_time_windows(const graphs::PresburgerFormula& formula, int horizon, bool* exact) {
+    WindowAnalysis analysis(horizon);
+    Windows windows = analysis.analyze(formula);
+    if (exact) {
+        *exact = analysis.exact();
+    }
+    return windows;
+}
+
+std::shared_ptr<const VertexActivityIndex> VertexActivityIndex::build(const graphs::GGGTemporalGameManager& manager,
+                                                                      int horizon) {
+    auto build_start = std::chrono::steady_clock::now();
+    auto index = std::make_shared<VertexActivityIndex>();
+    index->horizon_ = std::max(0, horizon);
+    const auto& graph = *manager.graph();
+    const size_t vertex_count = boost::num_vertices(graph);
+
+    // Edges often share one constraint object, so each is analysed once
+    std::unordered_map<const PresburgerFormula*, Windows> analyzed;
+    Windows vertex_windows;
+    index->window_offsets_.reserve(vertex_count + 1);
+
+    auto [vertex_begin, vertex_end] = boost::vertices(graph);
+    for (auto vertex_it = vertex_begin; vertex_it != vertex_end; ++vertex_it) {
+        index->window_offsets_.push_back(index->windows_.size());
+        vertex_windows.clear();
+        bool always = false;
+        auto [edge_begin, edge_end] = boost::out_edges(*vertex_it, graph);
+        for (auto edge_it = edge_begin; edge_it != edge_end && !always; ++edge_it) {
+            std::shared_ptr<const PresburgerFormula> formula;
+            try {
+                formula = manager.edge_constraint(*edge_it);
+            } catch (const std::exception&) {
+                // Unparsable deferred constraint: keep the vertex, the kernel reports the error
+                always = true;
+                break;
+            }
+            if (!formula) {
+                always = true;
+                break;
+            }
+            auto it = analyzed.find(formula.get());
+            if (it == analyzed.end()) {
+                bool exact = true;
+                it = analyzed.emplace(formula.get(), formula_time_windows(*formula, index->horizon_, &exact)).first;
+                if (!exact) {
+                    index->stats_.inexact_constraints++;
+                }
+            }
+            vertex_windows.insert(vertex_windows.end(), it->second.begin(), it->second.end());
+        }
+        if (always) {
+            vertex_windows = whole(index->horizon_);
+        } else {
+            normalize(vertex_windows);
+        }
+
+        auto vertex = static_cast<uint32_t>(*vertex_it);
+        for (const auto& window : vertex_windows) {
+            index->windows_.push_back(window);
+            index->stats_.active_vertex_layers += static_cast<uint64_t>(window.end - window.begin);
+            // Going down, the vertex becomes active at end - 1 and idle again at begin - 1
+            index->events_.push_back({window.end - 1, true, vertex});
+            if (window.begin > 0) {
+                index->events_.push_back({window.begin - 1, false, vertex});
+            }
+        }
+    }
+    index->window_offsets_.push_back(index->windows_.size());
+
+    std::sort(index->events_.begin(), index->events_.end(), [](const Event& a, const Event& b) {
+        if (a.time != b.time) return a.time > b.time;
+        if (a.enter != b.enter) return !a.enter;
+        return a.vertex < b.vertex;
+    });
+
+    index->stats_.windows = index->windows_.size();
+    index->stats_.vertex_layers = static_cast<uint64_t>(vertex_count) * static_cast<uint64_t>(index->horizon_);
+    index->stats_.build_time = std::chrono::steady_clock::now() - build_start;
+    return index;
+}
+
+bool VertexActivityIndex::is_active(uint32_t vertex, int time) const {
+    auto begin = windows_.begin() + static_cast<std::ptrdiff_t>(window_offsets_[vertex]);
+    auto end = windows_.begin() + static_cast<std::ptrdiff_t>(window_offsets_[vertex + 1]);
+    // First window ending after time
+    auto it = std::partition_point(begin, end, [time](const TimeWindow& window) { return window.end <= time; });
+    return it != end && it->begin <= time;
+}
+
+void VertexActivityIndex::Cursor::rebuild(int time) {
+    active_.clear();
+    const size_t vertex_count = index_->window_offsets_.size() - 1;
+    for (size_t vertex = 0; vertex < vertex_count; ++vertex) {
+        if (index_->is_active(static_cast<uint32_t>(vertex), time)) {
+            active_.push_back(static_cast<uint32_t>(vertex));
+        }
+    }
+    const auto& events = index_->events_;
+    next_event_ = static_cast<size_t>(std::partition_point(events.begin(), events.end(),
+                                                           [time](const Event& event) { return event.time >= time; }) -
+                                      events.begin());
+    time_ = time;
+}
+
+const std::vector<uint32_t>& VertexActivityIndex::Cursor::at(int time) {
+    if (time == time_) {
+        return active_;
+    }
+    if (time_ < 0 || time != time_ - 1) {
+        // First layer or a jump (speculative chunks): start from the windows
+        rebuild(time);
+        return active_;
+    }
+
+    const auto& events = index_->events_;
+    size_t leaves_end = next_event_;
+    while (leaves_end < events.size() && events[leaves_end].time == time && !events[leaves_end].enter) {
+        ++leaves_end;
+    }
+    size_t enters_end = leaves_end;
+    while (enters_end < events.size() && events[enters_end].time == time) {
+        ++enters_end;
+    }
+
+    if (enters_end != next_event_) {
+        // Drop the leaving vertices (all currently active) and merge in the entering ones, both by vertex
+        scratch_.clear();
+        size_t leave = next_event_;
+        size_t enter = leaves_end;
+        for (uint32_t vertex : active_) {
+            while (enter < enters_end && events[enter].vertex < vertex) {
+                scratch_.push_back(events[enter++].vertex);
+            }
+            if (leave < leaves_end && events[leave].vertex == vertex) {
+                ++leave;
+                continue;
+            }
+            scratch_.push_back(vertex);
+        }
+        while (enter < enters_end) {
+            scratch_.push_back(events[enter++].vertex);
+        }
+        active_.swap(scratch_);
+    }
+    next_event_ = enters_end;
+    time_ = time;
+    return active_;
+}
+
+} // namespace solvers
+} // namespace ggg
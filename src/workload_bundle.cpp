@@ -0,0 +1,264 @@
+#include "workload_bundle.hpp"
+#include "run_statistics.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace ggg {
+namespace stats {
+
+namespace {
+
+void write_section(std::ostream& out, const char* key, const std::string& bytes) {
+    out << key << " " << bytes.size() << "\n";
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    out << "\n";
+}
+
+/**
+ * @brief Recursive-descent walk of a JSON value, recording the numbers it contains
+ */
+class JsonNumbers {
+private:
+    const std::string& text_;
+    size_t pos_ = 0;
+    std::map<std::string, double>& values_;
+
+    [[noreturn]] void fail(const char* expected) const {
+        throw std::runtime_error(std::string("expected ") + expected + " at offset " + std::to_string(pos_));
+    }
+
+    void skip_whitespace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool consume(char expected) {
+        skip_whitespace();
+        if (pos_ < text_.size() && text_[pos_] == expected) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    std::string parse_string() {
+        if (!consume('"')) {
+            fail("string");
+        }
+        std::string value;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) {
+                ++pos_;
+            }
+            value += text_[pos_++];
+        }
+        if (pos_ >= text_.size()) {
+            fail("'\"'");
+        }
+        ++pos_;
+        return value;
+    }
+
+    static std::string join(const std::string& path, const std::string& key) {
+        return path.empty() ? key : path + "/" + key;
+    }
+
+public:
+    JsonNumbers(const std::string& text, std::map<std::string, double>& values) : text_(text), values_(values) {}
+
+    void parse_value(const std::string& path) {
+        skip_whitespace();
+        if (pos_ >= text_.size()) {
+            fail("value");
+        }
+        char c = text_[pos_];
+        if (c == '{') {
+            ++pos_;
+            if (consume('}')) return;
+            do {
+                std::string key = parse_string();
+                if (!consume(':')) {
+                    fail("':'");
+                }
+                parse_value(join(path, key));
+            } while (consume(','));
+            if (!consume('}')) {
+                fail("'}'");
+            }
+        } else if (c == '[') {
+            ++pos_;
+            if (consume(']')) return;
+            size_t index = 0;
+            do {
+                parse_value(join(path, std::to_string(index++)));
+            } while (consume(','));
+            if (!consume(']')) {
+                fail("']'");
+            }
+        } else if (c == '"') {
+            parse_string();
+        } else {
+            size_t end = pos_;
+            while (end < text_.size() && (std::isalnum(static_cast<unsigned char>(text_[end])) ||
+                                          text_[end] == '-' || text_[end] == '+' || text_[end] == '.')) {
+                ++end;
+            }
+            std::string token = text_.substr(pos_, end - pos_);
+            if (token.empty()) {
+                fail("value");
+            }
+            if (token != "true" && token != "false" && token != "null") {
+                values_[path] = std::stod(token);
+            }
+            pos_ = end;
+        }
+    }
+
+    void parse_document() {
+        parse_value("");
+        skip_whitespace();
+        if (pos_ != text_.size()) {
+            fail("end of document");
+        }
+    }
+};
+
+} // namespace
+
+WorkloadBundle WorkloadBundle::capture(const std::string& path) {
+    WorkloadBundle bundle;
+    bundle.name = std::filesystem::path(path).stem().string();
+    bundle.host = host_name();
+    bundle.captured_at = utc_timestamp();
+    return bundle;
+}
+
+bool WorkloadBundle::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    out << "# temporis workload bundle, replay with temporis_replay\n";
+    out << "version " << kVersion << "\n";
+    out << "name " << name << "\n";
+    out << "source " << source << "\n";
+    out << "host " << host << "\n";
+    out << "captured_at " << captured_at << "\n";
+    out << "time_bound " << time_bound << "\n";
+    for (const auto& argument : arguments) {
+        write_section(out, "argument", argument);
+    }
+    write_section(out, "statistics", statistics);
+    write_section(out, "input", input);
+    return static_cast<bool>(out);
+}
+
+std::optional<WorkloadBundle> WorkloadBundle::load(const std::string& path, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        error = "cannot open " + path;
+        return std::nullopt;
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    WorkloadBundle bundle;
+    int version = 0;
+    bool has_input = false;
+    size_t pos = 0;
+    try {
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == std::string::npos) {
+                end = text.size();
+            }
+            std::string line = text.substr(pos, end - pos);
+            pos = std::min(end + 1, text.size());
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            size_t space = line.find(' ');
+            std::string key = line.substr(0, space);
+            std::string value = space == std::string::npos ? "" : line.substr(space + 1);
+
+            if (key == "argument" || key == "statistics" || key == "input") {
+                size_t length = std::stoul(value);
+                if (length > text.size() - pos || (pos + length < text.size() && text[pos + length] != '\n')) {
+                    error = path + ": truncated " + key + " section";
+                    return std::nullopt;
+                }
+                std::string bytes = text.substr(pos, length);
+                pos = std::min(pos + length + 1, text.size());
+                if (key == "argument") {
+                    bundle.arguments.push_back(std::move(bytes));
+                } else if (key == "statistics") {
+                    bundle.statistics = std::move(bytes);
+                } else {
+                    bundle.input = std::move(bytes);
+                    has_input = true;
+                }
+            } else if (key == "version") {
+                version = std::stoi(value);
+            } else if (key == "name") {
+                bundle.name = value;
+            } else if (key == "source") {
+                bundle.source = value;
+            } else if (key == "host") {
+                bundle.host = value;
+            } else if (key == "captured_at") {
+                bundle.captured_at = value;
+            } else if (key == "time_bound") {
+                bundle.time_bound = std::stoi(value);
+            }
+            // Keys of newer versions are ignored
+        }
+    } catch (const std::exception&) {
+        error = path + ": invalid value";
+        return std::nullopt;
+    }
+    if (version != kVersion) {
+        error = path + ": unsupported bundle version " + std::to_string(version);
+        return std::nullopt;
+    }
+    if (!has_input) {
+        error = path + ": no input section";
+        return std::nullopt;
+    }
+    if (bundle.name.empty()) {
+        bundle.name = std::filesystem::path(path).stem().string();
+    }
+    return bundle;
+}
+
+std::vector<std::string> WorkloadBundle::collect(const std::vector<std::string>& paths) {
+    std::vector<std::string> files;
+    for (const auto& path : paths) {
+        std::error_code error;
+        if (!std::filesystem::is_directory(path, error)) {
+            files.push_back(path);
+            continue;
+        }
+        std::vector<std::string> found;
+        for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == kExtension) {
+                found.push_back(entry.path().string());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+    }
+    return files;
+}
+
+std::map<std::string, double> flatten_json_numbers(const std::string& json) {
+    std::map<std::string, double> values;
+    JsonNumbers(json, values).parse_document();
+    return values;
+}
+
+} // namespace stats
+} // namespace ggg